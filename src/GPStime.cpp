@@ -6,12 +6,17 @@
 
 // [femtotime headers]
 #include "femtotime/GPStime.hpp"
+#include "femtotime/calendar.hpp"
+#include "femtotime/time_format.hpp"
+#include "femtotime/time_parse.hpp"
+#include "femtotime/time_split.hpp"
 
 // [C++ headers]
 #include <algorithm>
 #include <array>
 #include <iostream>
 #include <cassert>
+#include <tuple>
 
 // [fmt]
 #include <fmt/printf.h>
@@ -21,276 +26,47 @@ using namespace std;
 
 namespace femtotime {
 
-/**
- * @brief The times (in GPS) that a leap second was added to UTC time.
- *
- * This keeps the time in GPS, not UTC. This means that the leap second times
- * are slowly drifting out of sync with the expected UTC times. If you need
- * UTC times, use `utc_time_t::leap_seconds` instead.
- *
- * NOTE FOR FUTURE MAINTAINERS: This and `utc_time_t::leap_seconds` need to be
- * kept in sync. This vector contains the leap second times as their GPS
- * equivalents, which means that a proper conversion is necessary. In
- * particular, none of the times in this column should have a 60 in the seconds
- * column. Additionally, the conversion code in this file assumes that the list
- * is sorted (it uses `std::upper_bound`), so any new leap seconds should be
- * added to the bottom of both vectors.
- */
-std::vector<gps_time_t> gps_time_t::leap_seconds = {
-  gps_time_t(1972, 6, 30,  23, 59, 51),
-  gps_time_t(1972, 12, 31, 23, 59, 52),
-  gps_time_t(1973, 12, 31, 23, 59, 53),
-  gps_time_t(1974, 12, 31, 23, 59, 54),
-  gps_time_t(1975, 12, 31, 23, 59, 55),
-  gps_time_t(1976, 12, 31, 23, 59, 56),
-  gps_time_t(1977, 12, 31, 23, 59, 57),
-  gps_time_t(1978, 12, 31, 23, 59, 58),
-  gps_time_t(1979, 12, 31, 23, 59, 59),
-  gps_time_t(1981, 7, 1, 0, 0, 0),
-  gps_time_t(1982, 7, 1, 0, 0, 1),
-  gps_time_t(1983, 7, 1, 0, 0, 2),
-  gps_time_t(1985, 7, 1, 0, 0, 3),
-  gps_time_t(1988, 1, 1, 0, 0, 4),
-  gps_time_t(1990, 1, 1, 0, 0, 5),
-  gps_time_t(1991, 1, 1, 0, 0, 6),
-  gps_time_t(1992, 7, 1, 0, 0, 7),
-  gps_time_t(1993, 7, 1, 0, 0, 8),
-  gps_time_t(1994, 7, 1, 0, 0, 9),
-  gps_time_t(1996, 1, 1, 0, 0, 10),
-  gps_time_t(1997, 7, 1, 0, 0, 11),
-  gps_time_t(1999, 1, 1, 0, 0, 12),
-  gps_time_t(2006, 1, 1, 0, 0, 13),
-  gps_time_t(2009, 1, 1, 0, 0, 14),
-  gps_time_t(2012, 7, 1, 0, 0, 15),
-  gps_time_t(2015, 7, 1, 0, 0, 16),
-  gps_time_t(2017, 1, 1, 0, 0, 17),
-};
 #warning "We need to apply a doubt formalism to the leap seconds, or an"
 #warning " assertion mechanism to make sure we are not past their validity."
 
 /**
- * @brief The UTC times of every leap second.
- *
- * If the GPS-time equivalents of these are needed, use
- * `gps_time_t::leap_seconds`.
+ * @struct split_days_t
  *
- * NOTE FOR FUTURE MAINTAINERS: See `gps_time_t::leap_seconds`.
+ * A femtosecond count split into whole days, seconds of the day and
+ * femtoseconds of the second, all rounded towards negative infinity.
  */
-std::vector<utc_time_t> utc_time_t::leap_seconds = {
-  utc_time_t(1972, 6, 30,  23, 59, 60),
-  utc_time_t(1972, 12, 31, 23, 59, 60),
-  utc_time_t(1973, 12, 31, 23, 59, 60),
-  utc_time_t(1974, 12, 31, 23, 59, 60),
-  utc_time_t(1975, 12, 31, 23, 59, 60),
-  utc_time_t(1976, 12, 31, 23, 59, 60),
-  utc_time_t(1977, 12, 31, 23, 59, 60),
-  utc_time_t(1978, 12, 31, 23, 59, 60),
-  utc_time_t(1979, 12, 31, 23, 59, 60),
-  utc_time_t(1981, 6, 30,  23, 59, 60),
-  utc_time_t(1982, 6, 30,  23, 59, 60),
-  utc_time_t(1983, 6, 30,  23, 59, 60),
-  utc_time_t(1985, 6, 30,  23, 59, 60),
-  utc_time_t(1987, 12, 31, 23, 59, 60),
-  utc_time_t(1989, 12, 31, 23, 59, 60),
-  utc_time_t(1990, 12, 31, 23, 59, 60),
-  utc_time_t(1992, 6, 30,  23, 59, 60),
-  utc_time_t(1993, 6, 30,  23, 59, 60),
-  utc_time_t(1994, 6, 30,  23, 59, 60),
-  utc_time_t(1995, 12, 31, 23, 59, 60),
-  utc_time_t(1997, 6, 30,  23, 59, 60),
-  utc_time_t(1998, 12, 31, 23, 59, 60),
-  utc_time_t(2005, 12, 31, 23, 59, 60),
-  utc_time_t(2008, 12, 31, 23, 59, 60),
-  utc_time_t(2012, 6, 30,  23, 59, 60),
-  utc_time_t(2015, 6, 30,  23, 59, 60),
-  utc_time_t(2016, 12, 31, 23, 59, 60)
-};
-
-static constexpr array<int, 12> _basic_month_durations = {
-  31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
-};
-
-static constexpr array<int, 12> _leap_month_durations = {
-  31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
-};
-
-static constexpr std::pair<int64_t, int64_t>
-euclidean_div(int64_t x, int64_t y)
-{
-  auto quot = x / y;
-  auto rem = x % y;
-  if (rem >= 0) {
-    return std::pair(quot, rem);
-  } else {
-    return std::pair(quot - 1, rem + y);
-  }
-}
-
-static constexpr std::pair<int128_t, int128_t>
-euclidean_div(int128_t x, int128_t y)
+struct split_days_t
 {
-  auto quot = x / y;
-  auto rem = x % y;
-  if (rem >= 0) {
-    return std::pair(quot, rem);
-  } else {
-    return std::pair(quot - 1, rem + y);
-  }
-}
-
-static constexpr int64_t days_per_400_years = 146097;
-static constexpr int64_t days_per_100_years = 36524;
-static constexpr int64_t days_per_4_years = 1461;
-
-// Our days_of_month vector is rotated here so Febuary is last--this means we
-// don't have to deal with leap years specially because Feb. 29 is represented
-// as day 366, making it the last day in our list.
-static constexpr array<int, 12> rotated_month_days = {
-  31, 30, 31, 30, 31, 31, 30, 31, 30, 31, 31, 29
+  int64_t days;
+  int64_t sec_of_day;
+  int64_t subsec;
 };
 
-/**
- * @brief Converts a day count to a year-month-day triple.
- *
- * The second parameter, `y2000_epoch`, is the number of days between the
- * desired epoch and Mar. 1, 2000, for reasons explained within the function
- * body. Additionally, the returned triple is in proleptic Gregorian format;
- * there is no support for conversion to Julian dates for dates before 1752.
- */
-static std::tuple<int, int, int>
-dayToDate(int64_t total_days, int64_t y2000_epoch)
-{
-  // High-level overview of this function:
-  //
-  // The general way this function works is by dividing the total number of days
-  // elapsed into "cycles": periods each the length of one of the leap year
-  // rules (400 years, 100 years, 4 years, and 1 year). This function works by
-  // dividing down each cycle and getting the remaining days: for example, every
-  // 400 years, exactly 146,097 days pass, so the date (day and month) of any
-  // day count `x` is exactly the same as the date for day `x % 146097`. We
-  // repeat this for each of the cycles, slowly shrinking down until we get to a
-  // cycle of 1 year, at which point we can determine the day and month.
-  //
-  // One of the least intuitive parts of this function is how it deals with leap
-  // days. The first thing it does is that it modifies the day count to be
-  // relative to March 1, 2000 instead of the GPS epoch (January 6, 1980). This
-  // is because that day is immediately after a leap day and at the beginning of
-  // a 400-year cycle. This means that the "special" leap days (e.g. the missing
-  // leap day every 100 years, or the no-longer-missing one every 400) are
-  // always the very last day in their respective cycles. This makes them much
-  // easier to deal with--as an example, the math is identical for dealing with
-  // 100-year cycles whether or not the last leap day is missing (as it is 3 out
-  // of 4 times), because all other days come before it, so the number of days
-  // elapsed from the beginning of the cycle is the same for all of them.
-
-  // Adjusts the date to be relative to Mar. 1, 2000
-  // This date was chosen because it is the day after a leap day, on a year
-  // divisible by 400--this makes doing math much easier
-  auto adjusted_days = total_days - y2000_epoch;
-
-  // Euclidean division here to account for days before the year-2000 epoch
-  auto [y400_cycles, y400_rem] =
-    euclidean_div(adjusted_days, days_per_400_years);
-
-  auto [y100_cycles, y100_rem] = euclidean_div(y400_rem, days_per_100_years);
-  if (y100_cycles == 4) {
-    // This is the case if and only if the date is the Feb. 29, 2000 (or off by
-    // 400 years). If that's the case, we need to adjust our times appropriately
-    y100_cycles = 3;
-    y100_rem += days_per_100_years;
-  }
-
-  auto [y4_cycles, y4_rem] = euclidean_div(y100_rem, days_per_4_years);
-  // The max y100_rem can be is 36524, which is less than 25*1461 (= 26525).
-  assert(y4_cycles < 25);
-
-  auto [years, days] = euclidean_div(y4_rem, 365);
-  if (years == 4) {
-    // If years == 4, we have a leap day--celebrate (or don't)
-    years = 3;
-    days += 365;
-  }
-
-  // Now that we have our day relative to March 2000, we need to actually
-  // convert that to standard year-month-day format
-
-  // Then, use the day of the year to calculate the day of the month
-  // Our days_of_month vector is rotated here so Febuary is last--this means we
-  // don't have to deal with leap years specially because Feb. 29 is represented
-  // as day 366, making it the last day in our list.
-  int day_of_month = days;
-  int month = 0;
-  for (; day_of_month >= rotated_month_days[month]; month++) {
-    day_of_month -= rotated_month_days[month];
-  }
-  // Adjust for the fact that our month vector is off by 2
-  month = (month + 2) % 12;
-  // Because our months are off by 2, we need to adjust the year for dates in
-  // January and Feburary
-  bool adjust_year = month < 2;
-  auto year = years + 4*y4_cycles + 100*y100_cycles + 400*y400_cycles;
-  // Adjust our year from being relative to Mar. 2000 to standard Gregorian
-  year += 2000 + adjust_year;
-  // We need to adjust our month and day to 1-indexed because that's what people
-  // expect when dealing with dates
-  return {year, month + 1, day_of_month + 1};
-}
-
-static std::tuple<int, int, int> gpsDayToDate(int64_t total_days)
+static constexpr split_days_t split_days(femtosecs_t fs)
 {
-  // The GPS epoch is 7360 days before Mar. 1, 2000
-  return dayToDate(total_days, 7360);
+  auto [secs, subsec] = split_secs(fs);
+  auto [days, sec_of_day] = euclidean_div(secs, secs_per_day_64);
+  return {days, sec_of_day, subsec};
 }
 
-static std::tuple<int, int, int> utcDayToDate(int64_t total_days)
+static constexpr std::tuple<int, int, int> gpsDayToDate(int64_t total_days)
 {
-  // The GPS epoch is 11017 days before Mar. 1, 2000
-  return dayToDate(total_days, 11017);
+  return civil_from_days(total_days, gps_y2000_epoch);
 }
 
-/**
- * @brief Converts a year-month-day triple to a date
- *
- * The fourth parameter, `y2000_epoch`, refers to the number of days between the
- * desired epoch and Mar. 1, 2000. The reasoning for this is explained in the
- * method body. Additionally, the year-month-day triple is in proleptic
- * Gregorian format; there is no support for conversion to the Julian calendar
- * for dates before 1752.
- */
-static int64_t dateToDays(int64_t year, int month, int day, int64_t y2000_epoch)
-{
-  // Like daysToDate, this converts first to days relative to Mar. 1, 2000
-  // This puts us immediately after a leap day, so leap day is now the last
-  // day of the year, making conversion easier
-  year -= (month <= 2); // Early days are part of the previous "year"
-  month = (month + 9) % 12; // Convert months so March is 0
-  year -= 2000; // Convert year so it's relative to 2000
-  auto day_of_year = day - 1;
-  for (int i = 0; i < month; i++) {
-    day_of_year += rotated_month_days[i];
-  }
-  auto [y400_cycles, y400_rem] = euclidean_div(year, 400);
-  // Convert the remaining years to the day within the 400-year cycle
-  // Every 4 years, there is an extra leap day, and then every 100, there is one
-  // day fewer (missing leap day).
-  auto day_of_cycle =
-    365 * y400_rem + y400_rem / 4 - y400_rem / 100 + day_of_year;
-  // Get the number of days elapsed since Mar. 1, 2000
-  // This just adds on the elapsed 400-year cycles
-  auto relative_day = y400_cycles * days_per_400_years + day_of_cycle;
-  // Converts the relative day back to being relative to the GPS epoch, then
-  // returns
-  return relative_day + y2000_epoch;
+static constexpr std::tuple<int, int, int> utcDayToDate(int64_t total_days)
+{
+  return civil_from_days(total_days, utc_y2000_epoch);
 }
 
-static int64_t dateToGPSDays(int64_t year, int month, int day)
+static constexpr int64_t dateToGPSDays(int64_t year, int month, int day)
 {
-  return dateToDays(year, month, day, 7360);
+  return days_from_civil(year, month, day, gps_y2000_epoch);
 }
 
-static int64_t dateToUTCDays(int64_t year, int month, int day)
+static constexpr int64_t dateToUTCDays(int64_t year, int month, int day)
 {
-  return dateToDays(year, month, day, 11017);
+  return days_from_civil(year, month, day, utc_y2000_epoch);
 }
 
 static femtosecs_t DateTime2femtosecs(int year, int month, int day,
@@ -317,33 +93,41 @@ static femtosecs_t DateTime2UTC(int year, int month, int day,
   return fs;
 }
 
-static constexpr bool is_leap_year(int year)
-{
-  return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
-}
-
-static constexpr const array<int, 12> &year2month_durations(int year)
-{
-  if (is_leap_year(year)) {
-    return _leap_month_durations;
-  } else {
-    return _basic_month_durations;
-  }
+/**
+ * @brief Break a femtosecond count down into calendar and clock fields.
+ *
+ * The second parameter is the number of days between the epoch of `fs` and
+ * Mar. 1, 2000 (see `civil_from_days`). Only one split is done, into whole
+ * seconds and the femtoseconds of the second; everything after that is 64-bit
+ * arithmetic.
+ */
+static civil_fields_t fs2fields(femtosecs_t fs, int64_t y2000_epoch)
+{
+  auto [days, sec_of_day, subsec_fs] = split_days(fs);
+  auto [year, month, day] = civil_from_days(days, y2000_epoch);
+  civil_fields_t fields;
+  fields.year = year;
+  fields.month = month;
+  fields.day = day;
+  fields.hour = sec_of_day / secs_per_hour_64;
+  fields.minute = sec_of_day / sec_per_min_64 % 60;
+  fields.second = sec_of_day % sec_per_min_64;
+  fields.nanosecond = subsec_fs / fs_per_ns_64;
+  fields.femtosecond = subsec_fs % fs_per_ns_64;
+  fields.day_of_year = civil_day_of_year(year, month, day) + 1;
+  return fields;
 }
 
 /**
- * @brief Convert a day/month/year in Gregorian format to the number of days
- * since the start of the given year.
+ * @brief The inverse of `fs2fields`; `day_of_year` is ignored.
  */
-static int date2doy(int year, int month, int day)
+static femtosecs_t fields2fs(const civil_fields_t &fields, int64_t y2000_epoch)
 {
-  int day_of_year = 0;
-  const auto &month_durations = year2month_durations(year);
-  for (int mo = 0; mo < (month - 1); ++mo) {
-    day_of_year += month_durations[mo];
-  }
-  day_of_year += (day - 1);
-  return day_of_year;
+  auto days = days_from_civil(fields.year, fields.month, fields.day,
+                              y2000_epoch);
+  int64_t secs = days * secs_per_day_64 + fields.hour * secs_per_hour_64
+    + fields.minute * sec_per_min_64 + fields.second;
+  return secs * fs_per_sec + fields.nanosecond * fs_per_ns + fields.femtosecond;
 }
 
 /**
@@ -354,52 +138,7 @@ static int date2doy(int year, int month, int day)
  * leap seconds internally).
  */
 static constexpr femtosecs_t epoch_adjust = 315'964'800 * fs_per_sec;
-
-/**
- * @brief This is the GPS epoch on Jan. 6, 1980 at midnight
-*/
-gps_time_t gps_time_t::gps_epoch = gps_time_t(0);
-
-/**
- * @brief The GPS epoch at Jan. 6, 1980 at midnight.
- */
-utc_time_t utc_time_t::gps_epoch = utc_time_t(1980, 1, 6, 0, 0, 0, 0);
-
-/**
- * @brief The UTC epoch at Jan. 1, 1970 at midnight.
- */
-gps_time_t gps_time_t::utc_epoch = FromUTC(utc_time_t::utc_epoch);
-
-/**
- * @brief The UTC epoch at Jan. 1, 1970 at midnight.
- */
-utc_time_t utc_time_t::utc_epoch = utc_time_t(0);
-
-/**
- * @brief The next leap second to occur on or after the given time.
- *
- * If the given time is a leap second, it will return the given time.
- */
-static std::vector<gps_time_t>::const_iterator
-next_leap_second(const gps_time_t &gps_time)
-{
-  return std::upper_bound(
-    gps_time_t::leap_seconds.begin(), gps_time_t::leap_seconds.end(), gps_time
-  );
-}
-
-/**
- * @brief The next leap second to occur on or after the given time.
- *
- * If the given time is a leap second, it will return the given time.
- */
-static std::vector<utc_time_t>::const_iterator
-next_leap_second(const utc_time_t &utc_time)
-{
-  return std::upper_bound(
-    utc_time_t::leap_seconds.begin(), utc_time_t::leap_seconds.end(), utc_time
-  );
-}
+static_assert(epoch_adjust == utc_gps_epoch_offset);
 
 /**
  * @brief The number of leap seconds elapsed between the GPS epoch and the given
@@ -410,23 +149,10 @@ next_leap_second(const utc_time_t &utc_time)
  * has occurred.
  */
 static std::pair<ptrdiff_t, bool>
-elapsed_leap_seconds(const gps_time_t &gps_time)
-{
-  // The first leap second after the GPS epoch.
-  static auto EPOCH_BEGIN_LEAP_SECOND = next_leap_second(gps_time_t::gps_epoch);
-  auto next = next_leap_second(gps_time);
-  if (next == gps_time_t::leap_seconds.begin()) {
-    // The given time is before the first leap second, therefore it is not a
-    // leap second.
-    return {std::distance(EPOCH_BEGIN_LEAP_SECOND, next), false};
-  } else {
-    auto prev = next - 1;
-    // No need to check the difference is positive: prev < gps_time because if
-    // it weren't, it would have been returned by `next_leap_second` (and
-    // therefore be in `next`, not `prev`).
-    bool is_leap = (gps_time - *prev) < duration_t::from_secs(1);
-    return {std::distance(EPOCH_BEGIN_LEAP_SECOND, next), is_leap};
-  }
+elapsed_leap_seconds(const gps_time_t &gps_time,
+                     const leap_table_t &table = CurrentLeapTable())
+{
+  return table.elapsed_gps(gps_time.get_fs());
 }
 
 /**
@@ -438,24 +164,19 @@ elapsed_leap_seconds(const gps_time_t &gps_time)
  * has occurred.
  */
 static std::pair<ptrdiff_t, bool>
-elapsed_leap_seconds(const utc_time_t &utc_time)
-{
-  // The first leap second after the GPS epoch.
-  static auto EPOCH_BEGIN_LEAP_SECOND = next_leap_second(utc_time_t::gps_epoch);
-  auto next = next_leap_second(utc_time);
-  if (next == utc_time_t::leap_seconds.begin()) {
-    // The given time is before the first leap second, therefore it is not a
-    // leap second.
-    return {std::distance(EPOCH_BEGIN_LEAP_SECOND, next), false};
-  } else {
-    return {std::distance(EPOCH_BEGIN_LEAP_SECOND, next), utc_time.is_leap()};
-  }
+elapsed_leap_seconds(const utc_time_t &utc_time,
+                     const leap_table_t &table = CurrentLeapTable())
+{
+  auto elapsed = table.elapsed_utc(utc_time.get_fs(), utc_time.is_leap());
+  return {elapsed, utc_time.is_leap()};
 }
 
 int LeapSecondsBetween(const utc_time_t& time1, const utc_time_t& time2)
 {
-  auto [elapsed1, leap1] = elapsed_leap_seconds(time1);
-  auto [elapsed2, leap2] = elapsed_leap_seconds(time2);
+  // Both lookups use the same table, even if a new one is being published
+  const auto &table = CurrentLeapTable();
+  auto [elapsed1, leap1] = elapsed_leap_seconds(time1, table);
+  auto [elapsed2, leap2] = elapsed_leap_seconds(time2, table);
   return elapsed2 - elapsed1;
 }
 
@@ -467,179 +188,168 @@ bool IsJulian(const std::string &date_string)
   return date_string.find("-") == std::string::npos;
 }
 
-static uint64_t pow10(int n)
-{
-  static constexpr uint64_t pow_table[] = {
-    1u, 10u, 100u, 1000u, 10'000u,
-    100'000u, 1'000'000u, 10'000'000u,
-    100'000'000u, 1'000'000'000u,
-    10'000'000'000u, 100'000'000'000u,
-    1'000'000'000'000u, 10'000'000'000'000u,
-    100'000'000'000'000u,
-    1'000'000'000'000'000u,
-    10'000'000'000'000'000u,
-    100'000'000'000'000'000u,
-    1'000'000'000'000'000'000u,
-    10'000'000'000'000'000'000u,
-  };
-  return pow_table[n];
+parse_result_t<gps_time_t> TryFromUTCString(std::string_view utc_time) noexcept
+{
+  civil_fields_t fields;
+  parse_result_t<gps_time_t> result;
+  if (auto status = parse_iso_fields(utc_time, iso_layout_t::extended,
+                                     fields); !status) {
+    result.error = status.error;
+    result.offset = status.offset;
+    if (utc_time.find('-') == std::string_view::npos) {
+      result.error = parse_error_t::julian_date;
+      result.offset = 0;
+    }
+    return result;
+  }
+  result.value = gps_time_t::FromUTC(utc_time_t(fields));
+  return result;
 }
 
-/** @brief Convert a UTC time string to a gps_time_t */
-gps_time_t gps_time_t::FromUTCString(const std::string& utc_time)
+parse_result_t<gps_time_t> TryFromGPSString(std::string_view gps_time) noexcept
 {
-  if (IsJulian(utc_time)) {
-    throw std::runtime_error(
-      "Modified-Julian conversion is no longer supported");
+  constexpr std::string_view prefix = "GPS_";
+  parse_result_t<gps_time_t> result;
+  for (std::size_t i = 0; i < prefix.size(); i++) {
+    if (i == gps_time.size() || gps_time[i] != prefix[i]) {
+      result.error = parse_error_t::expected_separator;
+      result.offset = i;
+      return result;
+    }
   }
+  civil_fields_t fields;
+  if (auto status = parse_iso_fields(gps_time.substr(prefix.size()),
+                                     iso_layout_t::extended, fields);
+      !status) {
+    result.error = status.error;
+    result.offset = status.offset + prefix.size();
+    return result;
+  }
+  result.value = gps_time_t(fields);
+  return result;
+}
+
+parse_result_t<gps_time_t> TryFromISOString(std::string_view iso_time) noexcept
+{
+  civil_fields_t fields;
+  parse_result_t<gps_time_t> result;
+  if (auto status = parse_iso_fields(iso_time, iso_layout_t::basic, fields);
+      !status) {
+    result.error = status.error;
+    result.offset = status.offset;
+    return result;
+  }
+  result.value = gps_time_t::FromUTC(utc_time_t(fields));
+  return result;
+}
 
-  int year, month, day, hour, min, seconds;
-
-  // Scan the string into constituent parts
-  int result;
-  long nanos=0, femtos=0;
-  auto dot_pos = utc_time.find(".");
-  if (dot_pos == std::string::npos) {
-    // If no "." in string, the number of seconds is an integer, so we can avoid
-    // the issues with precision altogether.
-    result = sscanf(utc_time.c_str(), "%04d-%02d-%02dT%02d:%02d:%02d",
-                    &year, &month, &day, &hour, &min, &seconds);
-
-    if (result != 6) {
-      auto msg = fmt::format("Cannot parse string '{}' as UTC time", utc_time);
-      throw std::runtime_error(msg);
+parse_result_t<civil_date_t> TryString2Date(std::string_view date_string)
+  noexcept
+{
+  parse_result_t<civil_date_t> result;
+  auto &[year, month, day] = result.value;
+  std::size_t pos = 0;
+  auto fail = [&](parse_error_t error) {
+    result.value = {};
+    result.error = error;
+    result.offset = pos;
+    return result;
+  };
+  if (date_string.find('-') == std::string_view::npos) {
+    // A Modified-Julian day number
+    int mjd;
+    if (!read_digits(date_string, pos, 1, 9, mjd)) {
+      return fail(parse_error_t::expected_digit);
     }
-  } else {
-    // If there is a dot, scanning gets much more tricky. Because neither
-    // `double` nor `long double` has the precision we need, we need to parse
-    // the time after the dot as a separate integer. However, we cannot simply
-    // parse before and after the dot as integers, as we wouldn't know how many
-    // digits of precision the post-dot integer was given as. For example,
-    // `.0001` and `.1` would both parse as `1` here. As such, we split the
-    // string at the dot, parse the pre-dot portion normally, and then parse the
-    // post-decimal portion seperately.
-    unsigned long long unscaled_partials;
-    int pre_partials, post_partials;
-
-    result = sscanf(utc_time.c_str(), "%04d-%02d-%02dT%02d:%02d:%02d.%n%llu%nZ",
-                    &year, &month, &day, &hour, &min, &seconds,
-                    &pre_partials, &unscaled_partials, &post_partials);
-
-    if (result != 7) { // Note that %n isn't counted here
-      auto msg = fmt::format(
-        "Cannot parse string '{}' as UTC time (result {}, post {}, len {})",
-        utc_time, result, post_partials, utc_time.length());
-      throw std::runtime_error(msg);
+    if (pos != date_string.size()) {
+      return fail(is_digit(date_string[pos])
+                  ? parse_error_t::out_of_range
+                  : parse_error_t::trailing_characters);
     }
-
-    auto partial_len = post_partials - pre_partials;
-    const int femto_digits = 15;
-    auto scaling_factor = femto_digits - partial_len;
-    femtosecs_t total_femtos;
-    if (scaling_factor < 0) {
-      total_femtos = unscaled_partials / pow10(-scaling_factor);
-    } else {
-      total_femtos = unscaled_partials * pow10(scaling_factor);
+    std::tie(year, month, day) = civil_from_days(mjd, mjd_y2000_epoch);
+    return result;
+  }
+  if (!read_digits(date_string, pos, 1, 4, year)) {
+    return fail(parse_error_t::expected_digit);
+  }
+  for (int *field : {&month, &day}) {
+    if (pos == date_string.size() || date_string[pos] != '-') {
+      return fail(parse_error_t::expected_separator);
     }
-    nanos = total_femtos / fs_per_ns;
-    femtos = total_femtos % fs_per_ns;
+    pos++;
+    if (!read_digits(date_string, pos, 1, 2, *field)) {
+      return fail(parse_error_t::expected_digit);
+    }
+  }
+  if (pos != date_string.size()) {
+    return fail(parse_error_t::trailing_characters);
   }
-  // TODO: Create femtosecond-precision constructor
-  utc_time_t parsed_time(year, month, day, hour, min, seconds, nanos);
-  duration_t addl_femtos(femtos);
-  return FromUTC(parsed_time) + addl_femtos;
+  return result;
 }
 
 /**
- * @brief Deprecated compatibility adapter for `gps_time_t::FromUTCString`.
+ * @brief Throw the error from a failed parse, naming the kind of time that
+ * was expected
  */
-gps_time_t FromUTCString(const std::string& utc_time)
+[[noreturn]] static void throw_parse_error(std::string_view text,
+                                           const char *kind,
+                                           const parse_status_t &status)
 {
-  return gps_time_t::FromUTCString(utc_time);
+  if (status.error == parse_error_t::julian_date) {
+    throw std::runtime_error(
+      "Modified-Julian conversion is no longer supported");
+  }
+  auto msg = fmt::format("Cannot parse string '{}' as {} time: {} at offset {}",
+                         text, kind, ToString(status.error), status.offset);
+  throw std::runtime_error(msg);
 }
 
 /** @brief Convert a UTC time string to a gps_time_t */
-gps_time_t gps_time_t::FromGPSString(const std::string& gps_time)
+gps_time_t gps_time_t::FromUTCString(std::string_view utc_time)
 {
+  auto result = TryFromUTCString(utc_time);
+  if (!result) {
+    throw_parse_error(utc_time, "UTC", result);
+  }
+  return result.value;
+}
 
-  int year, month, day, hour, min, seconds;
-
-  // Scan the string into constituent parts
-  int result;
-  long nanos, femtos;
-  auto dot_pos = gps_time.find(".");
-  if (dot_pos == std::string::npos) {
-    // If no "." in string, the number of seconds is an integer, so we can avoid
-    // the issues with precision altogether.
-    result = sscanf(gps_time.c_str(), "GPS_%04d-%02d-%02dT%02d:%02d:%02dZ",
-                    &year, &month, &day, &hour, &min, &seconds);
-    nanos = 0;
-
-    if (result != 6) {
-      auto msg = fmt::format("Cannot parse string '{}' as UTC time", gps_time);
-      throw std::runtime_error(msg);
-    }
-  } else {
-    // If there is a dot, scanning gets much more tricky. Because neither
-    // `double` nor `long double` has the precision we need, we need to parse
-    // the time after the dot as a separate integer. However, we cannot simply
-    // parse before and after the dot as integers, as we wouldn't know how many
-    // digits of precision the post-dot integer was given as. For example,
-    // `.0001` and `.1` would both parse as `1` here. As such, we add specifiers
-    // to count the number of characters parsed before and after the decimal,
-    // to determine the length.
-    unsigned long long unscaled_partials;
-    int pre_partials, post_partials;
-
-    result = sscanf(gps_time.c_str(),
-                    "GPS_%04d-%02d-%02dT%02d:%02d:%02d.%n%llu%nZ",
-                    &year, &month, &day, &hour, &min, &seconds,
-                    &pre_partials, &unscaled_partials, &post_partials);
-
-    if (result != 7) { // Note that %n isn't counted here
-      auto msg = fmt::format("Cannot parse string '{}' as GPS time (result {})",
-                             gps_time, result);
-      throw std::runtime_error(msg);
-    }
+/**
+ * @brief Deprecated compatibility adapter for `gps_time_t::FromUTCString`.
+ */
+gps_time_t FromUTCString(std::string_view utc_time)
+{
+  return gps_time_t::FromUTCString(utc_time);
+}
 
-    auto partial_len = post_partials - pre_partials;
-    const int femto_digits = 15;
-    auto scaling_factor = femto_digits - partial_len;
-    femtosecs_t total_femtos;
-    if (scaling_factor < 0) {
-      total_femtos = unscaled_partials / pow10(-scaling_factor);
-    } else {
-      total_femtos = unscaled_partials * pow10(scaling_factor);
-    }
-    nanos = total_femtos / fs_per_ns;
-    femtos = total_femtos % fs_per_ns;
+/** @brief Convert a GPS time string (`GPS_YYYY-MM-DDTHH:MM:SS[.f...][Z]`) to
+ * a gps_time_t */
+gps_time_t gps_time_t::FromGPSString(std::string_view gps_time)
+{
+  auto result = TryFromGPSString(gps_time);
+  if (!result) {
+    throw_parse_error(gps_time, "GPS", result);
   }
-  duration_t addl_femtos(femtos);
-  return gps_time_t(year, month, day, hour, min, seconds, nanos) + addl_femtos;
+  return result.value;
 }
 
 /**
  * @brief Deprecated compatibility adapter for `gps_time_t::FromGPSString`.
  */
-gps_time_t FromGPSString(const std::string& gps_time)
+gps_time_t FromGPSString(std::string_view gps_time)
 {
   return gps_time_t::FromGPSString(gps_time);
 }
 
-gps_time_t gps_time_t::FromISOString(const std::string& iso_time)
+/** @brief Convert a basic-format (`YYYYMMDDTHHMMSS[.f...][Z]`) UTC string to a
+ * gps_time_t */
+gps_time_t gps_time_t::FromISOString(std::string_view iso_time)
 {
-  int year, month, day, hour, min, seconds;
-
-  auto result = sscanf(iso_time.c_str(), "%04d%02d%02dT%02d%02d%02d",
-                       &year, &month, &day, &hour, &min, &seconds);
-
-  if (result != 6) {
-      auto msg = fmt::format("Cannot parse string '{}' as ISO time (result {})",
-                             iso_time, result);
-      throw std::runtime_error(msg);
+  auto result = TryFromISOString(iso_time);
+  if (!result) {
+    throw_parse_error(iso_time, "ISO", result);
   }
-
-  return FromUTC(utc_time_t(year, month, day, hour, min, seconds, 0));
+  return result.value;
 }
 
 /**
@@ -715,12 +425,10 @@ gps_time_t gps_time_t::FromTimespec(struct timespec *ts)
   return result;
 }
 
-static long julian_epoch = 51604;
-
 /** @brief Return a Gregorian date nday from the modified Julian epoch */
 void Julian2UTC(const long &nday, int &year, int &month, int &day)
 {
-  auto [y, m, d] = dayToDate(nday, julian_epoch);
+  auto [y, m, d] = civil_from_days(nday, mjd_y2000_epoch);
 
   year = y;
   month = m;
@@ -732,29 +440,19 @@ void Julian2UTC(const long &nday, int &year, int &month, int &day)
 */
 std::string String2Date(const std::string& date_string)
 {
-  int year, month, day;
-  std::string result;
-  try {
-  
-    if (IsJulian(date_string)) { 
-    
-      // this is Modified Julian Day format
-      auto iday = stol(date_string);
-      
-      // get UTC year, month, day from integer Julian day
-      Julian2UTC(iday, year, month, day);
-
-      // form the string
-      result = fmt::format("{:04}-{:02}-{:02}", year, month, day);
-
-    } else {
-      result = date_string;
-    }    
-  } catch (std::exception &e) {
-    auto msg = fmt::format("in {}() -- {}", __FUNCTION__, e.what());
+  if (!IsJulian(date_string)) {
+    return date_string;
+  }
+  auto result = TryString2Date(date_string);
+  if (!result) {
+    auto msg = fmt::format("in {}() -- cannot parse '{}' as a Modified-Julian "
+                           "day: {} at offset {}", __FUNCTION__, date_string,
+                           ToString(result.error), result.offset);
     throw runtime_error(msg);
   }
-  return result;
+  auto [year, month, day] = result.value;
+  char buffer[time_string_capacity];
+  return std::string(buffer, write_date(buffer, year, month, day));
 }
 
 gps_time_t::gps_time_t(int year, int month, int day,
@@ -772,72 +470,70 @@ gps_time_t::gps_time_t(int year, int month, int day,
   _femtosecs += static_cast<femtosecs_t>(nanos) * fs_per_ns;
 }
 
-femtosecs_t gps_time_t::get_fs() const
-{
-  return _femtosecs;
-}
+gps_time_t::gps_time_t(const civil_fields_t &fields)
+  : _femtosecs(fields2fs(fields, gps_y2000_epoch))
+{}
 
 /** @brief get the year */
 int gps_time_t::Year() const
 {
   // FIXME: Can this be done without calculating the month/day?
-  auto [total_days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
-  auto [year, month, day] = gpsDayToDate(total_days);
+  auto [year, month, day] = gpsDayToDate(split_days(_femtosecs).days);
   return year;
 }
 
 int gps_time_t::Month() const
 {
   // FIXME: Can this be done without calculating the year/day?
-  auto [total_days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
-  auto [year, month, day] = gpsDayToDate(total_days);
+  auto [year, month, day] = gpsDayToDate(split_days(_femtosecs).days);
   return month;
 }
 
 int gps_time_t::Day() const
 {
   // FIXME: Can this be done without calculating the year/month?
-  auto [total_days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
-  auto [year, month, day] = gpsDayToDate(total_days);
+  auto [year, month, day] = gpsDayToDate(split_days(_femtosecs).days);
   return day;
 }
 
 int gps_time_t::Hour() const
 {
-  auto [days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
-  return partial_days / fs_per_hour;
+  return split_days(_femtosecs).sec_of_day / secs_per_hour_64;
 }
 
 int gps_time_t::Minute() const
 {
-  auto [hours, partial_hours] = euclidean_div(_femtosecs, fs_per_hour);
-  return partial_hours / fs_per_min;
+  return split_days(_femtosecs).sec_of_day / sec_per_min_64 % 60;
 }
 
 double gps_time_t::Seconds() const
 {
-  auto [minutes, partial_minutes] = euclidean_div(_femtosecs, fs_per_min);
+  auto [secs, subsec] = split_secs(_femtosecs);
+  auto partial_minutes = euclidean_div(secs, sec_per_min_64).second * fs_per_sec_64
+    + subsec;
   return static_cast<double>(partial_minutes) / fs_per_sec;
 }
 
 int gps_time_t::WholeSeconds() const
 {
-  auto [minutes, partial_minutes] = euclidean_div(_femtosecs, fs_per_min);
-  return partial_minutes / fs_per_sec;
+  return euclidean_div(split_secs(_femtosecs).secs, sec_per_min_64).second;
 }
 
 int gps_time_t::Nanoseconds() const
 {
-  auto [seconds, partial_seconds] = euclidean_div(_femtosecs, fs_per_sec);
-  return partial_seconds / fs_per_ns;
+  return split_secs(_femtosecs).subsec / fs_per_ns_64;
 }
 
 int gps_time_t::DayOfYear() const
 {
-  auto [total_days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
-  auto [year, month, day] = gpsDayToDate(total_days);
-  // date2doy returns 0-indexed, we want 1-indexed
-  return date2doy(year, month, day) + 1;
+  auto [year, month, day] = gpsDayToDate(split_days(_femtosecs).days);
+  // civil_day_of_year returns 0-indexed, we want 1-indexed
+  return civil_day_of_year(year, month, day) + 1;
+}
+
+civil_fields_t gps_time_t::Fields() const
+{
+  return fs2fields(_femtosecs, gps_y2000_epoch);
 }
 
 long double gps_time_t::SecondsSinceEpoch() const
@@ -848,9 +544,10 @@ long double gps_time_t::SecondsSinceEpoch() const
 long double gps_time_t::SecondsSinceYear() const
 {
   // FIXME: Is this the most efficient way to do this?
-  auto [total_days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
+  auto [total_days, sec_of_day, subsec] = split_days(_femtosecs);
   auto [year, month, day] = gpsDayToDate(total_days);
-  auto day_of_year = date2doy(year, month, day);
+  femtosecs_t partial_days = sec_of_day * fs_per_sec + subsec;
+  auto day_of_year = civil_day_of_year(year, month, day);
   auto partial_day_secs = static_cast<long double>(partial_days) / fs_per_sec;
   auto full_day_secs = day_of_year * secs_per_year;
   return full_day_secs + partial_day_secs;
@@ -858,29 +555,44 @@ long double gps_time_t::SecondsSinceYear() const
 
 long double gps_time_t::SecondsSinceDay() const
 {
-  auto [days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
+  auto [days, sec_of_day, subsec] = split_days(_femtosecs);
+  femtosecs_t partial_days = sec_of_day * fs_per_sec + subsec;
   return static_cast<long double>(partial_days) / fs_per_sec;
 }
 
 string gps_time_t::ToString() const
 {
-  auto [total_days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
-  auto [year, month, day] = gpsDayToDate(total_days);
-  auto [hours, partial_hours] = euclidean_div(partial_days, fs_per_hour);
-  auto [mins, partial_mins] = euclidean_div(partial_hours, fs_per_min);
-  auto [secs, femtos] = euclidean_div(partial_mins, fs_per_sec);
-
-  return fmt::format(
-    "GPS_{:04}-{:02}-{:02}T{:02}:{:02}:{:02}.{:015}Z",
-    year, month, day, hours, mins, secs, femtos
-  );
+  char buffer[time_string_capacity];
+  return string(buffer, FormatTo(buffer));
 }
 
 string gps_time_t::DateString() const
 {
-  auto [total_days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
-  auto [year, month, day] = gpsDayToDate(total_days);
-  return fmt::format("{:04}-{:02}-{:02}", year, month, day);
+  char buffer[time_string_capacity];
+  return string(buffer, FormatDateTo(buffer));
+}
+
+/** @brief Write `GPS_YYYY-MM-DDTHH:MM:SS.fffffffffffffffZ` */
+char *gps_time_t::FormatTo(char *out) const
+{
+  return FormatTo(out, {time_style_t::gps, time_precision_t::fs});
+}
+
+char *gps_time_t::FormatTo(char *out, const time_format_t &format) const
+{
+  return write_time(out, Fields(), format);
+}
+
+string gps_time_t::ToString(const time_format_t &format) const
+{
+  char buffer[time_string_capacity];
+  return string(buffer, FormatTo(buffer, format));
+}
+
+char *gps_time_t::FormatDateTo(char *out) const
+{
+  auto [year, month, day] = gpsDayToDate(split_days(_femtosecs).days);
+  return write_date(out, year, month, day);
 }
 
 /**
@@ -900,57 +612,6 @@ bool gps_time_t::IsLeapYear() const
   return is_leap_year(Year());
 }
 
-bool gps_time_t::operator==(const gps_time_t &other) const
-{
-  return _femtosecs == other._femtosecs;
-}
-
-bool gps_time_t::operator!=(const gps_time_t &other) const
-{
-  return !this->operator==(other);
-}
-
-bool gps_time_t::operator<(const gps_time_t &other) const
-{
-  return _femtosecs < other._femtosecs;
-}
-
-bool gps_time_t::operator<=(const gps_time_t &other) const
-{
-  return _femtosecs <= other._femtosecs;
-}
-
-bool gps_time_t::operator>(const gps_time_t &other) const
-{
-  return _femtosecs > other._femtosecs;
-}
-
-bool gps_time_t::operator>=(const gps_time_t &other) const
-{
-  return _femtosecs >= other._femtosecs;
-}
-
-gps_time_t gps_time_t::operator+(const duration_t &other) const
-{
-  return gps_time_t(_femtosecs + other.get_fs());
-}
-
-gps_time_t gps_time_t::operator-(const duration_t &other) const
-{
-  return gps_time_t(_femtosecs - other.get_fs());
-}
-
-duration_t gps_time_t::operator-(const gps_time_t &other) const
-{
-  return duration_t(_femtosecs - other._femtosecs);
-}
-
-gps_time_t& gps_time_t::operator+=(const duration_t &other)
-{
-  _femtosecs += other.get_fs();
-  return *this;
-}
-
 /**
  * @brief Compute decimal year
  *
@@ -968,9 +629,10 @@ gps_time_t& gps_time_t::operator+=(const duration_t &other)
 double gps_time_t::DecimalYear() const
 {
   // TODO: Remove
-  auto [total_days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
+  auto [total_days, sec_of_day, subsec] = split_days(_femtosecs);
   auto [year, month, day] = gpsDayToDate(total_days);
-  auto day_of_year = date2doy(year, month, day);
+  femtosecs_t partial_days = sec_of_day * fs_per_sec + subsec;
+  auto day_of_year = civil_day_of_year(year, month, day);
   auto days_in_year = is_leap_year(year) ? 366 : 365;
   auto days_through_year = static_cast<double>(day_of_year) / days_in_year;
   auto partial = static_cast<double>(partial_days) / fs_per_day;
@@ -983,49 +645,35 @@ double gps_time_t::DecimalYear() const
  */
 std::tuple<int, int, int> gps_time_t::ToDate() const
 {
-  auto [total_days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
-  return gpsDayToDate(total_days);
+  return gpsDayToDate(split_days(_femtosecs).days);
 }
 
 /** @brief Constructor */
 utc_time_t::utc_time_t(int y, int mon, int d, int h, int min, int s, int n)
-  : _leap(s == 60)
-{
-  s -= _leap;
-  _femtosecs = DateTime2UTC(y, mon, d, h, min, s);
-  _femtosecs += n * fs_per_ns;
-}
+  : utc_time_t(DateTime2UTC(y, mon, d, h, min, s - (s == 60))
+               + n * fs_per_ns, s == 60)
+{}
 
 utc_time_t::utc_time_t(int year, int month, int day,
                        int hours, int minutes, long double secs)
-  : _leap(secs >= 60)
-{
-  secs -= _leap;
-  _femtosecs = DateTime2UTC(year, month, day, hours, minutes, secs);
-}
+  : utc_time_t(DateTime2UTC(year, month, day, hours, minutes,
+                            secs - (secs >= 60)), secs >= 60)
+{}
 
-/** @brief The number of femtoseconds elapsed since the UTC epoch
+/** @brief Constructor from broken-down fields
  *
- * Note that this excludes elapsed leap seconds, for a better means of measuring
- * duration, use gps_time_t.
+ * A `second` of 60 is taken to be a leap second.
  */
-femtosecs_t utc_time_t::get_fs() const
-{
-  return _femtosecs;
-}
-
-/** @brief If the current UTC time is a leap second or not*/
-bool utc_time_t::is_leap() const
-{
-  return _leap;
-}
+utc_time_t::utc_time_t(const civil_fields_t &fields)
+  : utc_time_t(fields2fs(fields, utc_y2000_epoch)
+               - (fields.second == 60) * fs_per_sec, fields.second == 60)
+{}
 
 /** @brief The year of the timestamp */
 int utc_time_t::Year() const
 {
   // FIXME: Can this be done without calculating the month/day?
-  auto [total_days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
-  auto [year, month, day] = utcDayToDate(total_days);
+  auto [year, month, day] = utcDayToDate(split_days(get_fs()).days);
   return year;
 }
 
@@ -1033,8 +681,7 @@ int utc_time_t::Year() const
 int utc_time_t::Month() const
 {
   // FIXME: Can this be done without calculating the year/day?
-  auto [total_days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
-  auto [year, month, day] = utcDayToDate(total_days);
+  auto [year, month, day] = utcDayToDate(split_days(get_fs()).days);
   return month;
 }
 
@@ -1042,23 +689,20 @@ int utc_time_t::Month() const
 int utc_time_t::Day() const
 {
   // FIXME: Can this be done without calculating the year/month?
-  auto [total_days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
-  auto [year, month, day] = utcDayToDate(total_days);
+  auto [year, month, day] = utcDayToDate(split_days(get_fs()).days);
   return day;
 }
 
 /** @brief The hour of the timestamp */
 int utc_time_t::Hour() const
 {
-  auto [days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
-  return partial_days / fs_per_hour;
+  return split_days(get_fs()).sec_of_day / secs_per_hour_64;
 }
 
 /** @brief The minute of the timestamp */
 int utc_time_t::Minute() const
 {
-  auto [hours, partial_hours] = euclidean_div(_femtosecs, fs_per_hour);
-  return partial_hours / fs_per_min;
+  return split_days(get_fs()).sec_of_day / sec_per_min_64 % 60;
 }
 
 /** @brief The second and partial second of the timestamp
@@ -1067,31 +711,39 @@ int utc_time_t::Minute() const
  */
 double utc_time_t::Seconds() const
 {
-  auto [minutes, partial_minutes] = euclidean_div(_femtosecs, fs_per_min);
-  return static_cast<double>(partial_minutes) / fs_per_sec + _leap;
+  auto [secs, subsec] = split_secs(get_fs());
+  auto partial_minutes = euclidean_div(secs, sec_per_min_64).second * fs_per_sec_64
+    + subsec;
+  return static_cast<double>(partial_minutes) / fs_per_sec + is_leap();
 }
 
 /** @brief The second of the timestamp */
 int utc_time_t::WholeSeconds() const
 {
-  auto [minutes, partial_minutes] = euclidean_div(_femtosecs, fs_per_min);
-  return partial_minutes / fs_per_sec + _leap;
+  return euclidean_div(split_secs(get_fs()).secs, sec_per_min_64).second
+    + is_leap();
 }
 
 /** @brief The nanoseconds of the timestamp */
 int utc_time_t::Nanoseconds() const
 {
-  auto [seconds, partial_seconds] = euclidean_div(_femtosecs, fs_per_sec);
-  return partial_seconds / fs_per_ns;
+  return split_secs(get_fs()).subsec / fs_per_ns_64;
 }
 
 /** @brief The 1-indexed day of the year */
 int utc_time_t::DayOfYear() const
 {
-  auto [total_days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
-  auto [year, month, day] = utcDayToDate(total_days);
-  // date2doy returns 0-indexed, we want 1-indexed
-  return date2doy(year, month, day) + 1;
+  auto [year, month, day] = utcDayToDate(split_days(get_fs()).days);
+  // civil_day_of_year returns 0-indexed, we want 1-indexed
+  return civil_day_of_year(year, month, day) + 1;
+}
+
+/** @brief All of the fields of the timestamp, with leap seconds as second 60 */
+civil_fields_t utc_time_t::Fields() const
+{
+  auto fields = fs2fields(get_fs(), utc_y2000_epoch);
+  fields.second += is_leap();
+  return fields;
 }
 
 /** @brief Convert the timestamp to its equivalent GPS time */
@@ -1103,128 +755,99 @@ gps_time_t utc_time_t::ToGPS() const
 /** @brief Convert the timestamp to a string */
 std::string utc_time_t::ToString() const
 {
-  auto [total_days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
-  auto [year, month, day] = utcDayToDate(total_days);
-  auto [hours, partial_hours] = euclidean_div(partial_days, fs_per_hour);
-  auto [mins, partial_mins] = euclidean_div(partial_hours, fs_per_min);
-  auto [secs, femtos] = euclidean_div(partial_mins, fs_per_sec);
-
-  return fmt::format(
-    "{:04}-{:02}-{:02}T{:02}:{:02}:{:02}.{:015}Z",
-    year, month, day, hours, mins, secs + _leap, femtos
-  );
+  char buffer[time_string_capacity];
+  return string(buffer, FormatTo(buffer));
 }
 
 /** @brief Convert the date portion of the timestamp to a string */
 std::string utc_time_t::DateString() const
 {
-  auto [total_days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
-  auto [year, month, day] = utcDayToDate(total_days);
-  return fmt::format("{:04}-{:02}-{:02}", year, month, day);
+  char buffer[time_string_capacity];
+  return string(buffer, FormatDateTo(buffer));
 }
 
-/** @brief Get the date portion of the timestamp as a y/m/d triple */
-std::tuple<int, int, int> utc_time_t::ToDate() const
+/** @brief Write `YYYY-MM-DDTHH:MM:SS.fffffffffffffffZ` */
+char *utc_time_t::FormatTo(char *out) const
 {
-  auto [total_days, partial_days] = euclidean_div(_femtosecs, fs_per_day);
-  return utcDayToDate(total_days);
-}
-
-bool utc_time_t::operator==(const utc_time_t &other) const {
-  return _femtosecs == other._femtosecs;
+  return FormatTo(out, {time_style_t::extended, time_precision_t::fs});
 }
 
-bool utc_time_t::operator!=(const utc_time_t &other) const {
-  return !this->operator==(other);
-}
-
-bool utc_time_t::operator<(const utc_time_t &other) const {
-  // Because of how we store leap seconds here, this gets a little bit
-  // complicated. If the two types have the same leap-second status, then the
-  // calculation is simple. Otherwise, we need to modify one of them so they're
-  // using the same basis (leap seconds are one second off from non-leap
-  // seconds).
-  if (_leap == other._leap) {
-    return _femtosecs < other._femtosecs;
-  } else {
-    femtosecs_t delta = _leap - other._leap;
-    return _femtosecs + delta * fs_per_sec < other._femtosecs;
-  }
-}
-
-bool utc_time_t::operator<=(const utc_time_t &other) const {
-  return *this == other || *this < other;
+/** @brief Write the timestamp, with a leap second as second 60 */
+char *utc_time_t::FormatTo(char *out, const time_format_t &format) const
+{
+  return write_time(out, Fields(), format);
 }
 
-bool utc_time_t::operator>(const utc_time_t &other) const {
-  return other < *this;
+std::string utc_time_t::ToString(const time_format_t &format) const
+{
+  char buffer[time_string_capacity];
+  return string(buffer, FormatTo(buffer, format));
 }
 
-bool utc_time_t::operator>=(const utc_time_t &other) const {
-  return *this == other || *this > other;
+char *utc_time_t::FormatDateTo(char *out) const
+{
+  auto [year, month, day] = utcDayToDate(split_days(get_fs()).days);
+  return write_date(out, year, month, day);
 }
 
-/** @brief The total number of femtoseconds in the duration */
-femtosecs_t duration_t::get_fs() const
+/** @brief Get the date portion of the timestamp as a y/m/d triple */
+std::tuple<int, int, int> utc_time_t::ToDate() const
 {
-  return _femtosecs;
+  return utcDayToDate(split_days(get_fs()).days);
 }
 
 /** @brief The total number of days elapsed */
 long duration_t::total_days() const
 {
-  return _femtosecs / fs_per_day;
+  return split_secs_trunc(_femtosecs).secs / secs_per_day_64;
 }
 
 /** @brief The total number of hours elapsed */
 long duration_t::total_hours() const
 {
-  return _femtosecs / fs_per_hour;
+  return div_trunc_by<fs_per_hour_64>(_femtosecs);
 }
 
 /** @brief The total number of seconds elapsed */
 long duration_t::total_seconds() const
 {
-  return _femtosecs / fs_per_sec;
+  return div_trunc_by<fs_per_sec_64>(_femtosecs);
 }
 
 /** @brief The total number of milliseconds elapsed */
 long duration_t::total_milliseconds() const
 {
-  return _femtosecs / fs_per_ms;
+  return div_trunc_by<fs_per_ms_64>(_femtosecs);
 }
 
 /** @brief The total number of microseconds elapsed */
 long duration_t::total_microseconds() const
 {
-  return _femtosecs / fs_per_us;
+  return div_trunc_by<fs_per_us_64>(_femtosecs);
 }
 
 /** @brief The total number of nanoseconds elapsed */
 long duration_t::total_nanoseconds() const
 {
-  return _femtosecs / fs_per_ns;
+  return div_trunc_by<fs_per_ns_64>(_femtosecs);
 }
 
 /** @brief The normalized number of hours elapsed (0-23) */
 long duration_t::hours() const
 {
-  auto partial_days = _femtosecs % fs_per_day;
-  return partial_days / fs_per_hour;
+  return split_secs_trunc(_femtosecs).secs % secs_per_day_64 / secs_per_hour_64;
 }
 
 /** @brief The normalized number of minutes elapsed (0-59) */
 long duration_t::minutes() const
 {
-  auto partial_hours = _femtosecs % fs_per_hour;
-  return partial_hours / fs_per_min;
+  return split_secs_trunc(_femtosecs).secs % secs_per_hour_64 / sec_per_min_64;
 }
 
 /** @brief The normalized number of seconds elapsed (0-59) */
 long duration_t::seconds() const
 {
-  auto partial_mins = _femtosecs % fs_per_min;
-  return partial_mins / fs_per_sec;
+  return split_secs_trunc(_femtosecs).secs % sec_per_min_64;
 }
 
 /** @brief Create a duration from an integer number of years */
@@ -1336,56 +959,40 @@ long double duration_t::f_seconds() const
   return whole_secs + static_cast<long double>(partial_secs) / fs_per_sec;
 }
 
-/** @brief Returns the negation of this duration */
-duration_t duration_t::invert_sign() const
-{
-  return duration_t(-_femtosecs);
-}
-
-/** @brief If the duration is a negative duration */
-bool duration_t::is_negative() const
-{
-  return _femtosecs < 0;
-}
-
-bool duration_t::operator==(const duration_t &other) const
+char *duration_t::FormatTo(char *out) const
 {
-  return _femtosecs == other._femtosecs;
+  return FormatTo(out, time_precision_t::fs);
 }
 
-bool duration_t::operator!=(const duration_t &other) const
+char *duration_t::FormatTo(char *out, time_precision_t precision) const
 {
-  return !(*this == other);
-}
-
-bool duration_t::operator<(const duration_t &other) const
-{
-  return _femtosecs < other._femtosecs;
-}
-
-bool duration_t::operator<=(const duration_t &other) const
-{
-  return *this == other || *this < other;
-}
-
-bool duration_t::operator>(const duration_t &other) const
-{
-  return other < *this;
-}
-
-bool duration_t::operator>=(const duration_t &other) const
-{
-  return *this == other || *this > other;
-}
-
-duration_t duration_t::operator+(const duration_t& other) const
-{
-  return duration_t(_femtosecs + other._femtosecs);
-}
-
-duration_t duration_t::operator-(const duration_t& other) const
-{
-  return duration_t(_femtosecs - other._femtosecs);
+  auto magnitude = static_cast<uint128_t>(_femtosecs);
+  if (_femtosecs < 0) {
+    *out++ = '-';
+    magnitude = -magnitude;
+  }
+  auto secs = magnitude / fs_per_sec;
+  auto subsec = static_cast<uint64_t>(magnitude % fs_per_sec);
+  // Seconds past 64 bits are written 19 digits at a time
+  constexpr uint64_t ten_19 = 10'000'000'000'000'000'000ULL;
+  if (secs >= ten_19) {
+    auto high = static_cast<uint64_t>(secs / ten_19);
+    out = write_digits(out, high, count_digits(high));
+    out = write_digits(out, static_cast<uint64_t>(secs % ten_19), 19);
+  } else {
+    auto low = static_cast<uint64_t>(secs);
+    out = write_digits(out, low, count_digits(low));
+  }
+  if (auto digits = static_cast<int>(precision); digits > 0) {
+    *out++ = '.';
+    uint64_t scale = 1;
+    for (int i = digits; i < 15; i++) {
+      scale *= 10;
+    }
+    out = write_digits(out, subsec / scale, digits);
+  }
+  *out++ = 's';
+  return out;
 }
 
 duration_t duration_t::operator*(double other) const
@@ -1393,30 +1000,23 @@ duration_t duration_t::operator*(double other) const
   return duration_t(_femtosecs * other);
 }
 
-duration_t duration_t::operator*(femtosecs_t other) const
-{
-  return duration_t(_femtosecs * other);
-}
-
 duration_t duration_t::operator/(double other) const
 {
   return duration_t(_femtosecs / other);
 }
 
-duration_t duration_t::operator/(femtosecs_t other) const
-{
-  return duration_t(_femtosecs / other);
-}
-
 /** @brief Output operator */
 std::ostream& operator<<(std::ostream& os, const gps_time_t& t) {
-  os << t.ToString();           // ToString() already has a GPS_ in it
+  char buffer[time_string_capacity];
+  // FormatTo() already has a GPS_ in it
+  os << std::string_view(buffer, t.FormatTo(buffer));
   return os;
 }
 
 /** @brief Output operator */
 std::ostream& operator<<(std::ostream& os, const utc_time_t& t) {
-  os << t.ToString();
+  char buffer[time_string_capacity];
+  os << std::string_view(buffer, t.FormatTo(buffer));
   return os;
 }
 
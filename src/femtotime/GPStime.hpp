@@ -6,22 +6,114 @@
 #pragma once
 
 // [C++ headers]
+#include <array>
+#include <compare>
 #include <vector>
 #include <cmath>
 #include <string>
+#include <string_view>
 
 // [Femtotime headers]
+#include "femtotime/leap_seconds.hpp"
 #include "femtotime/time_constants.hpp"
 
 // [Namespaces]
 namespace femtotime {
 
-typedef int128_t femtosecs_t;
-
 // Forward declarations
 class utc_time_t;
 class duration_t;
 
+/**
+ * @struct civil_fields_t
+ *
+ * A broken-down (year, month, ..., femtosecond) representation of a time,
+ * computed in a single pass by `gps_time_t::Fields()` and
+ * `utc_time_t::Fields()`.
+ */
+struct civil_fields_t
+{
+  /** @brief The (proleptic Gregorian) year */
+  int year;
+
+  /** @brief The month of the year, 1-12 */
+  int month;
+
+  /** @brief The day of the month, 1-31 */
+  int day;
+
+  /** @brief The hour of the day, 0-23 */
+  int hour;
+
+  /** @brief The minute of the hour, 0-59 */
+  int minute;
+
+  /** @brief The second of the minute, 0-59 (60 during a UTC leap second) */
+  int second;
+
+  /** @brief The nanoseconds of the second, 0-999999999 */
+  int nanosecond;
+
+  /** @brief The femtoseconds of the nanosecond, 0-999999 */
+  int femtosecond;
+
+  /** @brief The day of the year, 1-366 (ignored by the constructors) */
+  int day_of_year;
+};
+
+/**
+ * @brief The most characters any of the `FormatTo` functions write (they
+ * write no terminating null)
+ */
+constexpr std::size_t time_string_capacity = 48;
+
+/**
+ * @brief How much of the fraction of a second to format (it is truncated,
+ * not rounded); the values are the number of digits
+ */
+enum class time_precision_t
+{
+  s = 0,
+  ms = 3,
+  us = 6,
+  ns = 9,
+  ps = 12,
+  fs = 15,
+};
+
+/**
+ * @brief The layouts a time can be formatted in
+ */
+enum class time_style_t
+{
+  /** @brief `YYYY-MM-DDTHH:MM:SS.fZ`, the ISO 8601 extended format (the
+   * default for a utc_time_t) */
+  extended,
+
+  /** @brief `YYYYMMDDTHHMMSS.fZ`, the ISO 8601 basic format read by
+   * `FromISOString` */
+  basic,
+
+  /** @brief `GPS_YYYY-MM-DDTHH:MM:SS.fZ`, as read by `FromGPSString` (the
+   * default for a gps_time_t) */
+  gps,
+
+  /** @brief `YYYY-MM-DDTHH:MM:SS.f+00:00`, an RFC 3339 timestamp with an
+   * explicit offset */
+  rfc3339,
+};
+
+/**
+ * @struct time_format_t
+ *
+ * A style and precision for the `FormatTo` and `ToString` functions.
+ */
+struct time_format_t
+{
+  time_style_t style = time_style_t::extended;
+  time_precision_t precision = time_precision_t::fs;
+};
+
 /**
  * @class gps_time_t
  *
@@ -36,16 +128,16 @@ class gps_time_t
 public:
 
   /** @brief The list of leap seconds in GPS time */
-  static std::vector<gps_time_t> leap_seconds;
-  
+  static const std::array<gps_time_t, leap_second_count> leap_seconds;
+
   /** @brief The GPS epoch */
-  static gps_time_t gps_epoch;
+  static const gps_time_t gps_epoch;
 
   /** @brief The UTC epoch */
-  static gps_time_t utc_epoch;
+  static const gps_time_t utc_epoch;
 
   /** @brief constructor from a 128bit integer (femtoseconds since epoch) */
-  explicit gps_time_t(femtosecs_t fs = 0) : _femtosecs(fs)
+  explicit constexpr gps_time_t(femtosecs_t fs = 0) : _femtosecs(fs)
   {}
 
   /** @brief Constructor from timestamp with nanoseconds */
@@ -55,8 +147,14 @@ public:
   gps_time_t(int year, int month, int day,
              int hours, int minutes, long double secs);
 
+  /** @brief Constructor from broken-down fields */
+  explicit gps_time_t(const civil_fields_t &fields);
+
   /** @brief get the femtoseconds since the epoch */
-  femtosecs_t get_fs() const;
+  constexpr femtosecs_t get_fs() const
+  {
+    return _femtosecs;
+  }
 
   /** @brief get the year */
   int Year() const;
@@ -85,6 +183,9 @@ public:
   /** @brief get the days since the start of the year */
   int DayOfYear() const;
 
+  /** @brief get every calendar and clock field in a single pass */
+  civil_fields_t Fields() const;
+
   /** @brief Get the double precision seconds since epoch */
   long double SecondsSinceEpoch() const;
 
@@ -100,6 +201,22 @@ public:
   /** @brief convert time structure to a date string */
   std::string DateString() const;
 
+  /**
+   * @brief Write `ToString()` to `out`, which must have room for
+   * `time_string_capacity` characters, and return the end
+   */
+  char *FormatTo(char *out) const;
+
+  /** @brief Write the time in the given format to `out`, which must have
+   * room for `time_string_capacity` characters, and return the end */
+  char *FormatTo(char *out, const time_format_t &format) const;
+
+  /** @brief convert the time structure to a string in the given format */
+  std::string ToString(const time_format_t &format) const;
+
+  /** @brief Write `DateString()` to `out`, and return the end */
+  char *FormatDateTo(char *out) const;
+
   /** @brief Determine if the year is a leap year */
   bool IsLeapYear() const;
 
@@ -110,14 +227,14 @@ public:
   std::tuple<int, int, int> ToDate() const;
 
   /** @brief Convert a UTC time string to a gps_time_t */
-  static gps_time_t FromUTCString(const std::string& utc_time);
+  static gps_time_t FromUTCString(std::string_view utc_time);
 
   /** @brief Convert a GPS time string to a gps_time_t */
-  static gps_time_t FromGPSString(const std::string& gps_time);
+  static gps_time_t FromGPSString(std::string_view gps_time);
 
   // FIXME? Should this be a method on utc_time_t instead?
   /** @brief Convert an ISO-format UTC string to a gps_time_t */
-  static gps_time_t FromISOString(const std::string& utc_time);
+  static gps_time_t FromISOString(std::string_view utc_time);
 
   /** @brief Convert a gps_time_t to a UTC string */
   std::string ToUTCString() const;
@@ -135,35 +252,35 @@ public:
       UTC epoch) to a gps_time_t */
   static gps_time_t FromTimespec(struct timespec *ts);
 
-  bool operator==(const gps_time_t &other) const;
+  constexpr bool operator==(const gps_time_t &other) const = default;
 
-  bool operator!=(const gps_time_t &other) const;
+  constexpr auto operator<=>(const gps_time_t &other) const = default;
 
-  bool operator<(const gps_time_t &other) const;
+  constexpr gps_time_t operator+(const duration_t &other) const;
 
-  bool operator<=(const gps_time_t &other) const;
+  constexpr gps_time_t operator-(const duration_t &other) const;
 
-  bool operator>(const gps_time_t &other) const;
+  constexpr duration_t operator-(const gps_time_t &other) const;
 
-  bool operator>=(const gps_time_t &other) const;
-
-  gps_time_t operator+(const duration_t &other) const;
-
-  gps_time_t operator-(const duration_t &other) const;
-
-  duration_t operator-(const gps_time_t &other) const;
-
-  gps_time_t& operator+=(const duration_t &other);
+  constexpr gps_time_t& operator+=(const duration_t &other);
 
 private:
 
   femtosecs_t _femtosecs;
 };
 
+/** @brief The earliest femtosecond count a utc_time_t can hold */
+constexpr femtosecs_t utc_fs_min = -(femtosecs_t(1) << 126);
+
+/** @brief The latest femtosecond count a utc_time_t can hold */
+constexpr femtosecs_t utc_fs_max = (femtosecs_t(1) << 126) - 1 - fs_per_sec;
+
 /**
  * @class utc_time_t
  *
- * Provide a class for storing UTC times. Seconds should be <61.
+ * Provide a class for storing UTC times. Seconds should be <61. Times must
+ * be within 2^126 fs (about 10^15 years) of the UTC epoch, from `utc_fs_min`
+ * to `utc_fs_max`; the constructors throw `std::runtime_error` otherwise.
  */
 class utc_time_t
 {
@@ -176,27 +293,42 @@ public:
   utc_time_t(int y, int mon, int d, int h, int min, long double s);
 
   /** @brief Default constructor */
-  explicit utc_time_t(femtosecs_t femtos = 0) : _femtosecs(femtos), _leap(false)
+  explicit constexpr utc_time_t(femtosecs_t femtos = 0)
+    : _key(to_key(femtos, false))
   {}
 
   /** @brief Constructor with leap seconds */
-  utc_time_t(femtosecs_t femtos, bool leap) : _femtosecs(femtos), _leap(leap)
+  constexpr utc_time_t(femtosecs_t femtos, bool leap)
+    : _key(to_key(femtos, leap))
   {}
 
+  /** @brief Constructor from broken-down fields (second 60 is a leap second) */
+  explicit utc_time_t(const civil_fields_t &fields);
+
   /** @brief The UTC times of leap seconds */
-  static std::vector<utc_time_t> leap_seconds;
+  static const std::array<utc_time_t, leap_second_count> leap_seconds;
 
   /** @brief The GPS epoch, as a UTC time */
-  static utc_time_t gps_epoch;
+  static const utc_time_t gps_epoch;
 
   /** @brief The UTC epoch */
-  static utc_time_t utc_epoch;
-
-  /** @brief The number of femtoseconds elapsed since the UTC epoch */
-  femtosecs_t get_fs() const;
+  static const utc_time_t utc_epoch;
+
+  /** @brief The number of femtoseconds elapsed since the UTC epoch
+   *
+   * Note that this excludes elapsed leap seconds, for a better means of
+   * measuring duration, use gps_time_t.
+   */
+  constexpr femtosecs_t get_fs() const
+  {
+    return (_key >> 1) - (_key & 1) * fs_per_sec;
+  }
 
   /** @brief If the time is during a leap second */
-  bool is_leap() const;
+  constexpr bool is_leap() const
+  {
+    return _key & 1;
+  }
 
   /** @brief get the year */
   int Year() const;
@@ -225,6 +357,9 @@ public:
   /** @brief get the days since the start of the year */
   int DayOfYear() const;
 
+  /** @brief get every calendar and clock field in a single pass */
+  civil_fields_t Fields() const;
+
   /** @brief convert to gps_time_t */
   gps_time_t ToGPS() const;
 
@@ -234,16 +369,27 @@ public:
   /** @brief convert time structure to a date string */
   std::string DateString() const;
 
+  /**
+   * @brief Write `ToString()` to `out`, which must have room for
+   * `time_string_capacity` characters, and return the end
+   */
+  char *FormatTo(char *out) const;
+
+  /** @brief Write the time in the given format to `out`, which must have
+   * room for `time_string_capacity` characters, and return the end */
+  char *FormatTo(char *out, const time_format_t &format) const;
+
+  /** @brief convert the time structure to a string in the given format */
+  std::string ToString(const time_format_t &format) const;
+
+  /** @brief Write `DateString()` to `out`, and return the end */
+  char *FormatDateTo(char *out) const;
+
   /** @brief Get the date portion of the time */
   std::tuple<int, int, int> ToDate() const;
 
-  bool operator ==(const utc_time_t &other) const;
-  bool operator !=(const utc_time_t &other) const;
-
-  bool operator <(const utc_time_t &other) const;
-  bool operator <=(const utc_time_t &other) const;
-  bool operator >(const utc_time_t &other) const;
-  bool operator >=(const utc_time_t &other) const;
+  constexpr bool operator==(const utc_time_t &other) const = default;
+  constexpr auto operator<=>(const utc_time_t &other) const = default;
 
 private:
   // A quick note on the representation of leap seconds:
@@ -254,12 +400,25 @@ private:
   // internally). This allows us to reuse much of the conversion machinery from
   // `gps_time_t`, because leap seconds are ignored there as well. Because leap
   // seconds need to be represented, they are stored as the *previous* second,
-  // with `_leap = true`. While this would complicate duration calculations,
+  // with the leap flag set. While this would complicate duration calculations,
   // that is not implemented in this class, so it is not something we need to
-  // worry about. However, care should be taken when editing the comparison
-  // methods (which are needed for `FromUTC`).
-  femtosecs_t _femtosecs;
-  bool _leap;
+  // worry about.
+  //
+  // Both are packed into one count, `_key`: twice the femtoseconds, counting
+  // a leap second as the second after it, plus the leap flag. Comparing keys
+  // orders times by `get_fs()` (plus a second during a leap second), which
+  // is what `FromUTC` needs, with a leap second after the non-leap time it
+  // coincides with; it also keeps the type at 16 bytes rather than 32.
+  femtosecs_t _key;
+
+  /** @brief The key of a time, or throw if it is out of range */
+  static constexpr femtosecs_t to_key(femtosecs_t femtos, bool leap)
+  {
+    if (femtos < utc_fs_min || femtos > utc_fs_max) [[unlikely]] {
+      throw_runtime_error("utc_time_t: time out of range");
+    }
+    return (femtos + leap * fs_per_sec) * 2 + leap;
+  }
 };
 
 /**
@@ -270,11 +429,14 @@ private:
 class duration_t
 {
 public:
-  duration_t(femtosecs_t femtos) : _femtosecs(femtos)
+  constexpr duration_t(femtosecs_t femtos) : _femtosecs(femtos)
   {;}
 
   /** @brief The total number of femtoseconds in the duration */
-  femtosecs_t get_fs() const;
+  constexpr femtosecs_t get_fs() const
+  {
+    return _femtosecs;
+  }
 
   /** @brief The number of complete days (86400 seconds) */
   long total_days() const;
@@ -312,11 +474,27 @@ public:
   /** @brief The total number of seconds elapsed, including partial secs */
   long double f_seconds() const;
 
+  /**
+   * @brief Write the exact number of seconds, as `[-]S.fffffffffffffffs`, to
+   * `out`, which must have room for `time_string_capacity` characters, and
+   * return the end
+   */
+  char *FormatTo(char *out) const;
+
+  /** @brief The same, with the given number of digits after the `.` */
+  char *FormatTo(char *out, time_precision_t precision) const;
+
   /** @brief Returns the additive inverse of the duration */
-  duration_t invert_sign() const;
+  constexpr duration_t invert_sign() const
+  {
+    return duration_t(-_femtosecs);
+  }
 
   /** @brief Returns if the duration is negative */
-  bool is_negative() const;
+  constexpr bool is_negative() const
+  {
+    return _femtosecs < 0;
+  }
 
   /** @brief Constructs a duration from an integer number of years */
   static duration_t from_years(int years);
@@ -357,29 +535,105 @@ public:
   /** @brief Constructs a duration from a POSIX timespec */
   static duration_t from_timespec(struct timespec *ts);
 
-  bool operator<(const duration_t &other) const;
-  bool operator<=(const duration_t &other) const;
-  bool operator>(const duration_t &other) const;
-  bool operator>=(const duration_t &other) const;
-  bool operator==(const duration_t &other) const;
-  bool operator!=(const duration_t &other) const;
+  constexpr bool operator==(const duration_t &other) const = default;
+  constexpr auto operator<=>(const duration_t &other) const = default;
+
+  constexpr duration_t operator+(const duration_t &other) const
+  {
+    return duration_t(_femtosecs + other._femtosecs);
+  }
+
+  constexpr duration_t operator-(const duration_t &other) const
+  {
+    return duration_t(_femtosecs - other._femtosecs);
+  }
 
-  duration_t operator+(const duration_t &other) const;
-  duration_t operator-(const duration_t &other) const;
   duration_t operator*(double other) const;
-  duration_t operator*(femtosecs_t other) const;
+
+  constexpr duration_t operator*(femtosecs_t other) const
+  {
+    return duration_t(_femtosecs * other);
+  }
+
   duration_t operator/(double other) const;
-  duration_t operator/(femtosecs_t other) const;
+
+  constexpr duration_t operator/(femtosecs_t other) const
+  {
+    return duration_t(_femtosecs / other);
+  }
 
 private:
   femtosecs_t _femtosecs;
 };
 
+constexpr gps_time_t gps_time_t::operator+(const duration_t &other) const
+{
+  return gps_time_t(_femtosecs + other.get_fs());
+}
+
+constexpr gps_time_t gps_time_t::operator-(const duration_t &other) const
+{
+  return gps_time_t(_femtosecs - other.get_fs());
+}
+
+constexpr duration_t gps_time_t::operator-(const gps_time_t &other) const
+{
+  return duration_t(_femtosecs - other._femtosecs);
+}
+
+constexpr gps_time_t& gps_time_t::operator+=(const duration_t &other)
+{
+  _femtosecs += other.get_fs();
+  return *this;
+}
+
+/**
+ * @brief The times (in GPS) that a leap second was added to UTC time.
+ *
+ * This keeps the time in GPS, not UTC. If you need UTC times, use
+ * `utc_time_t::leap_seconds` instead. Both are generated from
+ * `leap_second_dates`; the conversions use `CurrentLeapTable()`, which may
+ * have been loaded at runtime.
+ */
+inline constexpr std::array<gps_time_t, leap_second_count>
+gps_time_t::leap_seconds = [] {
+  std::array<gps_time_t, leap_second_count> table;
+  for (std::size_t i = 0; i < leap_second_count; i++) {
+    table[i] = gps_time_t(gps_leap_fs[i]);
+  }
+  return table;
+}();
+
+/** @brief The UTC times of every leap second (23:59:60) */
+inline constexpr std::array<utc_time_t, leap_second_count>
+utc_time_t::leap_seconds = [] {
+  std::array<utc_time_t, leap_second_count> table;
+  for (std::size_t i = 0; i < leap_second_count; i++) {
+    table[i] = utc_time_t(utc_leap_fs[i], true);
+  }
+  return table;
+}();
+
+/** @brief The GPS epoch on Jan. 6, 1980 at midnight */
+inline constexpr gps_time_t gps_time_t::gps_epoch = gps_time_t(0);
+
+/** @brief The UTC epoch on Jan. 1, 1970 at midnight */
+inline constexpr gps_time_t gps_time_t::utc_epoch = gps_time_t(
+  -leaps_before_gps_epoch * fs_per_sec - utc_gps_epoch_offset
+);
+
+/** @brief The GPS epoch on Jan. 6, 1980 at midnight */
+inline constexpr utc_time_t utc_time_t::gps_epoch =
+  utc_time_t(utc_gps_epoch_offset);
+
+/** @brief The UTC epoch on Jan. 1, 1970 at midnight */
+inline constexpr utc_time_t utc_time_t::utc_epoch = utc_time_t(0);
+
 /** @brief Convert a UTC time string to a gps_time_t */
-gps_time_t FromUTCString(const std::string& utc_time);
+gps_time_t FromUTCString(std::string_view utc_time);
 
 /** @brief Convert a UTC time string to a gps_time_t */
-gps_time_t FromGPSString(const std::string& utc_time);
+gps_time_t FromGPSString(std::string_view gps_time);
 
 /** @brief Convert a gps_time_t to a UTC string */
 std::string ToUTCString(const gps_time_t &gps_time);
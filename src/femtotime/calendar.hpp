@@ -0,0 +1,140 @@
+/**
+ * @file calendar.hpp
+ * @brief Constexpr proleptic Gregorian calendar core
+ * @date 16 Oct 2026
+ *
+ * These routines convert between day counts and year-month-day triples
+ * without loops or data-dependent branches. They follow the "computational
+ * calendar" construction of Neri and Schneider (2022): years start on March 1
+ * so the leap day is always the last day of the year, and the month/day of a
+ * day-of-year are recovered with a single multiply and shift.
+ */
+#pragma once
+
+// [C++ headers]
+#include <array>
+#include <cstdint>
+#include <tuple>
+
+// [Namespaces]
+namespace femtotime {
+
+/** @brief Days between the GPS epoch (1980-01-06) and Mar. 1, 2000 */
+constexpr int64_t gps_y2000_epoch = 7360;
+
+/** @brief Days between the UTC epoch (1970-01-01) and Mar. 1, 2000 */
+constexpr int64_t utc_y2000_epoch = 11017;
+
+/** @brief Days between the modified Julian epoch (1858-11-17) and Mar. 1, 2000 */
+constexpr int64_t mjd_y2000_epoch = 51604;
+
+constexpr int64_t days_per_400_years = 146097;
+constexpr int64_t days_per_100_years = 36524;
+constexpr int64_t days_per_4_years = 1461;
+
+/**
+ * @brief The number of 400-year eras the computational calendar is shifted by.
+ *
+ * All of the arithmetic below is done on unsigned day counts, so day zero is
+ * moved this many eras before Mar. 1, 2000. 400 times this is larger than
+ * `INT32_MAX`, so every year that fits in an `int` is representable.
+ */
+constexpr uint64_t calendar_era_shift = 5'368'710;
+
+/**
+ * @brief Determine if the (proleptic Gregorian) year is a leap year
+ */
+constexpr bool is_leap_year(int64_t year)
+{
+  return (year % 4 == 0) & ((year % 100 != 0) | (year % 400 == 0));
+}
+
+/**
+ * @brief Converts a day count to a year-month-day triple.
+ *
+ * The second parameter, `y2000_epoch`, is the number of days between the epoch
+ * of `total_days` and Mar. 1, 2000. The returned triple is in proleptic
+ * Gregorian format; there is no support for conversion to Julian dates for
+ * dates before 1752.
+ */
+constexpr std::tuple<int, int, int>
+civil_from_days(int64_t total_days, int64_t y2000_epoch)
+{
+  // Shift so that day zero is Mar. 1 of a year divisible by 400 far enough in
+  // the past that the count is never negative.
+  constexpr uint64_t shift = days_per_400_years * calendar_era_shift;
+  uint64_t n = static_cast<uint64_t>(total_days - y2000_epoch) + shift;
+
+  // Century and day of century. Multiplying by 4 first folds the quarter-day
+  // per century that the 400-year leap rule adds into an integer division.
+  uint64_t n1 = 4 * n + 3;
+  uint64_t century = n1 / days_per_400_years;
+  uint64_t day_of_century = (n1 % days_per_400_years) / 4;
+
+  // Year of century and day of year. 2939745 / 2^32 approximates 4 / 1461
+  // closely enough that the quotient and remainder come out of one product.
+  uint64_t n2 = 4 * day_of_century + 3;
+  uint64_t p2 = uint64_t{2939745} * n2;
+  uint64_t year_of_century = p2 >> 32;
+  uint64_t day_of_year = static_cast<uint32_t>(p2) / 2939745 / 4;
+
+  // Month and day of month, again from a single product: 2141 / 2^16 is the
+  // average month length (30.6 days) scaled so that March is month 3.
+  uint64_t n3 = 2141 * day_of_year + 197913;
+  int month = static_cast<int>(n3 >> 16);
+  int day = static_cast<int>((n3 & 0xFFFF) / 2141);
+
+  // January and February belong to the following civil year
+  int after_dec = day_of_year >= 306;
+  int64_t year = static_cast<int64_t>(100 * century + year_of_century)
+    - static_cast<int64_t>(400 * calendar_era_shift) + 2000 + after_dec;
+  return {static_cast<int>(year), month - 12 * after_dec, day + 1};
+}
+
+/**
+ * @brief Converts a year-month-day triple to a day count.
+ *
+ * The fourth parameter, `y2000_epoch`, is the number of days between the
+ * desired epoch and Mar. 1, 2000. The year-month-day triple is in proleptic
+ * Gregorian format; there is no support for conversion to the Julian calendar
+ * for dates before 1752.
+ */
+constexpr int64_t
+days_from_civil(int64_t year, int month, int day, int64_t y2000_epoch)
+{
+  // Early months are part of the previous computational year, which puts the
+  // leap day at the very end of the year.
+  int before_mar = month <= 2;
+  uint64_t y = static_cast<uint64_t>(year - 2000 - before_mar)
+    + 400 * calendar_era_shift;
+  uint64_t m = static_cast<uint64_t>(month + 12 * before_mar);
+  uint64_t century = y / 100;
+  uint64_t day_of_era = 1461 * y / 4 - century + century / 4;
+  // (979 * m - 2919) / 32 is the number of days from Mar. 1 to the first of
+  // month m, for m in [3, 14]
+  uint64_t day_of_year = (979 * m - 2919) / 32 + static_cast<uint64_t>(day - 1);
+  constexpr uint64_t shift = days_per_400_years * calendar_era_shift;
+  return static_cast<int64_t>(day_of_era + day_of_year - shift) + y2000_epoch;
+}
+
+/**
+ * @brief Convert a day/month/year in Gregorian format to the number of days
+ * since the start of the given year (0-indexed).
+ */
+constexpr int civil_day_of_year(int64_t year, int month, int day)
+{
+  constexpr std::array<int, 12> days_before_month = {
+    0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334
+  };
+  return days_before_month[month - 1] + ((month > 2) & is_leap_year(year))
+    + day - 1;
+}
+
+static_assert(civil_from_days(0, gps_y2000_epoch)
+              == std::tuple<int, int, int>(1980, 1, 6));
+static_assert(civil_from_days(0, utc_y2000_epoch)
+              == std::tuple<int, int, int>(1970, 1, 1));
+static_assert(days_from_civil(2000, 3, 1, 0) == 0);
+static_assert(days_from_civil(1970, 1, 1, utc_y2000_epoch) == 0);
+
+} /** namespace femtotime */
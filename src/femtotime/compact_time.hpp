@@ -0,0 +1,493 @@
+/**
+ * @file compact_time.hpp
+ * @brief Narrow (usually 64-bit) times and durations
+ * @date 16 Oct 2026
+ *
+ * A gps_time_t is 16 bytes so that it can hold any femtosecond for longer
+ * than the age of the universe, but a buffer of samples rarely needs that.
+ * `basic_gps_time<Rep, Period>` counts ticks of `Period` seconds (a
+ * `std::ratio`, as in `std::chrono`) since the GPS epoch in a `Rep`, and
+ * `basic_duration<Rep, Period>` counts ticks of a duration. With `int64_t`
+ * nanoseconds a time is 8 bytes and covers 1688 to 2272; with `int64_t`
+ * femtoseconds a duration covers 2.5 hours either way, enough for offsets
+ * from a per-block base time.
+ *
+ * Converting to the wide types is always exact. Converting from them is
+ * checked: `Check` says whether a value fits, `FromGPS` and `FromDuration`
+ * throw `std::runtime_error` unless it fits exactly, and `FloorGPS` and
+ * `FloorDuration` round down to a tick and throw only if it's out of range.
+ *
+ * The calendar fields, and so the formatting, of a 64-bit time are worked
+ * out in 64-bit arithmetic, without going through a gps_time_t.
+ */
+#pragma once
+
+// [C++ headers]
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <span>
+#include <string>
+#include <type_traits>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/calendar.hpp"
+#include "femtotime/time_constants.hpp"
+#include "femtotime/time_format.hpp"
+#include "femtotime/time_split.hpp"
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+namespace femtotime {
+
+/** @brief Whether a wide value fits a compact type */
+enum class compact_check_t
+{
+  /** @brief It is a whole number of ticks within range */
+  exact,
+
+  /** @brief It is within range but not a whole number of ticks */
+  inexact,
+
+  /** @brief It is too far from zero (or the epoch) */
+  out_of_range,
+};
+
+/** @brief The femtoseconds in a tick of `Period` seconds */
+template <typename Period>
+constexpr femtosecs_t period_fs()
+{
+  static_assert(Period::num > 0 && fs_per_sec * Period::num % Period::den == 0,
+                "a tick must be a whole number of femtoseconds");
+  return fs_per_sec * Period::num / Period::den;
+}
+
+/** @brief The fewest fraction digits that show every tick exactly */
+constexpr time_precision_t tick_precision(femtosecs_t fs_per_tick)
+{
+  femtosecs_t unit = fs_per_sec;
+  int digits = 0;
+  while (fs_per_tick % unit != 0) {
+    unit /= 1000;
+    digits += 3;
+  }
+  return static_cast<time_precision_t>(digits);
+}
+
+/** @brief Check that `fs` is a whole number of ticks that fits in `Rep` */
+template <typename Rep>
+constexpr compact_check_t check_ticks(femtosecs_t fs, femtosecs_t fs_per_tick)
+{
+  auto ticks = fs / fs_per_tick;
+  auto floor = ticks - (fs % fs_per_tick < 0);
+  if (floor < std::numeric_limits<Rep>::min()
+      || floor > std::numeric_limits<Rep>::max()) {
+    return compact_check_t::out_of_range;
+  }
+  return fs % fs_per_tick == 0 ? compact_check_t::exact
+                               : compact_check_t::inexact;
+}
+
+/** @brief The ticks of `fs`, rounded down, or throw if out of range */
+template <typename Rep>
+Rep floor_ticks(femtosecs_t fs, femtosecs_t fs_per_tick, bool exact,
+                const char *function)
+{
+  auto check = check_ticks<Rep>(fs, fs_per_tick);
+  if (check == compact_check_t::out_of_range
+      || (exact && check == compact_check_t::inexact)) {
+    auto msg = fmt::format("{}: {} fs is {} ticks of {} fs", function, fs,
+                           check == compact_check_t::out_of_range
+                             ? "out of range for" : "not a whole number of",
+                           fs_per_tick);
+    throw_runtime_error(msg.c_str());
+  }
+  return static_cast<Rep>(fs / fs_per_tick - (fs % fs_per_tick < 0));
+}
+
+/**
+ * @class basic_duration
+ *
+ * A duration of a whole number of ticks of `Period` seconds, stored in a
+ * signed integer `Rep`.
+ */
+template <typename Rep, typename Period>
+class basic_duration
+{
+  static_assert(std::is_integral_v<Rep> && std::is_signed_v<Rep>,
+                "the representation must be a signed integer");
+
+public:
+  using rep = Rep;
+  using period = Period;
+
+  /** @brief The femtoseconds in a tick */
+  static constexpr femtosecs_t fs_per_tick = period_fs<Period>();
+
+  static_assert(fs_per_tick <= std::numeric_limits<femtosecs_t>::max()
+                / std::numeric_limits<Rep>::max(),
+                "every count must fit in a femtosecs_t");
+
+  /** @brief The precision `FormatTo` writes unless told otherwise */
+  static constexpr time_precision_t default_precision =
+    tick_precision(fs_per_tick);
+
+  /** @brief Zero */
+  constexpr basic_duration() = default;
+
+  /** @brief A duration of `ticks` ticks */
+  explicit constexpr basic_duration(Rep ticks) : _ticks(ticks)
+  {}
+
+  /** @brief The number of ticks */
+  constexpr Rep count() const
+  {
+    return _ticks;
+  }
+
+  /** @brief The number of femtoseconds */
+  constexpr femtosecs_t get_fs() const
+  {
+    return _ticks * fs_per_tick;
+  }
+
+  /** @brief The same duration as a duration_t */
+  constexpr duration_t ToDuration() const
+  {
+    return duration_t(get_fs());
+  }
+
+  /** @brief Whether a duration is a whole number of ticks within range */
+  static constexpr compact_check_t Check(const duration_t &duration)
+  {
+    return check_ticks<Rep>(duration.get_fs(), fs_per_tick);
+  }
+
+  /**
+   * @brief The same duration; throws `std::runtime_error` unless it is a
+   * whole number of ticks within range
+   */
+  static basic_duration FromDuration(const duration_t &duration)
+  {
+    return basic_duration(floor_ticks<Rep>(duration.get_fs(), fs_per_tick,
+                                           true, "FromDuration"));
+  }
+
+  /**
+   * @brief The duration rounded down to a whole number of ticks; throws
+   * `std::runtime_error` if that is out of range
+   */
+  static basic_duration FloorDuration(const duration_t &duration)
+  {
+    return basic_duration(floor_ticks<Rep>(duration.get_fs(), fs_per_tick,
+                                           false, "FloorDuration"));
+  }
+
+  /** @brief Write the seconds, as `duration_t::FormatTo` does */
+  char *FormatTo(char *out, time_precision_t precision = default_precision)
+    const
+  {
+    return ToDuration().FormatTo(out, precision);
+  }
+
+  constexpr bool operator==(const basic_duration &other) const = default;
+  constexpr auto operator<=>(const basic_duration &other) const = default;
+
+  constexpr basic_duration operator+(const basic_duration &other) const
+  {
+    return basic_duration(_ticks + other._ticks);
+  }
+
+  constexpr basic_duration operator-(const basic_duration &other) const
+  {
+    return basic_duration(_ticks - other._ticks);
+  }
+
+private:
+  Rep _ticks = 0;
+};
+
+/**
+ * @class basic_gps_time
+ *
+ * A GPS time that is a whole number of ticks of `Period` seconds since the
+ * GPS epoch, stored in a signed integer `Rep`.
+ */
+template <typename Rep, typename Period>
+class basic_gps_time
+{
+public:
+  using rep = Rep;
+  using period = Period;
+  using duration = basic_duration<Rep, Period>;
+
+  /** @brief The femtoseconds in a tick */
+  static constexpr femtosecs_t fs_per_tick = duration::fs_per_tick;
+
+  /** @brief The format `ToString()` writes: GPS style, to the tick */
+  static constexpr time_format_t default_format = {
+    time_style_t::gps, duration::default_precision};
+
+  /** @brief The GPS epoch */
+  constexpr basic_gps_time() = default;
+
+  /** @brief The time `ticks` ticks after the GPS epoch */
+  explicit constexpr basic_gps_time(Rep ticks) : _ticks(ticks)
+  {}
+
+  /** @brief The number of ticks since the GPS epoch */
+  constexpr Rep count() const
+  {
+    return _ticks;
+  }
+
+  /** @brief The number of femtoseconds since the GPS epoch */
+  constexpr femtosecs_t get_fs() const
+  {
+    return _ticks * fs_per_tick;
+  }
+
+  /** @brief The same time as a gps_time_t */
+  constexpr gps_time_t ToGPS() const
+  {
+    return gps_time_t(get_fs());
+  }
+
+  /** @brief Whether a time is a whole number of ticks within range */
+  static constexpr compact_check_t Check(const gps_time_t &time)
+  {
+    return check_ticks<Rep>(time.get_fs(), fs_per_tick);
+  }
+
+  /**
+   * @brief The same time; throws `std::runtime_error` unless it is a whole
+   * number of ticks within range
+   */
+  static basic_gps_time FromGPS(const gps_time_t &time)
+  {
+    return basic_gps_time(floor_ticks<Rep>(time.get_fs(), fs_per_tick, true,
+                                           "FromGPS"));
+  }
+
+  /**
+   * @brief The time rounded down to a whole number of ticks; throws
+   * `std::runtime_error` if that is out of range
+   */
+  static basic_gps_time FloorGPS(const gps_time_t &time)
+  {
+    return basic_gps_time(floor_ticks<Rep>(time.get_fs(), fs_per_tick, false,
+                                           "FloorGPS"));
+  }
+
+  /** @brief Every calendar and clock field in a single pass */
+  constexpr civil_fields_t Fields() const
+  {
+    constexpr bool narrow = sizeof(Rep) <= sizeof(int64_t)
+      && fs_per_sec % fs_per_tick == 0;
+    if constexpr (!narrow) {
+      return ToGPS().Fields();
+    } else {
+      constexpr int64_t ticks_per_sec = fs_per_sec / fs_per_tick;
+      auto [secs, subsec] = euclidean_div(_ticks, ticks_per_sec);
+      auto [days, sec_of_day] = euclidean_div(secs, secs_per_day_64);
+      int64_t subsec_fs = subsec * static_cast<int64_t>(fs_per_tick);
+      auto [year, month, day] = civil_from_days(days, gps_y2000_epoch);
+      civil_fields_t fields;
+      fields.year = year;
+      fields.month = month;
+      fields.day = day;
+      fields.hour = sec_of_day / secs_per_hour_64;
+      fields.minute = sec_of_day / sec_per_min_64 % 60;
+      fields.second = sec_of_day % sec_per_min_64;
+      fields.nanosecond = subsec_fs / fs_per_ns_64;
+      fields.femtosecond = subsec_fs % fs_per_ns_64;
+      fields.day_of_year = civil_day_of_year(year, month, day) + 1;
+      return fields;
+    }
+  }
+
+  /** @brief get the year */
+  int Year() const
+  {
+    return Fields().year;
+  }
+
+  /** @brief get the month */
+  int Month() const
+  {
+    return Fields().month;
+  }
+
+  /** @brief get the day */
+  int Day() const
+  {
+    return Fields().day;
+  }
+
+  /** @brief get the hour */
+  int Hour() const
+  {
+    return Fields().hour;
+  }
+
+  /** @brief get the minute */
+  int Minute() const
+  {
+    return Fields().minute;
+  }
+
+  /** @brief get the integer part of the seconds */
+  int WholeSeconds() const
+  {
+    return Fields().second;
+  }
+
+  /** @brief get the nanoseconds */
+  int Nanoseconds() const
+  {
+    return Fields().nanosecond;
+  }
+
+  /** @brief get the days since the start of the year */
+  int DayOfYear() const
+  {
+    return Fields().day_of_year;
+  }
+
+  /** @brief convert to utc_time_t */
+  utc_time_t ToUTC() const
+  {
+    return ToGPS().ToUTC();
+  }
+
+  /**
+   * @brief Write the time in the given format to `out`, which must have
+   * room for `time_string_capacity` characters, and return the end
+   */
+  char *FormatTo(char *out, const time_format_t &format = default_format)
+    const
+  {
+    return write_time(out, Fields(), format);
+  }
+
+  /** @brief convert the time to a string in the given format */
+  std::string ToString(const time_format_t &format = default_format) const
+  {
+    char buffer[time_string_capacity];
+    return std::string(buffer, FormatTo(buffer, format));
+  }
+
+  constexpr bool operator==(const basic_gps_time &other) const = default;
+  constexpr auto operator<=>(const basic_gps_time &other) const = default;
+
+  constexpr basic_gps_time operator+(const duration &other) const
+  {
+    return basic_gps_time(_ticks + other.count());
+  }
+
+  constexpr basic_gps_time operator-(const duration &other) const
+  {
+    return basic_gps_time(_ticks - other.count());
+  }
+
+  constexpr duration operator-(const basic_gps_time &other) const
+  {
+    return duration(_ticks - other._ticks);
+  }
+
+private:
+  Rep _ticks = 0;
+};
+
+/** @brief Nanoseconds since the GPS epoch (1688 to 2272) */
+using gps_time_ns_t = basic_gps_time<int64_t, std::nano>;
+
+/** @brief Microseconds since the GPS epoch */
+using gps_time_us_t = basic_gps_time<int64_t, std::micro>;
+
+/** @brief Nanoseconds (up to 292 years) */
+using duration_ns_t = basic_duration<int64_t, std::nano>;
+
+/** @brief Femtoseconds (up to 2.5 hours), for offsets from a base time */
+using duration_fs_t = basic_duration<int64_t, std::femto>;
+
+/** @brief Widen a span of compact times into `out`, which must be as long */
+template <typename Rep, typename Period>
+void ToGPS(std::span<const basic_gps_time<Rep, Period>> times,
+           std::span<gps_time_t> out)
+{
+  if (out.size() < times.size()) {
+    auto msg = fmt::format("ToGPS: {} times but room for {}", times.size(),
+                           out.size());
+    throw_runtime_error(msg.c_str());
+  }
+  for (std::size_t i = 0; i < times.size(); i++) {
+    out[i] = times[i].ToGPS();
+  }
+}
+
+/**
+ * @brief Narrow a span of times into `out`, which must be as long; throws
+ * `std::runtime_error`, naming the first, if any isn't a whole number of
+ * ticks within range
+ */
+template <typename Rep, typename Period>
+void FromGPS(std::span<const gps_time_t> times,
+             std::span<basic_gps_time<Rep, Period>> out)
+{
+  using compact_t = basic_gps_time<Rep, Period>;
+  if (out.size() < times.size()) {
+    auto msg = fmt::format("FromGPS: {} times but room for {}", times.size(),
+                           out.size());
+    throw_runtime_error(msg.c_str());
+  }
+  // Find out which time doesn't fit only if one doesn't
+  bool exact = true;
+  for (std::size_t i = 0; i < times.size(); i++) {
+    auto fs = times[i].get_fs();
+    exact &= compact_t::Check(times[i]) == compact_check_t::exact;
+    out[i] = compact_t(static_cast<Rep>(fs / compact_t::fs_per_tick));
+  }
+  if (!exact) {
+    for (std::size_t i = 0; i < times.size(); i++) {
+      if (compact_t::Check(times[i]) != compact_check_t::exact) {
+        auto msg = fmt::format("FromGPS: time {} ({}) doesn't fit", i,
+                               times[i].ToString());
+        throw_runtime_error(msg.c_str());
+      }
+    }
+  }
+}
+
+} /** namespace femtotime */
+
+template <typename Rep, typename Period>
+struct fmt::formatter<femtotime::basic_gps_time<Rep, Period>>
+  : femtotime::time_formatter_t<femtotime::basic_gps_time<Rep, Period>>
+{
+  constexpr formatter()
+  {
+    this->spec = femtotime::basic_gps_time<Rep, Period>::default_format;
+  }
+};
+
+template <typename Rep, typename Period>
+struct fmt::formatter<femtotime::basic_duration<Rep, Period>>
+  : femtotime::time_formatter_t<femtotime::duration_t>
+{
+  constexpr formatter()
+  {
+    spec.precision = femtotime::basic_duration<Rep, Period>::default_precision;
+  }
+
+  template <typename FormatContext>
+  auto format(const femtotime::basic_duration<Rep, Period> &duration,
+              FormatContext &ctx) const
+  {
+    return time_formatter_t::format(duration.ToDuration(), ctx);
+  }
+};
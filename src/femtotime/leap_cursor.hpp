@@ -0,0 +1,143 @@
+/**
+ * @file leap_cursor.hpp
+ * @brief Converting sorted sequences of times between GPS and UTC
+ * @date 16 Oct 2026
+ *
+ * Consecutive samples of a time series almost always fall between the same
+ * two leap seconds. `leap_cursor_t` remembers the bounds and offset of the
+ * last segment it converted in, so the common case is two comparisons and an
+ * add; it only goes back to the leap-second table when a time leaves the
+ * segment (in either direction).
+ */
+#pragma once
+
+// [C++ headers]
+#include <cstddef>
+#include <limits>
+#include <span>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/leap_seconds.hpp"
+
+// [Namespaces]
+namespace femtotime {
+
+/**
+ * @class leap_cursor_t
+ *
+ * A stateful GPS/UTC converter that gives the same results as
+ * `gps_time_t::ToUTC()` and `gps_time_t::FromUTC()`, including for times
+ * within a leap second.
+ *
+ * The cursor uses the leap-second table that was current when it was made,
+ * so a batch is converted consistently even if a new table is published
+ * part-way through. It is not thread-safe; use one cursor per thread.
+ */
+class leap_cursor_t
+{
+public:
+  /** @brief A cursor over the current leap-second table */
+  leap_cursor_t() : leap_cursor_t(CurrentLeapTable())
+  {}
+
+  /** @brief A cursor over the given table, which must outlive the cursor */
+  explicit leap_cursor_t(const leap_table_t &table) : _table(&table)
+  {}
+
+  /** @brief Convert a gps_time_t to a utc_time_t */
+  utc_time_t ToUTC(const gps_time_t &gps_time)
+  {
+    auto fs = gps_time.get_fs();
+    if (fs < _gps.begin || fs >= _gps.end) {
+      SeekGPS(fs);
+    }
+    return utc_time_t(fs + _gps.shift, fs < _gps.leap_end);
+  }
+
+  /** @brief Convert a utc_time_t to a gps_time_t */
+  gps_time_t FromUTC(const utc_time_t &utc_time)
+  {
+    return gps_time_t(utc_time.get_fs() + UTCSegment(utc_time).shift);
+  }
+
+  /**
+   * @brief The number of leap seconds elapsed between the GPS epoch and a UTC
+   * time (negative before the epoch), counting a leap second as elapsed
+   * during itself.
+   */
+  std::ptrdiff_t Elapsed(const utc_time_t &utc_time)
+  {
+    UTCSegment(utc_time);
+    return _utc_elapsed;
+  }
+
+private:
+  /**
+   * @struct segment_t
+   *
+   * The times [begin, end) between two leap seconds, in one time scale.
+   */
+  struct segment_t
+  {
+    femtosecs_t begin = std::numeric_limits<femtosecs_t>::max();
+    femtosecs_t end = std::numeric_limits<femtosecs_t>::min();
+
+    /** @brief Times before this are within the leap second at `begin` */
+    femtosecs_t leap_end = std::numeric_limits<femtosecs_t>::min();
+
+    /** @brief The offset to the other time scale */
+    femtosecs_t shift = 0;
+  };
+
+  /**
+   * @brief The UTC segment holding a time. UTC times are keyed by their
+   * femtoseconds plus a second during a leap second (see `leap_table_t`).
+   */
+  const segment_t &UTCSegment(const utc_time_t &utc_time)
+  {
+    auto key = utc_time.get_fs() + utc_time.is_leap() * fs_per_sec;
+    if (key < _utc.begin || key >= _utc.end) {
+      SeekUTC(key);
+    }
+    return _utc;
+  }
+
+  void SeekGPS(femtosecs_t fs);
+  void SeekUTC(femtosecs_t key);
+
+  const leap_table_t *_table;
+  segment_t _gps;
+  segment_t _utc;
+  std::ptrdiff_t _utc_elapsed = 0;
+};
+
+/**
+ * @brief Convert a span of gps_time_t to UTC; fastest when `gps_times` is
+ * sorted.
+ *
+ * Throws `std::runtime_error` if the spans differ in size.
+ */
+void ToUTC(std::span<const gps_time_t> gps_times,
+           std::span<utc_time_t> utc_times);
+
+/**
+ * @brief Convert a span of utc_time_t to GPS; fastest when `utc_times` is
+ * sorted.
+ *
+ * Throws `std::runtime_error` if the spans differ in size.
+ */
+void FromUTC(std::span<const utc_time_t> utc_times,
+             std::span<gps_time_t> gps_times);
+
+/**
+ * @brief The leap seconds elapsed between each pair of `times1[i]` and
+ * `times2[i]`; fastest when both are sorted.
+ *
+ * Throws `std::runtime_error` if the spans differ in size.
+ */
+void LeapSecondsBetween(std::span<const utc_time_t> times1,
+                        std::span<const utc_time_t> times2,
+                        std::span<int> leap_seconds);
+
+} /** namespace femtotime */
@@ -0,0 +1,399 @@
+/**
+ * @file leap_seconds.hpp
+ * @brief Compile-time leap-second tables and their constant-time lookup
+ * @date 16 Oct 2026
+ *
+ * The leap seconds are listed once, as the UTC dates whose last minute had a
+ * 60th second, and both the GPS and UTC tables are derived from that list
+ * when compiling. Everything here is constant-initialized, so the tables are
+ * safe to use from other translation units' static initializers.
+ *
+ * A newer list can be loaded at runtime from a `leap-seconds.list` or tzdata
+ * `leapseconds` file. The conversions read the active table through an atomic
+ * pointer and never take a lock.
+ */
+#pragma once
+
+// [C++ headers]
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <istream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/calendar.hpp"
+#include "femtotime/time_constants.hpp"
+
+// [Namespaces]
+namespace femtotime {
+
+/**
+ * @brief Throw `std::runtime_error`, or abort if exceptions are disabled, so
+ * the headers can be included from code built with `-fno-exceptions`
+ */
+[[noreturn]] inline void throw_runtime_error(const char *what)
+{
+#if defined(__cpp_exceptions)
+  throw std::runtime_error(what);
+#else
+  (void) what;
+  std::abort();
+#endif
+}
+
+/**
+ * @struct leap_date_t
+ *
+ * A UTC date that ended with a leap second (23:59:60).
+ */
+struct leap_date_t
+{
+  int year;
+  int month;
+  int day;
+
+  constexpr bool operator==(const leap_date_t &other) const = default;
+};
+
+/**
+ * @brief The UTC dates that ended with a leap second.
+ *
+ * NOTE FOR FUTURE MAINTAINERS: The conversion code assumes that this list is
+ * sorted, so any new leap seconds should be added to the bottom. Both
+ * `gps_time_t::leap_seconds` and `utc_time_t::leap_seconds` are generated from
+ * it.
+ */
+constexpr std::array<leap_date_t, 27> leap_second_dates = {{
+  {1972, 6, 30},
+  {1972, 12, 31},
+  {1973, 12, 31},
+  {1974, 12, 31},
+  {1975, 12, 31},
+  {1976, 12, 31},
+  {1977, 12, 31},
+  {1978, 12, 31},
+  {1979, 12, 31},
+  {1981, 6, 30},
+  {1982, 6, 30},
+  {1983, 6, 30},
+  {1985, 6, 30},
+  {1987, 12, 31},
+  {1989, 12, 31},
+  {1990, 12, 31},
+  {1992, 6, 30},
+  {1993, 6, 30},
+  {1994, 6, 30},
+  {1995, 12, 31},
+  {1997, 6, 30},
+  {1998, 12, 31},
+  {2005, 12, 31},
+  {2008, 12, 31},
+  {2012, 6, 30},
+  {2015, 6, 30},
+  {2016, 12, 31},
+}};
+
+/** @brief The number of leap seconds in the tables */
+constexpr std::size_t leap_second_count = leap_second_dates.size();
+
+/** @brief A flat table of femtosecond values, one per leap second */
+using leap_fs_array_t = std::array<femtosecs_t, leap_second_count>;
+
+/**
+ * @brief The UTC-GPS epoch difference, ignoring leap seconds (Jan. 1, 1970 to
+ * Jan. 6, 1980)
+ */
+constexpr femtosecs_t utc_gps_epoch_offset =
+  (utc_y2000_epoch - gps_y2000_epoch) * fs_per_day;
+
+/**
+ * @brief The start of each leap second as stored by `utc_time_t`, i.e. the
+ * femtoseconds of 23:59:59 on the leap date (with the leap flag set).
+ */
+constexpr leap_fs_array_t utc_leap_fs = [] {
+  leap_fs_array_t table{};
+  for (std::size_t i = 0; i < leap_second_count; i++) {
+    auto [year, month, day] = leap_second_dates[i];
+    auto next_day = days_from_civil(year, month, day, utc_y2000_epoch) + 1;
+    table[i] = next_day * fs_per_day - fs_per_sec;
+  }
+  return table;
+}();
+
+/** @brief The number of leap seconds that occurred before the GPS epoch */
+constexpr std::ptrdiff_t leaps_before_gps_epoch = [] {
+  std::ptrdiff_t count = 0;
+  for (auto fs : utc_leap_fs) {
+    count += fs < utc_gps_epoch_offset;
+  }
+  return count;
+}();
+
+/**
+ * @brief The GPS time of the start of each leap second.
+ *
+ * None of these fall on a 60th second: the GPS time of a leap second is its
+ * UTC time plus the leap seconds elapsed since the GPS epoch, counting itself.
+ */
+constexpr leap_fs_array_t gps_leap_fs = [] {
+  leap_fs_array_t table{};
+  for (std::size_t i = 0; i < leap_second_count; i++) {
+    auto elapsed = static_cast<std::ptrdiff_t>(i) + 1 - leaps_before_gps_epoch;
+    table[i] = utc_leap_fs[i] + elapsed * fs_per_sec - utc_gps_epoch_offset;
+  }
+  return table;
+}();
+
+/**
+ * @class leap_index_t
+ *
+ * Counts the entries of a sorted leap-second table that are at or before a
+ * time (what `std::upper_bound` would give) in constant time.
+ *
+ * The span of the table is cut into buckets of 2^73 fs (about 109 days), which
+ * is shorter than the gap between any two leap seconds, so each bucket holds
+ * at most one entry. A lookup is then a range check for times after the last
+ * entry (the common case), a shift to find the bucket, and one comparison
+ * against the bucket's entry.
+ */
+class leap_index_t
+{
+public:
+  /** @brief log2 of the bucket width in femtoseconds */
+  static constexpr int bucket_shift = 73;
+
+  /** @brief Enough buckets for leap seconds up to about 2048 */
+  static constexpr std::size_t max_buckets = 256;
+
+  /** @brief The most entries an index can hold */
+  static constexpr std::size_t max_entries = 64;
+
+  /**
+   * @brief Build the index over a sorted, non-empty table of times.
+   *
+   * Throws `std::runtime_error` if the table can't be indexed.
+   */
+  constexpr explicit leap_index_t(std::span<const femtosecs_t> entries)
+    : _entries{}, _count(entries.size()), _before{}
+  {
+    if (entries.empty() || entries.size() > max_entries) {
+      throw_runtime_error("unsupported number of leap seconds");
+    }
+    for (std::size_t i = 0; i < _count; i++) {
+      _entries[i] = entries[i];
+      if (i > 0 && entries[i] - entries[i - 1]
+                   <= (femtosecs_t(1) << bucket_shift)) {
+        throw_runtime_error("leap seconds are out of order or too close");
+      }
+    }
+    auto buckets = bucket(back()) + 1;
+    if (buckets > max_buckets) {
+      throw_runtime_error("leap seconds span too long a time to index");
+    }
+    std::size_t count = 0;
+    for (std::size_t b = 0; b < buckets; b++) {
+      auto start = _entries[0] + (femtosecs_t(b) << bucket_shift);
+      while (count < _count && _entries[count] < start) {
+        count++;
+      }
+      _before[b] = static_cast<uint8_t>(count);
+    }
+  }
+
+  /** @brief The number of entries at or before `fs` */
+  constexpr std::ptrdiff_t count_through(femtosecs_t fs) const
+  {
+    if (fs >= back()) {
+      return _count;
+    }
+    if (fs < _entries[0]) {
+      return 0;
+    }
+    std::size_t before = _before[bucket(fs)];
+    return before + (_entries[before] <= fs);
+  }
+
+  /** @brief The `i`th entry */
+  constexpr femtosecs_t operator[](std::size_t i) const
+  {
+    return _entries[i];
+  }
+
+  /** @brief The number of entries */
+  constexpr std::size_t size() const
+  {
+    return _count;
+  }
+
+private:
+  constexpr femtosecs_t back() const
+  {
+    return _entries[_count - 1];
+  }
+
+  constexpr std::size_t bucket(femtosecs_t fs) const
+  {
+    return static_cast<std::size_t>((fs - _entries[0]) >> bucket_shift);
+  }
+
+  std::array<femtosecs_t, max_entries> _entries;
+  std::size_t _count;
+  std::array<uint8_t, max_buckets> _before;
+};
+
+/**
+ * @class leap_table_t
+ *
+ * Everything the GPS/UTC conversions need to know about a set of leap
+ * seconds. The built-in table is `builtin_leap_table`; others can be loaded
+ * at runtime (see `LoadLeapSecondsFile`).
+ */
+class leap_table_t
+{
+public:
+  /**
+   * @brief Build the table from the UTC dates that ended with a leap second.
+   *
+   * Throws `std::runtime_error` if the dates can't be indexed.
+   */
+  constexpr explicit leap_table_t(std::span<const leap_date_t> dates)
+    : gps(gps_starts(dates)), utc(utc_ends(dates)),
+      before_gps_epoch(utc.count_through(utc_gps_epoch_offset))
+  {}
+
+  /** @brief The GPS time of the start of each leap second */
+  leap_index_t gps;
+
+  /**
+   * @brief The UTC time just *after* each leap second (midnight).
+   *
+   * A `utc_time_t` is looked up by its femtoseconds plus one second if it is
+   * itself within a leap second, so that the leap second counts as elapsed.
+   */
+  leap_index_t utc;
+
+  /** @brief The number of leap seconds that occurred before the GPS epoch */
+  std::ptrdiff_t before_gps_epoch;
+
+  /**
+   * @brief The number of leap seconds elapsed between the GPS epoch and a GPS
+   * time, and whether the time is within a leap second.
+   *
+   * The count is negative before the GPS epoch. A time within a leap second is
+   * counted as if that second has occurred.
+   */
+  constexpr std::pair<std::ptrdiff_t, bool> elapsed_gps(femtosecs_t fs) const
+  {
+    auto count = gps.count_through(fs);
+    bool is_leap = count > 0 && fs - gps[count - 1] < fs_per_sec;
+    return {count - before_gps_epoch, is_leap};
+  }
+
+  /** @brief As `elapsed_gps`, for a `utc_time_t`'s femtoseconds and flag */
+  constexpr std::ptrdiff_t elapsed_utc(femtosecs_t fs, bool is_leap) const
+  {
+    return utc.count_through(fs + is_leap * fs_per_sec) - before_gps_epoch;
+  }
+
+private:
+  using entries_t = std::array<femtosecs_t, leap_index_t::max_entries>;
+
+  /** @brief The UTC midnight that follows each leap second */
+  static constexpr entries_t utc_midnights(std::span<const leap_date_t> dates)
+  {
+    if (dates.size() > leap_index_t::max_entries) {
+      throw_runtime_error("unsupported number of leap seconds");
+    }
+    entries_t ends{};
+    for (std::size_t i = 0; i < dates.size(); i++) {
+      auto [year, month, day] = dates[i];
+      auto next_day = days_from_civil(year, month, day, utc_y2000_epoch) + 1;
+      ends[i] = next_day * fs_per_day;
+    }
+    return ends;
+  }
+
+  static constexpr leap_index_t utc_ends(std::span<const leap_date_t> dates)
+  {
+    auto ends = utc_midnights(dates);
+    return leap_index_t(std::span(ends).first(dates.size()));
+  }
+
+  static constexpr leap_index_t gps_starts(std::span<const leap_date_t> dates)
+  {
+    auto starts = utc_midnights(dates);
+    std::ptrdiff_t before_epoch = 0;
+    for (std::size_t i = 0; i < dates.size(); i++) {
+      before_epoch += starts[i] <= utc_gps_epoch_offset;
+    }
+    // Each leap second starts a second before midnight in UTC, and is offset
+    // by the leap seconds elapsed since the GPS epoch (counting itself) in GPS
+    for (std::size_t i = 0; i < dates.size(); i++) {
+      auto elapsed = static_cast<std::ptrdiff_t>(i) + 1 - before_epoch;
+      starts[i] += (elapsed - 1) * fs_per_sec - utc_gps_epoch_offset;
+    }
+    return leap_index_t(std::span(starts).first(dates.size()));
+  }
+};
+
+/** @brief The leap seconds compiled into the library */
+inline constexpr leap_table_t builtin_leap_table{leap_second_dates};
+
+static_assert(leaps_before_gps_epoch == 9);
+static_assert(builtin_leap_table.before_gps_epoch == leaps_before_gps_epoch);
+static_assert(gps_leap_fs.back() == (13'510 * secs_per_day + 17) * fs_per_sec);
+static_assert(builtin_leap_table.gps[leap_second_count - 1]
+              == gps_leap_fs.back());
+static_assert(builtin_leap_table.elapsed_gps(0).first == 0);
+
+/**
+ * @brief The leap-second table used by the GPS/UTC conversions.
+ *
+ * This is `builtin_leap_table` until another table is published with
+ * `SetLeapSeconds` or `LoadLeapSecondsFile`. It never takes a lock, and the
+ * returned table stays valid for the life of the program.
+ */
+const leap_table_t &CurrentLeapTable();
+
+/**
+ * @brief Publish a new leap-second table for the conversions to use.
+ *
+ * Readers already converting with the previous table finish with it; tables
+ * are never freed, so each call retains a few kilobytes. Throws
+ * `std::runtime_error` if the dates can't be indexed.
+ */
+void SetLeapSeconds(std::span<const leap_date_t> dates);
+
+/** @brief Go back to the leap seconds compiled into the library */
+void ResetLeapSeconds();
+
+/**
+ * @brief Parse the IETF/NIST `leap-seconds.list` format.
+ *
+ * Each data line is an NTP timestamp (seconds since 1900) and the TAI-UTC
+ * offset from that time on; lines starting with `#` are comments. Throws
+ * `std::runtime_error` on malformed input or a negative leap second.
+ */
+std::vector<leap_date_t> ParseLeapSecondsList(std::istream &input);
+
+/**
+ * @brief Parse the tzdata `leapseconds` format (`Leap 2016 Dec 31 23:59:60 +
+ * S` lines).
+ *
+ * Throws `std::runtime_error` on malformed input or a negative leap second.
+ */
+std::vector<leap_date_t> ParseTzdataLeapSeconds(std::istream &input);
+
+/**
+ * @brief Read a `leap-seconds.list` or tzdata `leapseconds` file (detected
+ * from its contents) and publish it with `SetLeapSeconds`.
+ */
+void LoadLeapSecondsFile(const std::string &path);
+
+} /** namespace femtotime */
@@ -2,14 +2,193 @@
  * @file msgpack.hpp
  * @author Patrick Norton <pnorton@lanl.gov>
  * @date 9 Aug 2022
+ *
+ * MessagePack adaptors for gps_time_t, utc_time_t and duration_t.
+ *
+ * Each is packed as a 16-byte ext (`fixext 16`, 18 bytes in all) holding a
+ * big-endian two's-complement 128-bit integer, so the encoding is the same on
+ * every platform and decoding reads straight from the ext's bytes:
+ *
+ *  - gps_time_t, type `gps_time_ext_type`: the femtoseconds since the GPS
+ *    epoch.
+ *  - utc_time_t, type `utc_time_ext_type`: twice the femtoseconds since the
+ *    UTC epoch, plus 1 during a leap second.
+ *  - duration_t, type `duration_ext_type`: the femtoseconds.
+ *
+ * The type numbers can be changed by defining `FEMTOTIME_MSGPACK_EXT_BASE`
+ * (the gps_time_t type; the others follow it). Defining
+ * `FEMTOTIME_MSGPACK_LEGACY_ARRAYS` packs a gps_time_t as the
+ * `[high, low]` array of `uint64` that earlier versions wrote, for readers
+ * that haven't been updated.
+ *
+ * All three decode from the `[high, low]` array form as well as from their
+ * ext, and the times also decode from the standard msgpack timestamp (ext
+ * -1). A `msgpack_timestamp_t` packs a time as that timestamp, to the
+ * nanosecond, for consumers that don't know the femtotime types. A UTC
+ * count outside `utc_fs_min` to `utc_fs_max` throws `msgpack::type_error`.
  */
 #pragma once
 
+// [C++ headers]
+#include <cstdint>
+
 // [MessagePack headers]
 #include <msgpack.hpp>
 
 // [femtotime headers]
 #include "femtotime/GPStime.hpp"
+#include "femtotime/time_split.hpp"
+
+#ifndef FEMTOTIME_MSGPACK_EXT_BASE
+#define FEMTOTIME_MSGPACK_EXT_BASE 70
+#endif
+
+namespace femtotime {
+
+/** @brief The msgpack ext type of a gps_time_t */
+constexpr int8_t gps_time_ext_type = FEMTOTIME_MSGPACK_EXT_BASE;
+
+/** @brief The msgpack ext type of a utc_time_t */
+constexpr int8_t utc_time_ext_type = FEMTOTIME_MSGPACK_EXT_BASE + 1;
+
+/** @brief The msgpack ext type of a duration_t */
+constexpr int8_t duration_ext_type = FEMTOTIME_MSGPACK_EXT_BASE + 2;
+
+/** @brief The standard msgpack timestamp ext type */
+constexpr int8_t msgpack_timestamp_ext_type = -1;
+
+/**
+ * @struct msgpack_timestamp_t
+ *
+ * A time to pack as a standard msgpack timestamp: the UTC seconds and
+ * nanoseconds since 1970, without leap seconds. The femtoseconds are
+ * truncated, and a time within a leap second is packed as the last
+ * nanosecond before it.
+ */
+struct msgpack_timestamp_t
+{
+  utc_time_t time;
+};
+
+/** @brief Write the low `N` bytes of `value`, most significant first */
+template <int N>
+inline void store_big_endian(char *out, uint128_t value)
+{
+  for (int i = N - 1; i >= 0; i--) {
+    out[i] = static_cast<char>(static_cast<uint8_t>(value));
+    value >>= 8;
+  }
+}
+
+/** @brief Read `N` bytes, most significant first */
+template <int N>
+inline uint128_t load_big_endian(const char *in)
+{
+  uint128_t value = 0;
+  for (int i = 0; i < N; i++) {
+    value = (value << 8) | static_cast<uint8_t>(in[i]);
+  }
+  return value;
+}
+
+/** @brief Pack a 128-bit count as a 16-byte ext of the given type */
+template <typename Stream>
+msgpack::packer<Stream> &pack_fs_ext(msgpack::packer<Stream> &o, int8_t type,
+                                     femtosecs_t value)
+{
+  char body[16];
+  store_big_endian<16>(body, static_cast<uint128_t>(value));
+  o.pack_ext(sizeof(body), type);
+  o.pack_ext_body(body, sizeof(body));
+  return o;
+}
+
+/**
+ * @brief Read the 128-bit count of a 16-byte ext of the given type, or of the
+ * `[high, low]` array of `uint64` that gps_time_t was once packed as.
+ *
+ * Throws `msgpack::type_error` if the object is neither.
+ */
+inline femtosecs_t unpack_fs(const msgpack::object &o, int8_t type)
+{
+  if (o.type == msgpack::type::EXT) {
+    if (o.via.ext.type() != type || o.via.ext.size != 16) {
+      throw msgpack::type_error();
+    }
+    return static_cast<femtosecs_t>(load_big_endian<16>(o.via.ext.data()));
+  }
+  if (o.type != msgpack::type::ARRAY || o.via.array.size != 2
+      || o.via.array.ptr[0].type != msgpack::type::POSITIVE_INTEGER
+      || o.via.array.ptr[1].type != msgpack::type::POSITIVE_INTEGER) {
+    throw msgpack::type_error();
+  }
+  auto high_bits = o.via.array.ptr[0].via.u64;
+  auto low_bits = o.via.array.ptr[1].via.u64;
+  return static_cast<femtosecs_t>((static_cast<uint128_t>(high_bits) << 64)
+                                  | low_bits);
+}
+
+/**
+ * @brief Read a standard msgpack timestamp (in any of its three sizes) as a
+ * UTC time.
+ *
+ * Throws `msgpack::type_error` if the ext is not a valid timestamp.
+ */
+inline utc_time_t unpack_timestamp(const msgpack::object_ext &ext)
+{
+  int64_t secs;
+  uint32_t nanos;
+  switch (ext.size) {
+  case 4:
+    secs = static_cast<int64_t>(load_big_endian<4>(ext.data()));
+    nanos = 0;
+    break;
+  case 8: {
+    auto bits = static_cast<uint64_t>(load_big_endian<8>(ext.data()));
+    secs = static_cast<int64_t>(bits & 0x3'ffff'ffff);
+    nanos = static_cast<uint32_t>(bits >> 34);
+    break;
+  }
+  case 12:
+    nanos = static_cast<uint32_t>(load_big_endian<4>(ext.data()));
+    secs = static_cast<int64_t>(
+      static_cast<uint64_t>(load_big_endian<8>(ext.data() + 4)));
+    break;
+  default:
+    throw msgpack::type_error();
+  }
+  if (nanos >= 1'000'000'000) {
+    throw msgpack::type_error();
+  }
+  return utc_time_t(secs * fs_per_sec + nanos * fs_per_ns);
+}
+
+/**
+ * @brief Read a utc_time_t from its ext, a timestamp or the array form.
+ *
+ * Throws `msgpack::type_error` if the count is outside `utc_fs_min` to
+ * `utc_fs_max`, which either 128-bit form can hold.
+ */
+inline utc_time_t unpack_utc(const msgpack::object &o)
+{
+  if (o.type == msgpack::type::EXT
+      && o.via.ext.type() == msgpack_timestamp_ext_type) {
+    return unpack_timestamp(o.via.ext);
+  }
+  auto value = unpack_fs(o, utc_time_ext_type);
+  // The array form is the femtoseconds, the ext twice them plus the leap flag
+  bool leap = false;
+  if (o.type != msgpack::type::ARRAY) {
+    leap = value & 1;
+    value >>= 1;
+  }
+  if (value < utc_fs_min || value > utc_fs_max) {
+    throw msgpack::type_error();
+  }
+  return utc_time_t(value, leap);
+}
+
+} /** namespace femtotime */
 
 namespace msgpack {
 MSGPACK_API_VERSION_NAMESPACE(v2) {
@@ -20,19 +199,16 @@ struct pack<femtotime::gps_time_t> {
   template<typename Stream>
   packer<Stream>& operator()(msgpack::packer<Stream>& o,
                              const femtotime::gps_time_t &t) const {
-    // NOTE: Technically, this won't work properly on systems that use
-    // ones-complement for their arithmetic (it's not UB, just
-    // implementation-defined). However, there is no way that we are compiling
-    // on one of those systems (and it will be illegal in C++20 anyways).
-    // Thankfully, C++17 disallows non-binary representations (like decimal), so
-    // *that* isn't an issue.
+#ifdef FEMTOTIME_MSGPACK_LEGACY_ARRAYS
     auto femtos = static_cast<femtotime::uint128_t>(t.get_fs());
-    auto high_bits = static_cast<uint64_t>(femtos >> 64);
-    auto low_bits = static_cast<uint64_t>(femtos);
     o.pack_array(2);
-    o.pack_uint64(high_bits);
-    o.pack_uint64(low_bits);
+    o.pack_uint64(static_cast<uint64_t>(femtos >> 64));
+    o.pack_uint64(static_cast<uint64_t>(femtos));
     return o;
+#else
+    return femtotime::pack_fs_ext(o, femtotime::gps_time_ext_type,
+                                  t.get_fs());
+#endif
   }
 };
 
@@ -40,14 +216,94 @@ template<>
 struct convert<femtotime::gps_time_t> {
   msgpack::object const& operator()(msgpack::object const& o,
                                     femtotime::gps_time_t& t) const {
-    if (o.type != msgpack::type::ARRAY || o.via.array.size != 2) {
-      throw msgpack::type_error();
+    if (o.type == msgpack::type::EXT
+        && o.via.ext.type() == femtotime::msgpack_timestamp_ext_type) {
+      auto utc = femtotime::unpack_timestamp(o.via.ext);
+      t = femtotime::gps_time_t::FromUTC(utc);
+    } else {
+      t = femtotime::gps_time_t(
+        femtotime::unpack_fs(o, femtotime::gps_time_ext_type));
+    }
+    return o;
+  }
+};
+
+template<>
+struct pack<femtotime::utc_time_t> {
+  template<typename Stream>
+  packer<Stream>& operator()(msgpack::packer<Stream>& o,
+                             const femtotime::utc_time_t &t) const {
+    // The leap flag is the low bit
+    return femtotime::pack_fs_ext(o, femtotime::utc_time_ext_type,
+                                  t.get_fs() * 2 + t.is_leap());
+  }
+};
+
+template<>
+struct convert<femtotime::utc_time_t> {
+  msgpack::object const& operator()(msgpack::object const& o,
+                                    femtotime::utc_time_t& t) const {
+    t = femtotime::unpack_utc(o);
+    return o;
+  }
+};
+
+template<>
+struct pack<femtotime::duration_t> {
+  template<typename Stream>
+  packer<Stream>& operator()(msgpack::packer<Stream>& o,
+                             const femtotime::duration_t &d) const {
+    return femtotime::pack_fs_ext(o, femtotime::duration_ext_type,
+                                  d.get_fs());
+  }
+};
+
+template<>
+struct convert<femtotime::duration_t> {
+  msgpack::object const& operator()(msgpack::object const& o,
+                                    femtotime::duration_t& d) const {
+    d = femtotime::duration_t(
+      femtotime::unpack_fs(o, femtotime::duration_ext_type));
+    return o;
+  }
+};
+
+// duration_t has no default constructor, so object::as needs this
+template<>
+struct as<femtotime::duration_t> {
+  femtotime::duration_t operator()(msgpack::object const& o) const {
+    return femtotime::duration_t(
+      femtotime::unpack_fs(o, femtotime::duration_ext_type));
+  }
+};
+
+template<>
+struct pack<femtotime::msgpack_timestamp_t> {
+  template<typename Stream>
+  packer<Stream>& operator()(msgpack::packer<Stream>& o,
+                             const femtotime::msgpack_timestamp_t &t) const {
+    auto [secs, subsec] = femtotime::split_secs(t.time.get_fs());
+    uint64_t nanos = t.time.is_leap() ? 999'999'999
+      : static_cast<uint64_t>(subsec / femtotime::fs_per_ns_64);
+    // The smallest of the three layouts that holds the time
+    char body[12];
+    if ((static_cast<uint64_t>(secs) >> 34) == 0) {
+      uint64_t bits = (nanos << 34) | static_cast<uint64_t>(secs);
+      if ((bits >> 32) == 0) {
+        femtotime::store_big_endian<4>(body, bits);
+        o.pack_ext(4, femtotime::msgpack_timestamp_ext_type);
+        o.pack_ext_body(body, 4);
+      } else {
+        femtotime::store_big_endian<8>(body, bits);
+        o.pack_ext(8, femtotime::msgpack_timestamp_ext_type);
+        o.pack_ext_body(body, 8);
+      }
+    } else {
+      femtotime::store_big_endian<4>(body, nanos);
+      femtotime::store_big_endian<8>(body + 4, static_cast<uint64_t>(secs));
+      o.pack_ext(12, femtotime::msgpack_timestamp_ext_type);
+      o.pack_ext_body(body, 12);
     }
-    auto high_bits = o.via.array.ptr[0].via.u64;
-    auto low_bits = o.via.array.ptr[1].via.u64;
-    auto femtos = (static_cast<femtotime::uint128_t>(high_bits) << 64)
-      + static_cast<femtotime::uint128_t>(low_bits);
-    t = femtotime::gps_time_t(static_cast<femtotime::int128_t>(femtos));
     return o;
   }
 };
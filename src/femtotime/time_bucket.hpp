@@ -0,0 +1,189 @@
+/**
+ * @file time_bucket.hpp
+ * @brief Rounding times to a grid, and bucketing them by grid or calendar
+ * @date 16 Oct 2026
+ *
+ * A `time_grid_t` is the set of times `origin + k * width` for every
+ * integer k. It rounds a time down, up or to the nearest of them, and gives
+ * the number k of the bin [origin + k * width, origin + (k + 1) * width)
+ * that holds a time, rounding towards negative infinity like
+ * `euclidean_div`. Dividing by a width known only at run time would call
+ * `__divti3`; the grid instead works out a reciprocal of the width when it
+ * is made, as `udivmod_by` does at compile time for the fixed constants.
+ *
+ * Calendar bins are UTC days, months or years, numbered from the UTC epoch
+ * and converted to and from GPS time with the current leap-second table.
+ */
+#pragma once
+
+// [C++ headers]
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_split.hpp"
+
+// [Namespaces]
+namespace femtotime {
+
+/**
+ * @class time_grid_t
+ *
+ * A grid of times `width` apart through `origin`. Bin numbers are
+ * truncated to 64 bits, so a time must be less than 2^63 widths from the
+ * origin for its bin to be meaningful; the rounding functions have no such
+ * limit.
+ */
+class time_grid_t
+{
+public:
+  /**
+   * @brief A grid of times `width` apart, through `origin`. Throws
+   * `std::runtime_error` if the width is not positive.
+   */
+  explicit time_grid_t(duration_t width, gps_time_t origin = gps_time_t(0));
+
+  /** @brief The distance between grid times */
+  const duration_t &width() const
+  {
+    return _width;
+  }
+
+  /** @brief The grid time of bin 0 */
+  const gps_time_t &origin() const
+  {
+    return _origin;
+  }
+
+  /** @brief The number of the bin holding `time` */
+  int64_t Bin(const gps_time_t &time) const
+  {
+    return Divide(time).first;
+  }
+
+  /** @brief The first time of bin `bin` */
+  gps_time_t Start(int64_t bin) const
+  {
+    return _origin + _width * femtosecs_t(bin);
+  }
+
+  /** @brief The latest grid time at or before `time` */
+  gps_time_t Floor(const gps_time_t &time) const
+  {
+    return gps_time_t(time.get_fs() - Divide(time).second);
+  }
+
+  /** @brief The earliest grid time at or after `time` */
+  gps_time_t Ceil(const gps_time_t &time) const
+  {
+    auto rem = Divide(time).second;
+    return rem == 0 ? time
+                    : gps_time_t(time.get_fs() - rem + _width.get_fs());
+  }
+
+  /**
+   * @brief The nearest grid time to `time`; a time halfway between two
+   * goes to the one with the even bin number, as `std::chrono::round` does
+   */
+  gps_time_t Round(const gps_time_t &time) const
+  {
+    auto [bin, rem] = Divide(time);
+    auto twice = 2 * static_cast<uint128_t>(rem);
+    auto width = static_cast<uint128_t>(_width.get_fs());
+    bool up = twice > width || (twice == width && (bin & 1));
+    return gps_time_t(time.get_fs() - rem + up * _width.get_fs());
+  }
+
+  /**
+   * @brief Write the bin number of each of `times` to `bins`, split across
+   * up to `threads` threads (0 for one per core) when there are enough
+   * times to be worth it. Throws `std::runtime_error` if the spans differ
+   * in size.
+   */
+  void Bins(std::span<const gps_time_t> times, std::span<int64_t> bins,
+            unsigned threads = 1) const;
+
+private:
+  /**
+   * @brief The bin number of `time` and its distance past the start of the
+   * bin, in [0, width).
+   *
+   * The width is `_reciprocal->divisor << _shift`. An arithmetic shift is a
+   * floor division by 2^_shift, so the offset from the origin is shifted
+   * first and the rest divided by the reciprocal. A negative offset is
+   * complemented, which gives |offset| - 1, so that an unsigned division
+   * of it gives the floor after complementing the quotient back.
+   */
+  std::pair<int64_t, femtosecs_t> Divide(const gps_time_t &time) const
+  {
+    femtosecs_t offset = time.get_fs() - _origin.get_fs();
+    if (!_reciprocal) {
+      return slow_divide(offset);
+    }
+    femtosecs_t shifted = offset >> _shift;
+    femtosecs_t low = offset - (shifted << _shift);
+    femtosecs_t sign = shifted >> 127;
+    auto [quot, rem] = udivmod(static_cast<uint128_t>(shifted ^ sign),
+                               *_reciprocal);
+    if (sign) {
+      rem = _reciprocal->divisor - 1 - rem;
+    }
+    auto bin = static_cast<uint64_t>(quot) ^ static_cast<uint64_t>(sign);
+    return {static_cast<int64_t>(bin),
+            (static_cast<femtosecs_t>(rem) << _shift) + low};
+  }
+
+  /** @brief `Divide` for a width too wide for a 64-bit reciprocal */
+  std::pair<int64_t, femtosecs_t> slow_divide(femtosecs_t offset) const;
+
+  duration_t _width;
+  gps_time_t _origin;
+  /** @brief The width without its trailing zero bits, if it fits 64 bits */
+  std::optional<reciprocal_t> _reciprocal;
+  /** @brief The number of trailing zero bits of the width */
+  int _shift = 0;
+};
+
+/** @brief The calendar periods times can be bucketed by */
+enum class calendar_unit_t
+{
+  /** @brief UTC days, numbered from Jan. 1, 1970 */
+  day,
+  /** @brief UTC months, numbered from January 1970 */
+  month,
+  /** @brief UTC years, numbered from 1970 */
+  year,
+};
+
+/**
+ * @brief The number of the UTC day, month or year holding `time`. A leap
+ * second belongs to the day it ends.
+ */
+int64_t CalendarBin(const gps_time_t &time, calendar_unit_t unit);
+
+/** @brief The first time (midnight UTC) of calendar bin `bin` */
+gps_time_t CalendarStart(int64_t bin, calendar_unit_t unit);
+
+/** @brief The start of the calendar bin holding `time` */
+gps_time_t CalendarFloor(const gps_time_t &time, calendar_unit_t unit);
+
+/**
+ * @brief The start of the calendar bin after the one holding `time`, or
+ * `time` itself if it starts a bin
+ */
+gps_time_t CalendarCeil(const gps_time_t &time, calendar_unit_t unit);
+
+/**
+ * @brief Write the calendar bin number of each of `times` to `bins`;
+ * fastest when `times` is sorted, and split across up to `threads` threads
+ * (0 for one per core) when there are enough times to be worth it. Throws
+ * `std::runtime_error` if the spans differ in size.
+ */
+void CalendarBins(std::span<const gps_time_t> times, std::span<int64_t> bins,
+                  calendar_unit_t unit, unsigned threads = 1);
+
+} /** namespace femtotime */
@@ -0,0 +1,222 @@
+/**
+ * @file time_bytes.hpp
+ * @brief Fixed-size byte forms of times and durations
+ * @date 16 Oct 2026
+ *
+ * A gps_time_t or duration_t is 16 bytes: its femtosecond count as a
+ * two's-complement 128-bit integer, little- or big-endian. A utc_time_t is
+ * the same 16 bytes holding twice its femtoseconds plus 1 during a leap
+ * second, or 17 bytes: the femtoseconds, then a leap byte of 0 or 1. The
+ * 17-byte form carries any count, and reading one outside `utc_fs_min` to
+ * `utc_fs_max`, in either form, throws. The big-endian forms are the bodies
+ * of the msgpack exts in `msgpack.hpp`.
+ *
+ * The span versions convert whole columns. A gps_time_t or duration_t in
+ * memory already is its femtosecond count, so in the host's byte order they
+ * are one `memcpy`, and in the other order a byte-swapping loop.
+ */
+#pragma once
+
+// [C++ headers]
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+namespace femtotime {
+
+static_assert(std::endian::native == std::endian::little
+              || std::endian::native == std::endian::big);
+
+/** @brief The size of the byte form of a time or duration */
+constexpr std::size_t time_byte_size = 16;
+
+/** @brief The size of the byte form of a utc_time_t with a leap byte */
+constexpr std::size_t utc_time_wide_byte_size = 17;
+
+/** @brief Reverse the bytes of a 128-bit integer */
+inline uint128_t byteswap_128(uint128_t value)
+{
+  auto low = static_cast<uint64_t>(value);
+  auto high = static_cast<uint64_t>(value >> 64);
+  return (static_cast<uint128_t>(__builtin_bswap64(low)) << 64)
+    | __builtin_bswap64(high);
+}
+
+/** @brief The 128-bit integer a value's 16-byte form holds */
+template <typename T>
+constexpr uint128_t time_byte_bits(const T &value)
+{
+  static_assert(std::is_same_v<T, gps_time_t> || std::is_same_v<T, utc_time_t>
+                || std::is_same_v<T, duration_t>,
+                "only times and durations have byte forms");
+  if constexpr (std::is_same_v<T, utc_time_t>) {
+    return static_cast<uint128_t>(value.get_fs()) * 2 + value.is_leap();
+  } else {
+    return static_cast<uint128_t>(value.get_fs());
+  }
+}
+
+/** @brief The value whose 16-byte form holds `bits` */
+template <typename T>
+constexpr T from_time_byte_bits(uint128_t bits)
+{
+  auto value = static_cast<femtosecs_t>(bits);
+  if constexpr (std::is_same_v<T, utc_time_t>) {
+    return utc_time_t(value >> 1, value & 1);
+  } else {
+    return T(value);
+  }
+}
+
+/** @brief The 16-byte form of a time or duration */
+template <typename T>
+std::array<uint8_t, time_byte_size> ToBytes(
+  const T &value, std::endian order = std::endian::little)
+{
+  auto bits = time_byte_bits(value);
+  if (order != std::endian::native) {
+    bits = byteswap_128(bits);
+  }
+  std::array<uint8_t, time_byte_size> out;
+  std::memcpy(out.data(), &bits, sizeof(bits));
+  return out;
+}
+
+/** @brief A time or duration from its 16-byte form */
+template <typename T>
+T FromBytes(std::span<const uint8_t, time_byte_size> in,
+            std::endian order = std::endian::little)
+{
+  uint128_t bits;
+  std::memcpy(&bits, in.data(), sizeof(bits));
+  if (order != std::endian::native) {
+    bits = byteswap_128(bits);
+  }
+  return from_time_byte_bits<T>(bits);
+}
+
+/** @brief The 17-byte form of a UTC time: femtoseconds, then leap byte */
+inline std::array<uint8_t, utc_time_wide_byte_size> ToWideBytes(
+  const utc_time_t &value, std::endian order = std::endian::little)
+{
+  std::array<uint8_t, utc_time_wide_byte_size> out;
+  auto fs = ToBytes(duration_t(value.get_fs()), order);
+  std::memcpy(out.data(), fs.data(), fs.size());
+  out[time_byte_size] = value.is_leap();
+  return out;
+}
+
+/**
+ * @brief A UTC time from its 17-byte form; throws `std::runtime_error` if
+ * the leap byte is not 0 or 1, or the count is out of a UTC time's range
+ */
+inline utc_time_t FromWideBytes(
+  std::span<const uint8_t, utc_time_wide_byte_size> in,
+  std::endian order = std::endian::little)
+{
+  if (in[time_byte_size] > 1) {
+    auto msg = fmt::format("FromWideBytes: bad leap byte {}",
+                           in[time_byte_size]);
+    throw_runtime_error(msg.c_str());
+  }
+  auto fs = FromBytes<duration_t>(in.template first<time_byte_size>(), order);
+  if (fs.get_fs() < utc_fs_min || fs.get_fs() > utc_fs_max) {
+    auto msg = fmt::format("FromWideBytes: {} fs is out of range for a UTC "
+                           "time", fs.get_fs());
+    throw_runtime_error(msg.c_str());
+  }
+  return utc_time_t(fs.get_fs(), in[time_byte_size] == 1);
+}
+
+/**
+ * @brief Write the 16-byte forms of `values` back to back to the start of
+ * `out`, and return the bytes written; throws `std::runtime_error` if `out`
+ * is too small
+ */
+template <typename T>
+std::size_t ToBytes(std::span<const T> values, std::span<uint8_t> out,
+                    std::endian order = std::endian::little)
+{
+  auto size = values.size() * time_byte_size;
+  if (out.size() < size) {
+    auto msg = fmt::format("ToBytes: {} values need {} bytes but there is "
+                           "room for {}", values.size(), size, out.size());
+    throw_runtime_error(msg.c_str());
+  }
+  if constexpr (!std::is_same_v<T, utc_time_t>) {
+    static_assert(sizeof(T) == time_byte_size
+                  && std::is_trivially_copyable_v<T>);
+    if (order == std::endian::native) {
+      std::memcpy(out.data(), values.data(), size);
+      return size;
+    }
+  }
+  auto copy = [&](auto swap) {
+    for (std::size_t i = 0; i < values.size(); i++) {
+      auto bits = time_byte_bits(values[i]);
+      if constexpr (decltype(swap)::value) {
+        bits = byteswap_128(bits);
+      }
+      std::memcpy(out.data() + i * time_byte_size, &bits, sizeof(bits));
+    }
+  };
+  if (order == std::endian::native) {
+    copy(std::false_type());
+  } else {
+    copy(std::true_type());
+  }
+  return size;
+}
+
+/**
+ * @brief Read `values.size()` 16-byte forms from the start of `in`, and
+ * return the bytes read; throws `std::runtime_error` if `in` is too small
+ */
+template <typename T>
+std::size_t FromBytes(std::span<const uint8_t> in, std::span<T> values,
+                      std::endian order = std::endian::little)
+{
+  auto size = values.size() * time_byte_size;
+  if (in.size() < size) {
+    auto msg = fmt::format("FromBytes: {} values need {} bytes but there are "
+                           "{}", values.size(), size, in.size());
+    throw_runtime_error(msg.c_str());
+  }
+  if constexpr (!std::is_same_v<T, utc_time_t>) {
+    static_assert(sizeof(T) == time_byte_size
+                  && std::is_trivially_copyable_v<T>);
+    if (order == std::endian::native) {
+      std::memcpy(values.data(), in.data(), size);
+      return size;
+    }
+  }
+  auto copy = [&](auto swap) {
+    for (std::size_t i = 0; i < values.size(); i++) {
+      uint128_t bits;
+      std::memcpy(&bits, in.data() + i * time_byte_size, sizeof(bits));
+      if constexpr (decltype(swap)::value) {
+        bits = byteswap_128(bits);
+      }
+      values[i] = from_time_byte_bits<T>(bits);
+    }
+  };
+  if (order == std::endian::native) {
+    copy(std::false_type());
+  } else {
+    copy(std::true_type());
+  }
+  return size;
+}
+
+} /** namespace femtotime */
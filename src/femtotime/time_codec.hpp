@@ -0,0 +1,158 @@
+/**
+ * @file time_codec.hpp
+ * @brief Compressed storage for columns of gps_time_t
+ * @date 16 Oct 2026
+ *
+ * Sample timestamps are nearly regular, so the differences between
+ * consecutive differences (the delta-of-delta) are zero or small. A
+ * `time_column_encoder_t` stores each block of up to `time_block_size` times
+ * as its first time and first difference, then the zigzag-encoded
+ * delta-of-deltas bit-packed in groups of `time_group_size`, each group with
+ * its own bit width. A perfectly regular block of 1024 times takes 51 bytes,
+ * counting its entry in the block table, against 16 KiB uncompressed.
+ * Blocks whose delta-of-deltas don't fit in 64 bits are stored raw.
+ *
+ * The encoded column ends with a table of block offsets, so a
+ * `time_column_t` can decode any block, or any time, without decoding those
+ * before it. The encoding is little-endian on every platform.
+ */
+#pragma once
+
+// [C++ headers]
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+
+// [Namespaces]
+namespace femtotime {
+
+/** @brief The number of times in each block but the last */
+constexpr std::size_t time_block_size = 1024;
+
+/** @brief The number of delta-of-deltas that share a bit width */
+constexpr std::size_t time_group_size = 128;
+
+/**
+ * @brief The instruction sets `time_column_t` can unpack bits with
+ */
+enum class codec_kernel_t
+{
+  /** @brief One value at a time */
+  scalar,
+
+  /** @brief Four values at a time with AVX2 gathers */
+  avx2,
+
+  /** @brief The best the CPU supports */
+  automatic,
+};
+
+/** @brief The best codec kernel the CPU supports */
+codec_kernel_t SupportedCodecKernel();
+
+/**
+ * @class time_column_encoder_t
+ *
+ * Encodes a sequence of times, appended one at a time or in spans, into a
+ * compressed column. Blocks are encoded as they fill, so memory use is the
+ * encoded size plus one block.
+ */
+class time_column_encoder_t
+{
+public:
+  /** @brief Add a time to the end of the column */
+  void Append(const gps_time_t &time)
+  {
+    _pending.push_back(time.get_fs());
+    if (_pending.size() == time_block_size) {
+      EncodeBlock();
+    }
+  }
+
+  /** @brief Add times to the end of the column */
+  void Append(std::span<const gps_time_t> times);
+
+  /** @brief The number of times appended */
+  std::size_t size() const
+  {
+    return _count + _pending.size();
+  }
+
+  /**
+   * @brief Encode any partial block and return the column; the encoder is
+   * then empty
+   */
+  std::vector<uint8_t> Finish();
+
+private:
+  void EncodeBlock();
+
+  std::vector<femtosecs_t> _pending;
+  std::vector<uint8_t> _data;
+  std::vector<uint64_t> _block_offsets;
+  std::size_t _count = 0;
+};
+
+/** @brief Encode a span of times as a column */
+std::vector<uint8_t> EncodeTimeColumn(std::span<const gps_time_t> times);
+
+/**
+ * @class time_column_t
+ *
+ * Read access to an encoded column, which must outlive it. The constructor
+ * checks the column's footer and block table, and the decoding functions
+ * check each block they read, throwing `std::runtime_error` if the data is
+ * not a valid column.
+ */
+class time_column_t
+{
+public:
+  explicit time_column_t(std::span<const uint8_t> data);
+
+  /** @brief The number of times in the column */
+  std::size_t size() const
+  {
+    return _count;
+  }
+
+  /** @brief The number of blocks in the column */
+  std::size_t block_count() const
+  {
+    return _block_count;
+  }
+
+  /** @brief Decode one time */
+  gps_time_t operator[](std::size_t index) const;
+
+  /**
+   * @brief Decode block `block` (times `block * time_block_size` onwards)
+   * into the start of `times`, which needs room for `time_block_size`, and
+   * return the number of times in the block
+   */
+  std::size_t DecodeBlock(std::size_t block, std::span<gps_time_t> times,
+                          codec_kernel_t kernel = codec_kernel_t::automatic)
+    const;
+
+  /**
+   * @brief Decode `times.size()` times starting at `first`; throws
+   * `std::runtime_error` if the column has fewer
+   */
+  void Decode(std::size_t first, std::span<gps_time_t> times,
+              codec_kernel_t kernel = codec_kernel_t::automatic) const;
+
+  /** @brief Decode the whole column */
+  std::vector<gps_time_t> Decode(
+    codec_kernel_t kernel = codec_kernel_t::automatic) const;
+
+private:
+  std::span<const uint8_t> _data;
+  const uint8_t *_offsets;
+  std::size_t _count;
+  std::size_t _block_count;
+};
+
+} /** namespace femtotime */
@@ -17,6 +17,8 @@ namespace femtotime {
     #error "128-bit integers are only supported on GCC and Clang"
 #endif
 
+typedef int128_t femtosecs_t;
+
 static const int128_t fs_per_ns = 1'000'000;
 static const int128_t ns_per_sec = 1'000'000'000;
 static const int128_t sec_per_min = 60;
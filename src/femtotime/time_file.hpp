@@ -0,0 +1,100 @@
+/**
+ * @file time_file.hpp
+ * @brief Memory-mapped files of sorted gps_time_t columns
+ * @date 16 Oct 2026
+ *
+ * A time file is a 64-byte header, a sparse index, and the times themselves
+ * as 16-byte little-endian femtosecond counts starting on a page boundary.
+ * The index has the first and last time of each run of `index_stride` times,
+ * so a range query reads the index and then only the pages of data that
+ * hold the answer.
+ *
+ * A `time_file_t` maps the file read-only and hands out the times in place,
+ * as a `std::span<const gps_time_t>`, with no copying or parsing.
+ */
+#pragma once
+
+// [C++ headers]
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+
+// [Namespaces]
+namespace femtotime {
+
+/** @brief The default number of times per index entry (64 KiB of data) */
+constexpr std::size_t time_file_index_stride = 4096;
+
+/**
+ * @brief Write sorted times to a time file, replacing any file at `path`.
+ *
+ * Throws `std::runtime_error` if the times are not sorted, the stride is
+ * zero, or the file can't be written.
+ */
+void WriteTimeFile(const std::string &path, std::span<const gps_time_t> times,
+                   std::size_t index_stride = time_file_index_stride);
+
+/**
+ * @class time_file_t
+ *
+ * A time file, mapped read-only for the life of the object. The constructor
+ * checks the header and the sizes of the index and data, throwing
+ * `std::runtime_error` if they don't match the file; it doesn't read the
+ * times, so a file whose times are not sorted gives unspecified query
+ * results. Only little-endian hosts can map the times in place.
+ */
+class time_file_t
+{
+public:
+  explicit time_file_t(const std::string &path);
+  time_file_t(time_file_t &&other) noexcept;
+  time_file_t &operator=(time_file_t &&other) noexcept;
+  time_file_t(const time_file_t &) = delete;
+  time_file_t &operator=(const time_file_t &) = delete;
+  ~time_file_t();
+
+  /** @brief All the times, in the mapped file */
+  std::span<const gps_time_t> times() const
+  {
+    return {_times, _count};
+  }
+
+  /** @brief The number of times */
+  std::size_t size() const
+  {
+    return _count;
+  }
+
+  /** @brief The number of times per index entry */
+  std::size_t index_stride() const
+  {
+    return _stride;
+  }
+
+  /** @brief The index of the first time not before `time` */
+  std::size_t lower_bound(const gps_time_t &time) const;
+
+  /** @brief The index of the first time after `time` */
+  std::size_t upper_bound(const gps_time_t &time) const;
+
+  /** @brief The times in [begin, end) */
+  std::span<const gps_time_t> Range(const gps_time_t &begin,
+                                    const gps_time_t &end) const;
+
+private:
+  /** @brief lower_bound, or upper_bound if `upper` */
+  std::size_t Bound(const gps_time_t &time, bool upper) const;
+
+  void *_map = nullptr;
+  std::size_t _map_size = 0;
+  const uint8_t *_index = nullptr;
+  const gps_time_t *_times = nullptr;
+  std::size_t _count = 0;
+  std::size_t _stride = 0;
+};
+
+} /** namespace femtotime */
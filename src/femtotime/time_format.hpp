@@ -0,0 +1,285 @@
+/**
+ * @file time_format.hpp
+ * @brief Allocation-free formatting of times, and their `fmt` formatters
+ * @date 16 Oct 2026
+ *
+ * The `FormatTo` members of the time classes write the same text as their
+ * `ToString()`, or a chosen `time_format_t` style and precision, into a
+ * caller's buffer of `time_string_capacity` characters. Digits are written
+ * two at a time from a lookup table, with no `fmt::format` or heap
+ * allocation. Including this header also lets the time classes be passed
+ * straight to `fmt::format` and `fmt::print`, with a format spec such as
+ * `{:basic.ms}` (see `time_formatter_t`).
+ *
+ * `std::format` is not supported, as the standard libraries this builds with
+ * don't all have `<format>`.
+ */
+#pragma once
+
+// [C++ headers]
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+namespace femtotime {
+
+/** @brief `"00"` through `"99"`, for writing two digits at a time */
+inline constexpr std::array<char, 200> digit_pairs = [] {
+  std::array<char, 200> pairs{};
+  for (int i = 0; i < 100; i++) {
+    pairs[2 * i] = static_cast<char>('0' + i / 10);
+    pairs[2 * i + 1] = static_cast<char>('0' + i % 10);
+  }
+  return pairs;
+}();
+
+/** @brief Write `value` (0-99) as two digits */
+constexpr char *write_2_digits(char *out, unsigned value)
+{
+  out[0] = digit_pairs[2 * value];
+  out[1] = digit_pairs[2 * value + 1];
+  return out + 2;
+}
+
+/**
+ * @brief Write the low `width` decimal digits of `value`, zero-padded, and
+ * return the end
+ */
+constexpr char *write_digits(char *out, uint64_t value, int width)
+{
+  char *end = out + width;
+  char *p = end;
+  while (p - out >= 2) {
+    p -= 2;
+    write_2_digits(p, static_cast<unsigned>(value % 100));
+    value /= 100;
+  }
+  if (p != out) {
+    *--p = static_cast<char>('0' + value % 10);
+  }
+  return end;
+}
+
+/** @brief The number of decimal digits in `value` (1 for 0) */
+constexpr int count_digits(uint64_t value)
+{
+  int digits = 1;
+  for (; value >= 100; value /= 100) {
+    digits += 2;
+  }
+  return digits + (value >= 10);
+}
+
+/** @brief Write a year as `fmt::format("{:04}", year)` would */
+constexpr char *write_year(char *out, int year)
+{
+  // The fixed-width common case
+  if (year >= 0 && year <= 9999) {
+    out = write_2_digits(out, year / 100);
+    return write_2_digits(out, year % 100);
+  }
+  int width = 4;
+  int64_t magnitude = year;
+  if (year < 0) {
+    *out++ = '-';
+    width = 3;
+    magnitude = -magnitude;
+  }
+  return write_digits(out, magnitude,
+                      std::max(width, count_digits(magnitude)));
+}
+
+/** @brief Write `YYYY-MM-DD` */
+constexpr char *write_date(char *out, int year, int month, int day)
+{
+  out = write_year(out, year);
+  *out++ = '-';
+  out = write_2_digits(out, month);
+  *out++ = '-';
+  return write_2_digits(out, day);
+}
+
+/**
+ * @brief Write a `.` and the digits of the fraction of a second that the
+ * precision keeps, or nothing for whole seconds
+ */
+constexpr char *write_fraction(char *out, int nanosecond, int femtosecond,
+                               time_precision_t precision)
+{
+  constexpr uint32_t powers_of_10[] = {1, 10, 100, 1'000, 10'000, 100'000,
+                                       1'000'000, 10'000'000, 100'000'000,
+                                       1'000'000'000};
+  auto digits = static_cast<int>(precision);
+  if (digits == 0) {
+    return out;
+  }
+  *out++ = '.';
+  if (digits <= 9) {
+    return write_digits(out, nanosecond / powers_of_10[9 - digits], digits);
+  }
+  out = write_digits(out, nanosecond, 9);
+  return write_digits(out, femtosecond / powers_of_10[15 - digits],
+                      digits - 9);
+}
+
+/** @brief Write the `Z` or `+00:00` that ends a time in the given style */
+constexpr char *write_zone(char *out, time_style_t style)
+{
+  if (style == time_style_t::rfc3339) {
+    return std::copy_n("+00:00", 6, out);
+  }
+  *out++ = 'Z';
+  return out;
+}
+
+/** @brief Write broken-down time fields in the given format */
+constexpr char *write_time(char *out, const civil_fields_t &fields,
+                           const time_format_t &format)
+{
+  if (format.style == time_style_t::gps) {
+    out = std::copy_n("GPS_", 4, out);
+  }
+  // The separators are written either way, and only kept if not basic
+  int keep = format.style != time_style_t::basic;
+  out = write_year(out, fields.year);
+  *out = '-';
+  out = write_2_digits(out + keep, fields.month);
+  *out = '-';
+  out = write_2_digits(out + keep, fields.day);
+  *out++ = 'T';
+  out = write_2_digits(out, fields.hour);
+  *out = ':';
+  out = write_2_digits(out + keep, fields.minute);
+  *out = ':';
+  out = write_2_digits(out + keep, fields.second);
+  out = write_fraction(out, fields.nanosecond, fields.femtosecond,
+                       format.precision);
+  return write_zone(out, format.style);
+}
+
+/**
+ * @brief Read a style name (`iso`, `basic`, `gps` or `rfc3339`); returns
+ * false if it isn't one
+ */
+constexpr bool parse_time_style(std::string_view name, time_style_t &style)
+{
+  constexpr std::pair<std::string_view, time_style_t> styles[] = {
+    {"iso", time_style_t::extended}, {"basic", time_style_t::basic},
+    {"gps", time_style_t::gps}, {"rfc3339", time_style_t::rfc3339}};
+  for (auto [candidate, value] : styles) {
+    if (name == candidate) {
+      style = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Read a precision name (`s`, `ms`, `us`, `ns`, `ps` or `fs`);
+ * returns false if it isn't one
+ */
+constexpr bool parse_time_precision(std::string_view name,
+                                    time_precision_t &precision)
+{
+  constexpr std::pair<std::string_view, time_precision_t> precisions[] = {
+    {"s", time_precision_t::s}, {"ms", time_precision_t::ms},
+    {"us", time_precision_t::us}, {"ns", time_precision_t::ns},
+    {"ps", time_precision_t::ps}, {"fs", time_precision_t::fs}};
+  for (auto [candidate, value] : precisions) {
+    if (name == candidate) {
+      precision = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @struct time_formatter_t
+ *
+ * The `fmt::formatter` for a time class, which writes its `FormatTo` text.
+ *
+ * The format spec is an optional style followed by an optional precision:
+ * `{:basic}`, `{:.ms}`, `{:rfc3339.us}`. The styles are `iso`, `basic`,
+ * `gps` and `rfc3339`, and the precisions `s`, `ms`, `us`, `ns`, `ps` and
+ * `fs`. A duration_t takes only a precision. The spec is checked when
+ * compiling if the format string is a literal.
+ */
+template <typename T>
+struct time_formatter_t
+{
+  static constexpr bool is_duration = std::is_same_v<T, duration_t>;
+
+  /** @brief The format, which is `ToString()`'s unless the spec changes it */
+  time_format_t spec = {std::is_same_v<T, gps_time_t> ? time_style_t::gps
+                                                      : time_style_t::extended,
+                        time_precision_t::fs};
+
+  constexpr auto parse(fmt::format_parse_context &ctx)
+  {
+    auto it = ctx.begin();
+    auto end = ctx.end();
+    auto read_word = [&] {
+      auto start = it;
+      while (it != end && ((*it >= 'a' && *it <= 'z')
+                           || (*it >= '0' && *it <= '9'))) {
+        ++it;
+      }
+      return std::string_view(&*start, static_cast<std::size_t>(it - start));
+    };
+    bool ok = true;
+    if (auto style = read_word(); !style.empty()) {
+      ok = !is_duration && parse_time_style(style, spec.style);
+    }
+    if (ok && it != end && *it == '.') {
+      ++it;
+      ok = parse_time_precision(read_word(), spec.precision);
+    }
+    if (!ok || (it != end && *it != '}')) {
+      FMT_THROW(fmt::format_error("invalid format spec for a femtotime time"));
+    }
+    return it;
+  }
+
+  template <typename FormatContext>
+  auto format(const T &time, FormatContext &ctx) const
+  {
+    char buffer[time_string_capacity];
+    char *end;
+    if constexpr (is_duration) {
+      end = time.FormatTo(buffer, spec.precision);
+    } else {
+      end = time.FormatTo(buffer, spec);
+    }
+    return fmt::formatter<std::string_view>().format(
+      std::string_view(buffer, end), ctx);
+  }
+};
+
+} /** namespace femtotime */
+
+template <>
+struct fmt::formatter<femtotime::gps_time_t>
+  : femtotime::time_formatter_t<femtotime::gps_time_t>
+{};
+
+template <>
+struct fmt::formatter<femtotime::utc_time_t>
+  : femtotime::time_formatter_t<femtotime::utc_time_t>
+{};
+
+template <>
+struct fmt::formatter<femtotime::duration_t>
+  : femtotime::time_formatter_t<femtotime::duration_t>
+{};
@@ -0,0 +1,95 @@
+/**
+ * @file time_format_batch.hpp
+ * @brief Formatting whole columns of times into one buffer
+ * @date 16 Oct 2026
+ *
+ * Exporting a column of times to CSV or a string column means formatting
+ * millions of them. The functions here write a span of times into a single
+ * caller-provided buffer, either as fixed-width records or back to back with
+ * an offsets array, with no allocation per time. Runs of times on the same
+ * day share one calendar conversion, the fraction of a second is turned into
+ * digits with SIMD, and large spans can be split across threads.
+ */
+#pragma once
+
+// [C++ headers]
+#include <cstddef>
+#include <span>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+
+// [Namespaces]
+namespace femtotime {
+
+/**
+ * @brief The length of a time in the given format, for years 0-9999 (years
+ * outside that range are longer)
+ */
+constexpr std::size_t FormattedWidth(const time_format_t &format)
+{
+  auto precision = static_cast<std::size_t>(format.precision);
+  bool basic = format.style == time_style_t::basic;
+  return (format.style == time_style_t::gps ? 4 : 0)
+    + (basic ? 15 : 19)
+    + (precision > 0 ? precision + 1 : 0)
+    + (format.style == time_style_t::rfc3339 ? 6 : 1);
+}
+
+/**
+ * @brief The number of bytes `FormatColumn` needs to write `times` back to
+ * back in the given format
+ */
+std::size_t FormattedSize(std::span<const gps_time_t> times,
+                          const time_format_t &format);
+
+/** @brief The same, for UTC times */
+std::size_t FormattedSize(std::span<const utc_time_t> times,
+                          const time_format_t &format);
+
+/**
+ * @brief Write each time in the given format into a record of `stride`
+ * bytes of `out`, padded with spaces.
+ *
+ * Record `i` starts at `out[i * stride]`. Returns the bytes written,
+ * `times.size() * stride`. Throws `std::runtime_error` if `out` is too
+ * small or a time doesn't fit in `stride` bytes (see `FormattedWidth`).
+ *
+ * The work is split across up to `threads` threads (0 for one per core)
+ * when there are enough times to be worth it.
+ */
+std::size_t FormatColumn(std::span<const gps_time_t> times,
+                         std::span<char> out, std::size_t stride,
+                         const time_format_t &format,
+                         unsigned threads = 1);
+
+/** @brief Write fixed-width records of UTC times, as above */
+std::size_t FormatColumn(std::span<const utc_time_t> times,
+                         std::span<char> out, std::size_t stride,
+                         const time_format_t &format,
+                         unsigned threads = 1);
+
+/**
+ * @brief Write the times in the given format back to back into `out`, with
+ * no separators.
+ *
+ * Time `i` is `out[offsets[i]]` up to `out[offsets[i + 1]]`, so `offsets`
+ * must have `times.size() + 1` elements (as for an Arrow string column).
+ * Returns the bytes written, which `FormattedSize` gives beforehand. Throws
+ * `std::runtime_error` if `offsets` or `out` is too small.
+ *
+ * The work is split across up to `threads` threads (0 for one per core)
+ * when there are enough times to be worth it.
+ */
+std::size_t FormatColumn(std::span<const gps_time_t> times,
+                         std::span<char> out, std::span<std::size_t> offsets,
+                         const time_format_t &format,
+                         unsigned threads = 1);
+
+/** @brief Write UTC times back to back, as above */
+std::size_t FormatColumn(std::span<const utc_time_t> times,
+                         std::span<char> out, std::span<std::size_t> offsets,
+                         const time_format_t &format,
+                         unsigned threads = 1);
+
+} /** namespace femtotime */
@@ -0,0 +1,220 @@
+/**
+ * @file time_index.hpp
+ * @brief A search index over sorted times, laid out for the cache
+ * @date 16 Oct 2026
+ *
+ * A `time_index_t` copies a sorted column of times into Eytzinger order:
+ * the implicit binary search tree stored breadth-first, with the root at
+ * index 1 and the children of node k at 2k and 2k + 1. Searching it reads
+ * the array front to back, the first levels of the tree stay in cache, and
+ * the sixteen nodes four levels below the current one fill four adjacent
+ * cache lines, so they can be prefetched well before the search needs one.
+ * The search itself has no branches that depend on the data.
+ *
+ * Lookups return positions in the sorted column the index was built from,
+ * so the caller keeps the times (and anything stored alongside them) and
+ * uses the index to find where a range starts and ends.
+ */
+#pragma once
+
+// [C++ headers]
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+
+// [Namespaces]
+namespace femtotime {
+
+/**
+ * @struct time_index_range_t
+ *
+ * The positions [first, last) of the times in a range.
+ */
+struct time_index_range_t
+{
+  std::size_t first = 0;
+  std::size_t last = 0;
+
+  /** @brief The number of times in the range */
+  constexpr std::size_t size() const
+  {
+    return last - first;
+  }
+
+  /** @brief True if the range has no times */
+  constexpr bool empty() const
+  {
+    return first == last;
+  }
+
+  /** @brief The part of the indexed column in the range */
+  template<typename T>
+  std::span<T> Slice(std::span<T> column) const
+  {
+    return column.subspan(first, size());
+  }
+};
+
+/**
+ * @class time_index_t
+ *
+ * An immutable index over a sorted column of times. Building it throws
+ * `std::runtime_error` if the times are not sorted; equal times are fine.
+ * The index takes 16 bytes per time and doesn't refer back to the column.
+ */
+class time_index_t
+{
+public:
+  /** @brief An empty index */
+  time_index_t() = default;
+  explicit time_index_t(std::span<const gps_time_t> times);
+  explicit time_index_t(std::span<const femtosecs_t> times);
+
+  /** @brief The number of times */
+  std::size_t size() const
+  {
+    return _count;
+  }
+
+  /** @brief The position of the first time not before `time` */
+  std::size_t lower_bound(const gps_time_t &time) const
+  {
+    return Search<false>(time.get_fs());
+  }
+
+  /** @brief The position of the first time after `time` */
+  std::size_t upper_bound(const gps_time_t &time) const
+  {
+    return Search<true>(time.get_fs());
+  }
+
+  /** @brief The positions of the times in [begin, end) */
+  time_index_range_t Range(const gps_time_t &begin,
+                           const gps_time_t &end) const
+  {
+    if (!(begin < end)) {
+      return {};
+    }
+    return {lower_bound(begin), lower_bound(end)};
+  }
+
+  /** @brief The number of times in [begin, end) */
+  std::size_t Count(const gps_time_t &begin, const gps_time_t &end) const
+  {
+    return Range(begin, end).size();
+  }
+
+  /**
+   * @brief `lower_bound` of each of `times`, into `out`.
+   *
+   * Runs several searches side by side so their cache misses overlap,
+   * which is much faster than one search at a time on a large index.
+   * Throws `std::runtime_error` if `out` is smaller than `times`.
+   */
+  void LowerBounds(std::span<const gps_time_t> times,
+                   std::span<std::size_t> out) const;
+
+private:
+  /** @brief Frees the key array */
+  struct aligned_delete_t
+  {
+    void operator()(femtosecs_t *keys) const
+    {
+      ::operator delete[](keys, std::align_val_t{64});
+    }
+  };
+
+  template<typename T>
+  void Build(std::span<const T> sorted);
+
+  /** @brief Prefetch the nodes four levels below node `k` */
+  void Prefetch(std::size_t k) const
+  {
+    // The 16 descendants fill four cache lines; the address may be past
+    // the end of the keys, which a prefetch is allowed to be
+    auto address = reinterpret_cast<std::uintptr_t>(_keys.get()) +
+      k * 16 * sizeof(femtosecs_t);
+    for (std::uintptr_t line = 0; line < 4; line++) {
+      __builtin_prefetch(reinterpret_cast<const void *>(address + 64 * line));
+    }
+  }
+
+  /** @brief Go one level down from node `k` toward `fs` */
+  template<bool upper>
+  std::size_t Step(std::size_t k, femtosecs_t fs) const
+  {
+    if constexpr (upper) {
+      return 2 * k + (_keys[k] <= fs);
+    } else {
+      return 2 * k + (_keys[k] < fs);
+    }
+  }
+
+  /**
+   * @brief Go down from a node in the last level, which may not exist.
+   *
+   * A missing node steps right, which the search undoes along with the
+   * run of right steps below the answer.
+   */
+  template<bool upper>
+  std::size_t LastStep(std::size_t k, femtosecs_t fs) const
+  {
+    bool missing = k > _count;
+    auto node = missing ? _count : k;
+    if constexpr (upper) {
+      return 2 * k + (missing | (_keys[node] <= fs));
+    } else {
+      return 2 * k + (missing | (_keys[node] < fs));
+    }
+  }
+
+  /** @brief The sorted position of node `k` */
+  std::size_t Rank(std::size_t k) const
+  {
+    // Its position in a full tree of the same height, less the leaves
+    // missing from the last level to its left
+    std::size_t depth = std::bit_width(k) - 1;
+    std::size_t full = (((k - (std::size_t{1} << depth)) * 2 + 1) <<
+                        (_height - 1 - depth)) - 1;
+    std::size_t leaves = (full + 1) / 2;
+    return full - (leaves > _last_level ? leaves - _last_level : 0);
+  }
+
+  /** @brief The sorted position found by a search that ended at `k` */
+  std::size_t Position(std::size_t k) const
+  {
+    // The answer is the last node where the search stepped left
+    k >>= std::countr_one(k) + 1;
+    return k == 0 ? _count : Rank(k);
+  }
+
+  /** @brief lower_bound, or upper_bound if `upper` */
+  template<bool upper>
+  std::size_t Search(femtosecs_t fs) const
+  {
+    if (_count == 0) {
+      return 0;
+    }
+    std::size_t k = 1;
+    for (std::size_t level = 1; level < _height; level++) {
+      Prefetch(k);
+      k = Step<upper>(k, fs);
+    }
+    return Position(LastStep<upper>(k, fs));
+  }
+
+  std::unique_ptr<femtosecs_t[], aligned_delete_t> _keys;
+  std::size_t _count = 0;
+  /** @brief The number of levels in the tree */
+  std::size_t _height = 0;
+  /** @brief The number of nodes in the last level */
+  std::size_t _last_level = 0;
+};
+
+} /** namespace femtotime */
@@ -0,0 +1,64 @@
+/**
+ * @file time_join.hpp
+ * @brief As-of joins between two sorted columns of times
+ * @date 16 Oct 2026
+ *
+ * An as-of join matches each time on the left with one on the right: the
+ * latest at or before it, the earliest at or after it, or the nearest,
+ * optionally no further away than a tolerance. Both columns are walked
+ * once, front to back. The cursor into the right column moves forward by
+ * galloping, doubling its step until it passes the left time and then
+ * searching back, so a right column much longer than the left costs a
+ * logarithm per left time rather than a pass over all of it.
+ */
+#pragma once
+
+// [C++ headers]
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+
+// [Namespaces]
+namespace femtotime {
+
+/** @brief Which time on the right an as-of join matches */
+enum class join_direction_t
+{
+  /** @brief The latest at or before the left time (the last of equals) */
+  backward,
+  /** @brief The earliest at or after the left time (the first of equals) */
+  forward,
+  /** @brief The closer of those two, the earlier on a tie */
+  nearest,
+};
+
+/** @brief The match of a left time that has none on the right */
+constexpr std::size_t join_no_match = SIZE_MAX;
+
+/**
+ * @brief Match each of the `left` times with one of the `right` times,
+ * writing the position in `right` of the match for `left[i]` to
+ * `matches[i]`, or `join_no_match`, and returning the number matched.
+ *
+ * Both columns must be sorted. With a `tolerance`, a match must be no
+ * further than it from the left time. Throws `std::runtime_error` if the
+ * left column is not sorted, `matches` isn't the size of `left`, or the
+ * tolerance is negative. The right column isn't checked, so that a short
+ * left column costs only its searches of a long right one; if it is not
+ * sorted, the matches are unspecified.
+ *
+ * The work is split across up to `threads` threads (0 for one per core)
+ * when there are enough left times to be worth it.
+ */
+std::size_t AsOfJoin(std::span<const gps_time_t> left,
+                     std::span<const gps_time_t> right,
+                     std::span<std::size_t> matches,
+                     join_direction_t direction = join_direction_t::backward,
+                     std::optional<duration_t> tolerance = std::nullopt,
+                     unsigned threads = 1);
+
+} /** namespace femtotime */
@@ -0,0 +1,321 @@
+/**
+ * @file time_merge.hpp
+ * @brief Merging many time-sorted streams into one with a loser tree
+ * @date 16 Oct 2026
+ *
+ * A `time_merge_t` holds any number of streams, each already sorted by
+ * time, and hands out their records in time order, one at a time or in
+ * runs. It keeps the time at the head of each stream in one array and a
+ * tournament tree over them that stores, at each match, the stream that
+ * lost. Taking a record replays only the matches on its stream's path to
+ * the root: one time comparison per level, with no comparison of stream
+ * numbers, since on a tie the stream from the left side of the match wins.
+ *
+ * Streams are numbered by the slot they are added to. A lower slot wins
+ * ties, so records with equal times come out in slot order, and each
+ * stream's records in their own order.
+ */
+#pragma once
+
+// [C++ headers]
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+namespace femtotime {
+
+/**
+ * @brief A stream of records sorted by time: `time()` and `front()` are
+ * the time and the record at the head, and `pop()` drops the head.
+ */
+template<typename S>
+concept time_stream = requires(S stream) {
+  { stream.empty() } -> std::convertible_to<bool>;
+  { stream.time() } -> std::convertible_to<gps_time_t>;
+  stream.front();
+  stream.pop();
+};
+
+/**
+ * @class span_stream_t
+ *
+ * A stream over a span of records, with `time_of(record)` giving each one's
+ * time. A span of times is a stream of itself.
+ */
+template<typename T, typename TimeOf = std::identity>
+class span_stream_t
+{
+public:
+  explicit span_stream_t(std::span<const T> records, TimeOf time_of = {})
+    : _records(records), _time_of(std::move(time_of))
+  {}
+
+  bool empty() const
+  {
+    return _records.empty();
+  }
+
+  gps_time_t time() const
+  {
+    return _time_of(_records.front());
+  }
+
+  const T &front() const
+  {
+    return _records.front();
+  }
+
+  void pop()
+  {
+    _records = _records.subspan(1);
+  }
+
+private:
+  std::span<const T> _records;
+  TimeOf _time_of;
+};
+
+/**
+ * @class time_merge_t
+ *
+ * A merge of streams in time order. Adding or removing a stream rebuilds
+ * the tree, in time linear in the number of slots; taking a record takes
+ * time logarithmic in it. Throws `std::runtime_error` if a stream's times
+ * go backwards, or reach the largest `gps_time_t`, which marks a slot with
+ * no records left.
+ */
+template<time_stream Stream>
+class time_merge_t
+{
+public:
+  /** @brief An empty merge */
+  time_merge_t() = default;
+
+  /** @brief A merge of `streams`, in slots 0, 1, ... */
+  explicit time_merge_t(std::vector<Stream> streams)
+  {
+    _streams.reserve(streams.size());
+    for (auto &stream : streams) {
+      _streams.emplace_back(std::move(stream));
+    }
+    Rebuild();
+  }
+
+  /**
+   * @brief Add a stream to the merge, in the lowest free slot, and return
+   * the slot
+   */
+  std::size_t Add(Stream stream)
+  {
+    std::size_t slot = 0;
+    while (slot < _streams.size() && _streams[slot]) {
+      slot++;
+    }
+    if (slot == _streams.size()) {
+      _streams.emplace_back(std::move(stream));
+    } else {
+      _streams[slot].emplace(std::move(stream));
+    }
+    Rebuild();
+    return slot;
+  }
+
+  /** @brief Drop the stream in `slot`, and whatever records it has left */
+  void Remove(std::size_t slot)
+  {
+    if (slot >= _streams.size() || !_streams[slot]) {
+      auto msg = fmt::format("time_merge_t::Remove: no stream in slot {}",
+                             slot);
+      throw_runtime_error(msg.c_str());
+    }
+    _streams[slot].reset();
+    while (!_streams.empty() && !_streams.back()) {
+      _streams.pop_back();
+    }
+    Rebuild();
+  }
+
+  /** @brief The stream in `slot`, if there is one */
+  Stream *stream(std::size_t slot)
+  {
+    return slot < _streams.size() && _streams[slot] ? &*_streams[slot]
+                                                     : nullptr;
+  }
+
+  /** @brief True if no stream has a record left */
+  bool empty() const
+  {
+    return _top.time == exhausted;
+  }
+
+  /** @brief The time of the next record */
+  const gps_time_t &time() const
+  {
+    return _top.time;
+  }
+
+  /** @brief The slot of the stream the next record comes from */
+  std::size_t slot() const
+  {
+    return _top.slot;
+  }
+
+  /** @brief The next record */
+  decltype(auto) front()
+  {
+    return _streams[_top.slot]->front();
+  }
+
+  /** @brief Move past the next record */
+  void pop()
+  {
+    Replay({Advance(_top), _top.slot});
+  }
+
+  /**
+   * @brief Pass `emit` the next record and the ones after it from the same
+   * stream, up to `limit` of them or until another stream's record is
+   * due, and return how many there were.
+   *
+   * The tree is replayed once for the whole run, so merging streams that
+   * take turns in long runs costs little more than copying them.
+   */
+  template<typename F>
+  std::size_t PopRun(F &&emit, std::size_t limit = SIZE_MAX)
+  {
+    if (empty() || limit == 0) {
+      return 0;
+    }
+    // The best of the streams that lost to this one on its way up; with
+    // none left, no slot is below bound.slot, so a run never passes the
+    // end of its stream
+    entry_t bound = {exhausted, 0};
+    for (auto node = (_leaves + _top.slot) / 2; node > 0; node /= 2) {
+      const auto &loser = _losers[node];
+      if (loser.time < bound.time || (loser.time == bound.time &&
+                                      loser.slot < bound.slot)) {
+        bound = loser;
+      }
+    }
+    // This stream keeps the lead while its time is earlier, or the same
+    // and its slot is lower
+    std::size_t count = 0;
+    auto &stream = *_streams[_top.slot];
+    do {
+      emit(stream.front());
+      _top.time = Advance(_top);
+      count++;
+    } while (count < limit && (_top.time < bound.time ||
+                               (_top.slot < bound.slot &&
+                                _top.time == bound.time)));
+    Replay(_top);
+    return count;
+  }
+
+private:
+  /**
+   * @struct entry_t
+   *
+   * A slot and the time at its head, so that playing a match reads only
+   * the node it is played at.
+   */
+  struct entry_t
+  {
+    gps_time_t time;
+    std::size_t slot;
+  };
+
+  /** @brief The time of a slot with no records */
+  static constexpr gps_time_t exhausted =
+    gps_time_t(std::numeric_limits<femtosecs_t>::max());
+
+  /** @brief The head time of the stream in `slot`, or `exhausted` */
+  gps_time_t HeadTime(std::size_t slot)
+  {
+    auto &stream = _streams[slot];
+    if (!stream || stream->empty()) {
+      return exhausted;
+    }
+    gps_time_t time = stream->time();
+    if (time == exhausted) {
+      auto msg = fmt::format("time_merge_t: stream {} has a time at the end "
+                             "of the range", slot);
+      throw_runtime_error(msg.c_str());
+    }
+    return time;
+  }
+
+  /** @brief Drop the head of the stream of `entry` and return its next time */
+  gps_time_t Advance(const entry_t &entry)
+  {
+    _streams[entry.slot]->pop();
+    auto time = HeadTime(entry.slot);
+    if (time < entry.time) {
+      auto msg = fmt::format("time_merge_t: stream {} is not sorted",
+                             entry.slot);
+      throw_runtime_error(msg.c_str());
+    }
+    return time;
+  }
+
+  /** @brief Replay the matches of the old winner, now `winner`, to the root */
+  void Replay(entry_t winner)
+  {
+    for (auto pos = _leaves + winner.slot; pos > 1; pos /= 2) {
+      auto &loser = _losers[pos / 2];
+      // On a tie the stream from the left wins, keeping slot order
+      bool left = pos % 2 == 0;
+      bool swap = left ? loser.time < winner.time
+                       : !(winner.time < loser.time);
+      if (swap) {
+        std::swap(loser, winner);
+      }
+    }
+    _top = winner;
+  }
+
+  /** @brief Read every head time and play every match */
+  void Rebuild()
+  {
+    _leaves = std::bit_ceil(std::max<std::size_t>(_streams.size(), 1));
+    // Node n plays the winners of nodes 2n and 2n + 1; leaves are nodes
+    // _leaves to 2 * _leaves - 1
+    std::vector<entry_t> winners(2 * _leaves);
+    for (std::size_t slot = 0; slot < _leaves; slot++) {
+      auto time = slot < _streams.size() ? HeadTime(slot) : exhausted;
+      winners[_leaves + slot] = {time, slot};
+    }
+    _losers.assign(_leaves, {exhausted, 0});
+    for (auto node = _leaves - 1; node > 0; node--) {
+      const auto &left = winners[2 * node];
+      const auto &right = winners[2 * node + 1];
+      bool left_wins = !(right.time < left.time);
+      winners[node] = left_wins ? left : right;
+      _losers[node] = left_wins ? right : left;
+    }
+    _top = winners[1];
+  }
+
+  std::vector<std::optional<Stream>> _streams;
+  /** @brief The entry that lost the match at each node */
+  std::vector<entry_t> _losers;
+  /** @brief The entry that won the last match, at the root */
+  entry_t _top = {exhausted, 0};
+  std::size_t _leaves = 0;
+};
+
+} /** namespace femtotime */
@@ -0,0 +1,397 @@
+/**
+ * @file time_parse.hpp
+ * @brief Hand-written parser for ISO-8601 style timestamps
+ * @date 16 Oct 2026
+ *
+ * These routines read a timestamp into `civil_fields_t` with no allocation,
+ * no locale and no `sscanf`. Every digit and separator is checked directly,
+ * and the fraction of a second is read exactly as an integer number of
+ * femtoseconds (digits past the fifteenth are truncated).
+ *
+ * The `Try...` functions report malformed input as a `parse_error_t` and the
+ * byte offset where parsing stopped, and never throw or allocate, so they
+ * suit high-volume input where bad records are expected, and code built with
+ * `-fno-exceptions`. The throwing `gps_time_t::From...String` functions are
+ * wrappers around them.
+ */
+#pragma once
+
+// [C++ headers]
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+
+// [Namespaces]
+namespace femtotime {
+
+/**
+ * @brief The timestamp layouts understood by `parse_iso_fields`
+ */
+enum class iso_layout_t
+{
+  /** @brief `YYYY-MM-DDTHH:MM:SS[.f...][Z]`; the date and time fields may be
+   * one digit shorter (1-4 digits for the year) */
+  extended,
+
+  /** @brief `YYYYMMDDTHHMMSS[.f...][Z]` */
+  basic,
+};
+
+/**
+ * @brief Why a string could not be parsed
+ */
+enum class parse_error_t
+{
+  /** @brief The string was parsed */
+  none,
+
+  /** @brief A digit was expected (including at the end of the string) */
+  expected_digit,
+
+  /** @brief A `-`, `T`, `:` or (in a GPS string) `GPS_` was expected */
+  expected_separator,
+
+  /** @brief A `.` had no digits after it */
+  empty_fraction,
+
+  /** @brief The timestamp was followed by something other than one `Z` */
+  trailing_characters,
+
+  /** @brief A UTC string had no `-`, as in the Modified-Julian day numbers
+   * that are no longer supported */
+  julian_date,
+
+  /** @brief A Modified-Julian day number had too many digits */
+  out_of_range,
+};
+
+/** @brief A short description of a parse error */
+constexpr const char *ToString(parse_error_t error)
+{
+  switch (error) {
+  case parse_error_t::none:
+    return "no error";
+  case parse_error_t::expected_digit:
+    return "expected a digit";
+  case parse_error_t::expected_separator:
+    return "expected a separator";
+  case parse_error_t::empty_fraction:
+    return "no digits after '.'";
+  case parse_error_t::trailing_characters:
+    return "unexpected trailing characters";
+  case parse_error_t::julian_date:
+    return "Modified-Julian dates are not supported";
+  case parse_error_t::out_of_range:
+    return "value out of range";
+  }
+  return "unknown error";
+}
+
+/**
+ * @struct parse_status_t
+ *
+ * The outcome of a parse: an error, and the byte offset in the input where
+ * it was found. Converts to true if there was no error.
+ */
+struct parse_status_t
+{
+  parse_error_t error = parse_error_t::none;
+  std::size_t offset = 0;
+
+  constexpr explicit operator bool() const
+  {
+    return error == parse_error_t::none;
+  }
+};
+
+/**
+ * @struct parse_result_t
+ *
+ * A parsed value, or the error that stopped the parse (in which case `value`
+ * is default-constructed).
+ */
+template <typename T>
+struct parse_result_t : parse_status_t
+{
+  T value{};
+
+  constexpr bool has_value() const
+  {
+    return error == parse_error_t::none;
+  }
+};
+
+/**
+ * @struct civil_date_t
+ *
+ * A calendar date, as read by `TryString2Date`.
+ */
+struct civil_date_t
+{
+  int year = 0;
+  int month = 0;
+  int day = 0;
+
+  constexpr bool operator==(const civil_date_t &other) const = default;
+};
+
+/** @brief If a character is an ASCII digit */
+constexpr bool is_digit(char c)
+{
+  return static_cast<unsigned char>(c - '0') < 10;
+}
+
+/**
+ * @brief Read between `min_digits` and `max_digits` decimal digits at `pos`,
+ * advancing it. Returns false if there are too few.
+ */
+constexpr bool read_digits(std::string_view text, std::size_t &pos,
+                           int min_digits, int max_digits, int &value)
+{
+  int digits = 0;
+  value = 0;
+  while (digits < max_digits && pos < text.size() && is_digit(text[pos])) {
+    value = value * 10 + (text[pos] - '0');
+    pos++;
+    digits++;
+  }
+  return digits >= min_digits;
+}
+
+/** @brief Two digits at `pos`, which the caller has checked are in range */
+constexpr int two_digits(std::string_view text, std::size_t pos)
+{
+  return (text[pos] - '0') * 10 + (text[pos + 1] - '0');
+}
+
+/**
+ * @brief The eight bytes at `pos` as a little-endian word
+ */
+constexpr uint64_t load_8_chars(std::string_view text, std::size_t pos)
+{
+  if constexpr (std::endian::native == std::endian::little) {
+    if (!std::is_constant_evaluated()) {
+      uint64_t word;
+      std::memcpy(&word, text.data() + pos, sizeof(word));
+      return word;
+    }
+  }
+  uint64_t word = 0;
+  for (int i = 0; i < 8; i++) {
+    word |= static_cast<uint64_t>(static_cast<unsigned char>(text[pos + i]))
+      << (8 * i);
+  }
+  return word;
+}
+
+/** @brief If all eight bytes of a word are ASCII digits */
+constexpr bool all_8_digits(uint64_t word)
+{
+  constexpr uint64_t high = 0xF0F0F0F0F0F0F0F0;
+  return ((word & high) | (((word + 0x0606060606060606) & high) >> 4))
+    == 0x3333333333333333;
+}
+
+/**
+ * @brief The value of eight ASCII digits in a word (first digit in the low
+ * byte), with three multiplications instead of eight
+ */
+constexpr uint64_t parse_8_digits(uint64_t word)
+{
+  word -= 0x3030303030303030;
+  word = word * 10 + (word >> 8);
+  return (((word & 0x000000FF000000FF) * (100 + (1000000ULL << 32)))
+          + (((word >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32))))
+    >> 32;
+}
+
+static_assert(parse_8_digits(load_8_chars("12345678", 0)) == 12'345'678);
+
+/**
+ * @struct char_pattern_t
+ *
+ * Eight characters to match against, where a `0` stands for any digit and
+ * every other character must match exactly.
+ */
+struct char_pattern_t
+{
+  /** @brief All digits */
+  constexpr char_pattern_t() = default;
+
+  constexpr char_pattern_t(const char (&pattern)[9])
+  {
+    for (int i = 0; i < 8; i++) {
+      if (pattern[i] != '0') {
+        separator_mask |= uint64_t{0xFF} << (8 * i);
+        separators |= static_cast<uint64_t>(pattern[i]) << (8 * i);
+      }
+    }
+  }
+
+  uint64_t separator_mask = 0;
+  uint64_t separators = 0;
+};
+
+/** @brief If the eight bytes of `word` match `pattern` */
+constexpr bool match_8_chars(uint64_t word, const char_pattern_t &pattern)
+{
+  auto digits = (word & ~pattern.separator_mask)
+    | (0x3030303030303030 & pattern.separator_mask);
+  return (word & pattern.separator_mask) == pattern.separators
+    && all_8_digits(digits);
+}
+
+/** @brief `YYYY-MM-`, `DDTHH:MM` and `HH:MM:SS` */
+constexpr char_pattern_t extended_date_pattern("0000-00-");
+constexpr char_pattern_t extended_middle_pattern("00T00:00");
+constexpr char_pattern_t extended_time_pattern("00:00:00");
+
+/** @brief `DTHHMMSS` */
+constexpr char_pattern_t basic_time_pattern("0T000000");
+
+/**
+ * @brief Read the optional `.f...` fraction of a second at `pos` into
+ * nanoseconds and femtoseconds. Returns false if there is a `.` with no
+ * digits after it.
+ */
+constexpr bool read_fraction(std::string_view text, std::size_t &pos,
+                             civil_fields_t &fields)
+{
+  fields.nanosecond = 0;
+  fields.femtosecond = 0;
+  if (pos == text.size() || text[pos] != '.') {
+    return true;
+  }
+  pos++;
+  int64_t femtos = 0;
+  int digits = 0;
+  // Eight digits at a time while they're all kept
+  if (pos + 8 <= text.size()) {
+    auto word = load_8_chars(text, pos);
+    if (all_8_digits(word)) {
+      femtos = parse_8_digits(word);
+      digits = 8;
+      pos += 8;
+    }
+  }
+  for (; pos < text.size() && is_digit(text[pos]); pos++, digits++) {
+    if (digits < 15) {
+      femtos = femtos * 10 + (text[pos] - '0');
+    }
+  }
+  constexpr int64_t scale[16] = {
+    1'000'000'000'000'000, 100'000'000'000'000, 10'000'000'000'000,
+    1'000'000'000'000, 100'000'000'000, 10'000'000'000, 1'000'000'000,
+    100'000'000, 10'000'000, 1'000'000, 100'000, 10'000, 1'000, 100, 10, 1
+  };
+  femtos *= scale[digits < 15 ? digits : 15];
+  fields.nanosecond = static_cast<int>(femtos / 1'000'000);
+  fields.femtosecond = static_cast<int>(femtos % 1'000'000);
+  return digits > 0;
+}
+
+/**
+ * @brief Parse a timestamp in the given layout into `fields`.
+ *
+ * The timestamp may end with a `Z`, and must have nothing after it. No range
+ * checks are done on the fields (a second of 60 is a UTC leap second).
+ * `day_of_year` is not set. If the text is malformed, returns the error and
+ * where it was found.
+ */
+constexpr parse_status_t parse_iso_fields(std::string_view text,
+                                          iso_layout_t layout,
+                                          civil_fields_t &fields)
+{
+  std::size_t pos = 0;
+  if (layout == iso_layout_t::basic) {
+    // Fixed widths: YYYYMMDDTHHMMSS
+    if (text.size() < 15 || !all_8_digits(load_8_chars(text, 0))
+        || !match_8_chars(load_8_chars(text, 7), basic_time_pattern)) {
+      // Find the first character that doesn't fit
+      constexpr std::string_view pattern = "00000000T000000";
+      for (; pos < pattern.size(); pos++) {
+        if (pattern[pos] == 'T'
+            && (pos == text.size() || text[pos] != 'T')) {
+          return {parse_error_t::expected_separator, pos};
+        }
+        if (pattern[pos] == '0'
+            && (pos == text.size() || !is_digit(text[pos]))) {
+          return {parse_error_t::expected_digit, pos};
+        }
+      }
+    }
+    fields.year = two_digits(text, 0) * 100 + two_digits(text, 2);
+    fields.month = two_digits(text, 4);
+    fields.day = two_digits(text, 6);
+    fields.hour = two_digits(text, 9);
+    fields.minute = two_digits(text, 11);
+    fields.second = two_digits(text, 13);
+    pos = 15;
+  } else if (text.size() >= 19
+             && match_8_chars(load_8_chars(text, 0), extended_date_pattern)
+             && match_8_chars(load_8_chars(text, 8), extended_middle_pattern)
+             && match_8_chars(load_8_chars(text, 11), extended_time_pattern)) {
+    // The common, full-width YYYY-MM-DDTHH:MM:SS, checked eight bytes at a
+    // time
+    fields.year = two_digits(text, 0) * 100 + two_digits(text, 2);
+    fields.month = two_digits(text, 5);
+    fields.day = two_digits(text, 8);
+    fields.hour = two_digits(text, 11);
+    fields.minute = two_digits(text, 14);
+    fields.second = two_digits(text, 17);
+    pos = 19;
+  } else {
+    // Fields with fewer digits, e.g. 2022-1-1T1:2:3 (or a malformed string,
+    // in which case this finds where)
+    int *values[] = {&fields.year, &fields.month, &fields.day,
+                     &fields.hour, &fields.minute, &fields.second};
+    constexpr std::string_view separators = "--T::";
+    for (std::size_t i = 0; i < 6; i++) {
+      if (i > 0) {
+        if (pos == text.size() || text[pos] != separators[i - 1]) {
+          return {parse_error_t::expected_separator, pos};
+        }
+        pos++;
+      }
+      if (!read_digits(text, pos, 1, i == 0 ? 4 : 2, *values[i])) {
+        return {parse_error_t::expected_digit, pos};
+      }
+    }
+  }
+  if (!read_fraction(text, pos, fields)) {
+    return {parse_error_t::empty_fraction, pos};
+  }
+  if (pos < text.size() && text[pos] == 'Z') {
+    pos++;
+  }
+  if (pos != text.size()) {
+    return {parse_error_t::trailing_characters, pos};
+  }
+  return {};
+}
+
+/** @brief Parse a UTC time string (`YYYY-MM-DDTHH:MM:SS[.f...][Z]`) */
+parse_result_t<gps_time_t> TryFromUTCString(std::string_view utc_time)
+  noexcept;
+
+/** @brief Parse a GPS time string (`GPS_YYYY-MM-DDTHH:MM:SS[.f...][Z]`) */
+parse_result_t<gps_time_t> TryFromGPSString(std::string_view gps_time)
+  noexcept;
+
+/** @brief Parse a basic-format UTC string (`YYYYMMDDTHHMMSS[.f...][Z]`) */
+parse_result_t<gps_time_t> TryFromISOString(std::string_view iso_time)
+  noexcept;
+
+/**
+ * @brief Parse a date given either as `YYYY-MM-DD` or as a Modified-Julian
+ * day number (up to nine digits)
+ */
+parse_result_t<civil_date_t> TryString2Date(std::string_view date_string)
+  noexcept;
+
+} /** namespace femtotime */
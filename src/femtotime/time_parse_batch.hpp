@@ -0,0 +1,111 @@
+/**
+ * @file time_parse_batch.hpp
+ * @brief Parsing columns of fixed-width UTC timestamps with SIMD
+ * @date 16 Oct 2026
+ *
+ * Columnar input often holds millions of timestamps that all have the same
+ * layout, e.g. `YYYY-MM-DDTHH:MM:SS.fffffffffZ`, either packed back to back
+ * or at a fixed stride. Because every row has its digits and separators in
+ * the same places, a whole row can be checked with a few vector compares and
+ * its digits turned into field values with byte multiply-adds. The kernel
+ * (AVX2, SSSE3 or scalar) is chosen when called, from what the CPU supports.
+ */
+#pragma once
+
+// [C++ headers]
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+
+// [Namespaces]
+namespace femtotime {
+
+/**
+ * @struct iso_column_t
+ *
+ * A column of UTC timestamps, all laid out as
+ * `YYYY-MM-DDTHH:MM:SS[.f...][Z]` with the same number of fraction digits
+ * and the same choice of `Z`.
+ */
+struct iso_column_t
+{
+  /** @brief The text; row `i` starts at byte `i * stride` */
+  std::string_view data;
+
+  /** @brief The bytes from the start of one row to the next, at least
+   * `width()` */
+  std::size_t stride;
+
+  /** @brief The digits after the `.`, 0-9 (with 0 meaning there is no `.`) */
+  int fraction_digits = 9;
+
+  /** @brief If each timestamp ends with a `Z` */
+  bool zulu = true;
+
+  /** @brief The length of each timestamp */
+  constexpr std::size_t width() const
+  {
+    return 19 + (fraction_digits > 0 ? fraction_digits + 1 : 0) + zulu;
+  }
+
+  /** @brief The number of rows in `data` (the last may have no padding), or
+   * 0 if `stride` is too small */
+  constexpr std::size_t rows() const
+  {
+    if (stride < width() || data.size() < width()) {
+      return 0;
+    }
+    return (data.size() - width()) / stride + 1;
+  }
+};
+
+/**
+ * @brief The instruction sets `ParseUTCColumn` can use
+ */
+enum class parse_kernel_t
+{
+  /** @brief One byte at a time */
+  scalar,
+
+  /** @brief One row in two 16-byte registers */
+  ssse3,
+
+  /** @brief One row in a 32-byte register */
+  avx2,
+
+  /** @brief The best the CPU supports */
+  automatic,
+};
+
+/** @brief The best parse kernel the CPU supports */
+parse_kernel_t SupportedParseKernel();
+
+/**
+ * @brief Parse a column of UTC timestamps into GPS times.
+ *
+ * Bit `i % 64` of `valid[i / 64]` is set if row `i` matched the column's
+ * layout; rows that didn't are set to `gps_time_t(0)`. No range checks are
+ * done on the fields, as with `gps_time_t::FromUTCString`, and a second of
+ * 60 is a leap second. Returns the number of valid rows.
+ *
+ * `times` must have `column.rows()` elements and `valid` enough words for
+ * them. Throws `std::runtime_error` if they don't, or if the layout is not
+ * supported. A `kernel` the CPU doesn't support is replaced with the best
+ * one it does.
+ */
+std::size_t ParseUTCColumn(const iso_column_t &column,
+                           std::span<gps_time_t> times,
+                           std::span<uint64_t> valid,
+                           parse_kernel_t kernel = parse_kernel_t::automatic);
+
+/** @brief Parse a column of UTC timestamps, as above, into UTC times */
+std::size_t ParseUTCColumn(const iso_column_t &column,
+                           std::span<utc_time_t> times,
+                           std::span<uint64_t> valid,
+                           parse_kernel_t kernel = parse_kernel_t::automatic);
+
+} /** namespace femtotime */
@@ -0,0 +1,95 @@
+/**
+ * @file time_sort.hpp
+ * @brief Radix sorts for columns of times and durations
+ * @date 16 Oct 2026
+ *
+ * These sort by the femtosecond count, one byte per pass, from the least
+ * significant byte up. A pass for a byte that is the same in every time is
+ * skipped; counting from the smallest time, a day of times differs only in
+ * its low nine bytes, so a column usually takes well under the sixteen
+ * passes a 128-bit key could need. Each pass reads and writes the column
+ * once, with no comparisons.
+ *
+ * A large column is first split into 256 ranges by the high bits of its
+ * times, and the ranges, small enough for their passes to stay in cache,
+ * are then sorted on their own, in parallel when there are threads to spare.
+ * A range that is still large, as the bulk of a column is when a few
+ * outliers such as zero times widen it, is split again by the high bits of
+ * its own times. The sorts are stable and need scratch space the size of
+ * the column.
+ */
+#pragma once
+
+// [C++ headers]
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+
+// [Namespaces]
+namespace femtotime {
+
+/**
+ * @brief Sort times into increasing order.
+ *
+ * The work is split across up to `threads` threads (0 for one per core)
+ * when there are enough times to be worth it.
+ */
+void SortTimes(std::span<gps_time_t> times, unsigned threads = 1);
+
+/** @brief Sort durations into increasing order, as above */
+void SortTimes(std::span<duration_t> durations, unsigned threads = 1);
+
+/**
+ * @brief The positions of the times in sorted order: `times[order[0]]` is
+ * the earliest, and equal times keep their order.
+ *
+ * Throws `std::runtime_error` if `order` isn't the size of `times`. The work
+ * is split across up to `threads` threads (0 for one per core) when there
+ * are enough times to be worth it.
+ */
+void SortedOrder(std::span<const gps_time_t> times,
+                 std::span<std::size_t> order, unsigned threads = 1);
+
+/**
+ * @brief Sort records by the time `time_of(record)` gives, keeping equal
+ * times in order.
+ *
+ * The records are moved into place in the order `SortedOrder` finds,
+ * following each cycle of that order so that a record moves once (the
+ * first of a cycle goes through a temporary) with no second buffer. This
+ * suits records that are large or costly to compare.
+ */
+template<typename T, typename TimeOf>
+void SortByTime(std::span<T> records, TimeOf &&time_of, unsigned threads = 1)
+{
+  std::vector<gps_time_t> times;
+  times.reserve(records.size());
+  for (const auto &record : records) {
+    times.push_back(time_of(record));
+  }
+  std::vector<std::size_t> order(records.size());
+  SortedOrder(times, order, threads);
+  // Slot `i` takes the record at `order[i]`, which then leaves a hole to be
+  // filled in turn; a slot already filled is marked by `order[i] == i`
+  for (std::size_t start = 0; start < records.size(); start++) {
+    if (order[start] == start) {
+      continue;
+    }
+    T held = std::move(records[start]);
+    auto hole = start;
+    while (order[hole] != start) {
+      auto next = order[hole];
+      records[hole] = std::move(records[next]);
+      order[hole] = hole;
+      hole = next;
+    }
+    records[hole] = std::move(held);
+    order[hole] = hole;
+  }
+}
+
+} /** namespace femtotime */
@@ -0,0 +1,205 @@
+/**
+ * @file time_split.hpp
+ * @brief Division of femtosecond counts by fixed time constants
+ * @date 16 Oct 2026
+ *
+ * Dividing a 128-bit `femtosecs_t` by one of the constants in
+ * `time_constants.hpp` compiles to a call to libgcc's `__divti3`/`__modti3`.
+ * The routines here divide by those constants with a few 64-bit
+ * multiplications instead, and split a count into whole seconds and
+ * femtoseconds of the second. Everything coarser than a second is then plain
+ * 64-bit arithmetic on the seconds.
+ */
+#pragma once
+
+// [C++ headers]
+#include <bit>
+#include <cstdint>
+#include <utility>
+
+// [femtotime headers]
+#include "femtotime/time_constants.hpp"
+
+// [Namespaces]
+namespace femtotime {
+
+// 64-bit copies of the constants from time_constants.hpp, for arithmetic on the
+// split parts. Mixing in the int128_t originals would widen the expression back
+// to a 128-bit division.
+constexpr int64_t fs_per_ns_64 = fs_per_ns;
+constexpr int64_t fs_per_us_64 = fs_per_us;
+constexpr int64_t fs_per_ms_64 = fs_per_ms;
+constexpr int64_t fs_per_hour_64 = fs_per_hour;
+constexpr int64_t fs_per_sec_64 = fs_per_sec;
+constexpr int64_t sec_per_min_64 = sec_per_min;
+constexpr int64_t secs_per_hour_64 = secs_per_hour;
+constexpr int64_t secs_per_day_64 = secs_per_day;
+
+/**
+ * @struct split_secs_t
+ *
+ * A femtosecond count split into whole seconds and femtoseconds of the second.
+ */
+struct split_secs_t
+{
+  /** @brief Whole seconds */
+  int64_t secs;
+
+  /** @brief Femtoseconds of the second */
+  int64_t subsec;
+};
+
+/**
+ * @struct reciprocal_t
+ *
+ * A 64-bit divisor, shifted left until its top bit is set, and its
+ * reciprocal, for `udivmod`. Making one costs a 128-bit division; each
+ * division by it after that is two multiplications.
+ */
+struct reciprocal_t
+{
+  explicit constexpr reciprocal_t(uint64_t divisor)
+    : divisor(divisor), norm(std::countl_zero(divisor)),
+      d(divisor << norm),
+      v(static_cast<uint64_t>(
+          ((static_cast<uint128_t>(~d) << 64) | ~uint64_t{0}) / d))
+  {}
+
+  /** @brief The divisor */
+  uint64_t divisor;
+
+  /** @brief How far the divisor is shifted */
+  int norm;
+
+  /** @brief The shifted divisor */
+  uint64_t d;
+
+  /** @brief floor((2^128 - 1) / d) - 2^64 */
+  uint64_t v;
+};
+
+/**
+ * @brief Divide an unsigned 128-bit value by a 64-bit divisor.
+ *
+ * Returns the quotient and remainder. When the high word of `n` is below the
+ * divisor (which covers every time the library can represent as calendar
+ * fields) this is a two-word-by-one-word division using the precomputed
+ * reciprocal (Moller and Granlund, "Improved division by invariant
+ * integers", 2011): two multiplications and two rarely-taken corrections,
+ * where the compiler would otherwise call `__udivti3`.
+ */
+constexpr std::pair<uint128_t, uint64_t> udivmod(uint128_t n,
+                                                 const reciprocal_t &r)
+{
+  auto hi = static_cast<uint64_t>(n >> 64);
+  auto lo = static_cast<uint64_t>(n);
+  uint64_t q_hi = 0;
+  if (hi >= r.divisor) {
+    q_hi = hi / r.divisor;
+    hi %= r.divisor;
+  }
+
+  // Normalize the dividend by the same shift; shifting `lo` right in two
+  // steps keeps a shift of 0 defined
+  uint64_t u1 = (hi << r.norm) | ((lo >> 1) >> (63 - r.norm));
+  uint64_t u0 = lo << r.norm;
+  uint128_t p = static_cast<uint128_t>(r.v) * u1
+    + ((static_cast<uint128_t>(u1) << 64) | u0);
+  uint64_t q1 = static_cast<uint64_t>(p >> 64) + 1;
+  auto q0 = static_cast<uint64_t>(p);
+  uint64_t rem = u0 - q1 * r.d;
+  // This correction is taken about as often as not for some divisors, so
+  // it is done with masks rather than a branch
+  uint64_t over = -static_cast<uint64_t>(rem > q0);
+  q1 += over;
+  rem += over & r.d;
+  if (rem >= r.d) {
+    q1 += 1;
+    rem -= r.d;
+  }
+  return {(static_cast<uint128_t>(q_hi) << 64) | q1, rem >> r.norm};
+}
+
+/**
+ * @brief Divide an unsigned 128-bit value by the 64-bit constant `D`, as
+ * `udivmod` does, with the reciprocal worked out at compile time.
+ */
+template<uint64_t D>
+constexpr std::pair<uint128_t, uint64_t> udivmod_by(uint128_t n)
+{
+  static_assert(D != 0);
+  constexpr reciprocal_t r(D);
+  return udivmod(n, r);
+}
+
+/**
+ * @brief Divide a femtosecond count by the constant `D`, rounding towards zero
+ * (like the built-in `/`).
+ *
+ * The quotient is truncated to 64 bits.
+ */
+template<uint64_t D>
+constexpr int64_t div_trunc_by(femtosecs_t fs)
+{
+  auto negative = fs < 0;
+  auto magnitude = negative ? -static_cast<uint128_t>(fs)
+                            : static_cast<uint128_t>(fs);
+  auto quot = static_cast<uint64_t>(udivmod_by<D>(magnitude).first);
+  return static_cast<int64_t>(negative ? -quot : quot);
+}
+
+/**
+ * @brief Split a femtosecond count into seconds and femtoseconds, rounding
+ * towards negative infinity (like `euclidean_div` below).
+ *
+ * The femtoseconds are always in [0, 10^15). The result is exact as long as
+ * the number of seconds fits in an `int64_t` (about 2.9e11 years either side
+ * of the epoch).
+ */
+constexpr split_secs_t split_secs(femtosecs_t fs)
+{
+  // Biasing by 2^63 seconds makes the dividend non-negative, so an unsigned
+  // division gives the floor without any sign fix-ups.
+  constexpr uint128_t bias = static_cast<uint128_t>(uint64_t{1} << 63)
+    * static_cast<uint128_t>(fs_per_sec);
+  auto biased = static_cast<uint128_t>(fs) + bias;
+  auto [quot, rem] = udivmod_by<fs_per_sec_64>(biased);
+  auto secs = static_cast<uint64_t>(quot) - (uint64_t{1} << 63);
+  return {static_cast<int64_t>(secs), static_cast<int64_t>(rem)};
+}
+
+/**
+ * @brief Split a femtosecond count into seconds and femtoseconds, rounding
+ * towards zero (like the built-in `/` and `%`).
+ *
+ * The femtoseconds have the same sign as `fs`.
+ */
+constexpr split_secs_t split_secs_trunc(femtosecs_t fs)
+{
+  auto split = split_secs(fs);
+  int64_t adjust = (fs < 0) & (split.subsec != 0);
+  split.secs += adjust;
+  split.subsec -= adjust * fs_per_sec_64;
+  return split;
+}
+
+/**
+ * @brief Floor division and modulus on 64-bit integers.
+ *
+ * The remainder is always non-negative for a positive divisor.
+ */
+constexpr std::pair<int64_t, int64_t> euclidean_div(int64_t x, int64_t y)
+{
+  auto quot = x / y;
+  auto rem = x % y;
+  int64_t adjust = rem < 0;
+  return {quot - adjust, rem + adjust * y};
+}
+
+static_assert(split_secs(0).secs == 0 && split_secs(0).subsec == 0);
+static_assert(split_secs(-1).secs == -1
+              && split_secs(-1).subsec == fs_per_sec - 1);
+static_assert(split_secs_trunc(-1).secs == 0
+              && split_secs_trunc(-1).subsec == -1);
+
+} /** namespace femtotime */
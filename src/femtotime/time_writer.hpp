@@ -0,0 +1,168 @@
+/**
+ * @file time_writer.hpp
+ * @brief Formatting streams of increasing times, such as log timestamps
+ * @date 16 Oct 2026
+ *
+ * Consecutive timestamps in a log or CSV file almost always share their
+ * `YYYY-MM-DDTHH:MM` prefix. `time_writer_t` keeps the text of the last
+ * minute it wrote and that minute's femtosecond bounds, so the common case
+ * is two comparisons, a copy of the prefix, and 64-bit arithmetic for the
+ * seconds and fraction. Leaving the minute for another in the same day only
+ * rewrites the hour and minute; the calendar is only consulted when the day
+ * changes.
+ */
+#pragma once
+
+// [C++ headers]
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_format.hpp"
+#include "femtotime/time_split.hpp"
+
+// [Namespaces]
+namespace femtotime {
+
+/**
+ * @class time_writer_t
+ *
+ * A stateful formatter for gps_time_t or utc_time_t that writes the same text
+ * as their `FormatTo(out, format)`, including second 60 for a UTC time within
+ * a leap second.
+ *
+ * Any sequence of times is formatted correctly; sorted times, or times that
+ * cluster within a minute, are formatted fastest. It is not thread-safe; use
+ * one writer per thread.
+ */
+template <typename T>
+class time_writer_t
+{
+  static_assert(std::is_same_v<T, gps_time_t>
+                || std::is_same_v<T, utc_time_t>);
+
+public:
+  /** @brief A writer of the same format as `T::ToString()` */
+  time_writer_t()
+    : time_writer_t({std::is_same_v<T, gps_time_t> ? time_style_t::gps
+                                                   : time_style_t::extended,
+                     time_precision_t::fs})
+  {}
+
+  /** @brief A writer of the given format */
+  explicit time_writer_t(const time_format_t &format) : _format(format)
+  {}
+
+  /** @brief The format this writes */
+  const time_format_t &Format() const
+  {
+    return _format;
+  }
+
+  /**
+   * @brief Write a time to `out`, which must have room for
+   * `time_string_capacity` characters, and return the end
+   */
+  char *FormatTo(char *out, const T &time)
+  {
+    auto fs = time.get_fs();
+    if (fs < _minute_begin || fs >= _minute_end) [[unlikely]] {
+      Seek(time);
+    }
+    // Less than a minute, so the rest is 64-bit arithmetic
+    auto offset = static_cast<uint64_t>(fs - _minute_begin);
+    auto second = static_cast<unsigned>(offset / fs_per_sec_64);
+    auto subsec = offset % fs_per_sec_64;
+    if constexpr (std::is_same_v<T, utc_time_t>) {
+      second += time.is_leap();
+    }
+    // A fixed-size copy is a couple of vector moves, where the exact size
+    // would be a call to memcpy; `out` has room for it either way
+    std::copy_n(_prefix.data(), prefix_copy_size, out);
+    out += _prefix_size;
+    out = write_2_digits(out, second);
+    out = write_fraction(out, static_cast<int>(subsec / fs_per_ns_64),
+                         static_cast<int>(subsec % fs_per_ns_64),
+                         _format.precision);
+    return write_zone(out, _format.style);
+  }
+
+  /** @brief Format a time as a string */
+  std::string ToString(const T &time)
+  {
+    char buffer[time_string_capacity];
+    return std::string(buffer, FormatTo(buffer, time));
+  }
+
+private:
+  /** @brief Move the cached minute, and day if need be, to a time's */
+  void Seek(const T &time)
+  {
+    auto fs = time.get_fs();
+    // Keep the hour and minute separators unless the style is basic
+    int keep = _format.style != time_style_t::basic;
+    if (fs >= _day_begin && fs < _day_end) {
+      // A day of femtoseconds overflows 64 bits, so split off the seconds
+      auto secs = split_secs(fs - _day_begin).secs;
+      auto minute_of_day = static_cast<unsigned>(secs / sec_per_min_64);
+      write_2_digits(&_prefix[_hour_at], minute_of_day / 60);
+      write_2_digits(&_prefix[_hour_at + 2 + keep], minute_of_day % 60);
+      _minute_begin = _day_begin + minute_of_day * fs_per_min;
+      _minute_end = _minute_begin + fs_per_min;
+      return;
+    }
+
+    // The prefix is the whole-second text without its seconds and zone
+    auto fields = time.Fields();
+    char *end = write_time(_prefix.data(), fields,
+                           {_format.style, time_precision_t::s});
+    _prefix_size = static_cast<std::size_t>(end - _prefix.data())
+      - 2 - (_format.style == time_style_t::rfc3339 ? 6 : 1);
+    _hour_at = _prefix_size - 4 - 2 * keep;
+
+    // During a leap second, the femtoseconds are those of second 59
+    int second = fields.second;
+    if constexpr (std::is_same_v<T, utc_time_t>) {
+      second -= time.is_leap();
+    }
+    femtosecs_t subsec = int64_t{fields.nanosecond} * fs_per_ns_64
+      + fields.femtosecond;
+    _minute_begin = fs - second * fs_per_sec - subsec;
+    _minute_end = _minute_begin + fs_per_min;
+    _day_begin = _minute_begin
+      - (fields.hour * secs_per_hour_64 + fields.minute * sec_per_min_64)
+      * fs_per_sec;
+    _day_end = _day_begin + fs_per_day;
+  }
+
+  /** @brief More than the longest prefix, with a year of up to 11 chars */
+  static constexpr std::size_t prefix_copy_size = 32;
+  static_assert(prefix_copy_size <= time_string_capacity);
+
+  time_format_t _format;
+
+  /** @brief The text up to the seconds of times in the cached minute */
+  std::array<char, time_string_capacity> _prefix{};
+  std::size_t _prefix_size = 0;
+
+  /** @brief Where the hour is in `_prefix` */
+  std::size_t _hour_at = 0;
+
+  femtosecs_t _minute_begin = std::numeric_limits<femtosecs_t>::max();
+  femtosecs_t _minute_end = std::numeric_limits<femtosecs_t>::min();
+  femtosecs_t _day_begin = std::numeric_limits<femtosecs_t>::max();
+  femtosecs_t _day_end = std::numeric_limits<femtosecs_t>::min();
+};
+
+/** @brief A time_writer_t for gps_time_t */
+using gps_time_writer_t = time_writer_t<gps_time_t>;
+
+/** @brief A time_writer_t for utc_time_t */
+using utc_time_writer_t = time_writer_t<utc_time_t>;
+
+} /** namespace femtotime */
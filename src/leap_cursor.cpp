@@ -0,0 +1,94 @@
+/**
+ * @file leap_cursor.cpp
+ * @brief Converting sorted sequences of times between GPS and UTC
+ * @date 16 Oct 2026
+ */
+
+// [femtotime headers]
+#include "femtotime/leap_cursor.hpp"
+
+// [C++ headers]
+#include <limits>
+#include <stdexcept>
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace std;
+
+namespace femtotime {
+
+static constexpr femtosecs_t fs_min = std::numeric_limits<femtosecs_t>::min();
+static constexpr femtosecs_t fs_max = std::numeric_limits<femtosecs_t>::max();
+
+/** @brief Move the GPS segment to the one holding `fs` */
+void leap_cursor_t::SeekGPS(femtosecs_t fs)
+{
+  const auto &index = _table->gps;
+  std::size_t count = index.count_through(fs);
+  _gps.begin = count > 0 ? index[count - 1] : fs_min;
+  _gps.end = count < index.size() ? index[count] : fs_max;
+  _gps.leap_end = count > 0 ? _gps.begin + fs_per_sec : fs_min;
+  auto elapsed = static_cast<std::ptrdiff_t>(count) - _table->before_gps_epoch;
+  _gps.shift = utc_gps_epoch_offset - elapsed * fs_per_sec;
+}
+
+/** @brief Move the UTC segment to the one holding `key` */
+void leap_cursor_t::SeekUTC(femtosecs_t key)
+{
+  const auto &index = _table->utc;
+  std::size_t count = index.count_through(key);
+  _utc.begin = count > 0 ? index[count - 1] : fs_min;
+  _utc.end = count < index.size() ? index[count] : fs_max;
+  _utc_elapsed = static_cast<std::ptrdiff_t>(count) - _table->before_gps_epoch;
+  _utc.shift = _utc_elapsed * fs_per_sec - utc_gps_epoch_offset;
+}
+
+/** @brief Throw if a batch's input and output sizes differ */
+static void check_sizes(const char *name, std::size_t input,
+                        std::size_t output)
+{
+  if (input != output) {
+    auto msg = fmt::format("{}: {} inputs but room for {} outputs",
+                           name, input, output);
+    throw std::runtime_error(msg);
+  }
+}
+
+void ToUTC(std::span<const gps_time_t> gps_times,
+           std::span<utc_time_t> utc_times)
+{
+  check_sizes("ToUTC", gps_times.size(), utc_times.size());
+  leap_cursor_t cursor;
+  for (std::size_t i = 0; i < gps_times.size(); i++) {
+    utc_times[i] = cursor.ToUTC(gps_times[i]);
+  }
+}
+
+void FromUTC(std::span<const utc_time_t> utc_times,
+             std::span<gps_time_t> gps_times)
+{
+  check_sizes("FromUTC", utc_times.size(), gps_times.size());
+  leap_cursor_t cursor;
+  for (std::size_t i = 0; i < utc_times.size(); i++) {
+    gps_times[i] = cursor.FromUTC(utc_times[i]);
+  }
+}
+
+void LeapSecondsBetween(std::span<const utc_time_t> times1,
+                        std::span<const utc_time_t> times2,
+                        std::span<int> leap_seconds)
+{
+  check_sizes("LeapSecondsBetween", times1.size(), times2.size());
+  check_sizes("LeapSecondsBetween", times1.size(), leap_seconds.size());
+  // Both sides share the table, but each has its own segment
+  const auto &table = CurrentLeapTable();
+  leap_cursor_t cursor1(table);
+  leap_cursor_t cursor2(table);
+  for (std::size_t i = 0; i < times1.size(); i++) {
+    leap_seconds[i] = cursor2.Elapsed(times2[i]) - cursor1.Elapsed(times1[i]);
+  }
+}
+
+} /** namespace femtotime */
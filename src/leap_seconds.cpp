@@ -0,0 +1,183 @@
+/**
+ * @file leap_seconds.cpp
+ * @brief Loading and publishing leap-second tables at runtime
+ * @date 16 Oct 2026
+ */
+
+// [femtotime headers]
+#include "femtotime/leap_seconds.hpp"
+#include "femtotime/calendar.hpp"
+#include "femtotime/time_split.hpp"
+
+// [C++ headers]
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace std;
+
+namespace femtotime {
+
+/**
+ * @brief The table the conversions use. Constant-initialized, so it can be
+ * read from static initializers in other translation units.
+ */
+static std::atomic<const leap_table_t *> active_leap_table{&builtin_leap_table};
+
+const leap_table_t &CurrentLeapTable()
+{
+  return *active_leap_table.load(std::memory_order_acquire);
+}
+
+void SetLeapSeconds(std::span<const leap_date_t> dates)
+{
+  // Readers may still hold a pointer to any table that was ever published, so
+  // published tables are kept until exit. The list is leaked on purpose so
+  // that it outlives any detached reader threads.
+  static std::mutex mutex;
+  static auto *published = new std::vector<std::unique_ptr<leap_table_t>>();
+
+  auto table = std::make_unique<leap_table_t>(dates);
+  std::lock_guard<std::mutex> lock(mutex);
+  active_leap_table.store(table.get(), std::memory_order_release);
+  published->push_back(std::move(table));
+}
+
+void ResetLeapSeconds()
+{
+  active_leap_table.store(&builtin_leap_table, std::memory_order_release);
+}
+
+/** @brief Seconds between the NTP epoch (1900) and the UTC epoch (1970) */
+static constexpr int64_t ntp_utc_offset = 2'208'988'800;
+
+/** @brief If a line is blank or a comment */
+static bool skip_line(std::string_view line)
+{
+  auto start = line.find_first_not_of(" \t\r");
+  return start == std::string_view::npos || line[start] == '#';
+}
+
+std::vector<leap_date_t> ParseLeapSecondsList(std::istream &input)
+{
+  std::vector<leap_date_t> dates;
+  std::string line;
+  int line_number = 0;
+  bool have_offset = false;
+  long previous_offset = 0;
+  while (std::getline(input, line)) {
+    line_number++;
+    if (skip_line(line)) {
+      continue;
+    }
+    std::istringstream fields(line);
+    int64_t ntp_secs;
+    long offset;
+    if (!(fields >> ntp_secs >> offset)) {
+      auto msg = fmt::format("Cannot parse line {} of leap-seconds list: '{}'",
+                             line_number, line);
+      throw std::runtime_error(msg);
+    }
+    auto [days, sec_of_day] = euclidean_div(ntp_secs - ntp_utc_offset,
+                                            secs_per_day_64);
+    if (sec_of_day != 0) {
+      auto msg = fmt::format("Leap-seconds list line {} is not at midnight",
+                             line_number);
+      throw std::runtime_error(msg);
+    }
+    // The first entry is the initial TAI-UTC offset, not a leap second
+    if (have_offset) {
+      if (offset != previous_offset + 1) {
+        auto msg = fmt::format("Unsupported TAI-UTC change from {} to {} on "
+                               "line {} of leap-seconds list",
+                               previous_offset, offset, line_number);
+        throw std::runtime_error(msg);
+      }
+      // The entry is the midnight after the leap second
+      auto [year, month, day] = civil_from_days(days - 1, utc_y2000_epoch);
+      dates.push_back({year, month, day});
+    }
+    have_offset = true;
+    previous_offset = offset;
+  }
+  return dates;
+}
+
+std::vector<leap_date_t> ParseTzdataLeapSeconds(std::istream &input)
+{
+  static constexpr std::array<std::string_view, 12> month_names = {
+    "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+    "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+  };
+  std::vector<leap_date_t> dates;
+  std::string line;
+  int line_number = 0;
+  while (std::getline(input, line)) {
+    line_number++;
+    if (skip_line(line)) {
+      continue;
+    }
+    std::istringstream fields(line);
+    std::string keyword, month_name, time, correction;
+    int year, day;
+    fields >> keyword;
+    if (keyword == "Expires") {
+      continue;
+    }
+    fields >> year >> month_name >> day >> time >> correction;
+    auto month = std::find(month_names.begin(), month_names.end(), month_name);
+    if (!fields || keyword != "Leap" || month == month_names.end()
+        || time != "23:59:60") {
+      auto msg = fmt::format("Cannot parse line {} of tzdata leapseconds: '{}'",
+                             line_number, line);
+      throw std::runtime_error(msg);
+    }
+    if (correction != "+") {
+      auto msg = fmt::format("Unsupported negative leap second on line {} of "
+                             "tzdata leapseconds", line_number);
+      throw std::runtime_error(msg);
+    }
+    int month_number = month - month_names.begin() + 1;
+    dates.push_back({year, month_number, day});
+  }
+  return dates;
+}
+
+void LoadLeapSecondsFile(const std::string &path)
+{
+  std::ifstream file(path);
+  if (!file) {
+    auto msg = fmt::format("Cannot open leap-seconds file '{}'", path);
+    throw std::runtime_error(msg);
+  }
+  std::stringstream contents;
+  contents << file.rdbuf();
+
+  // tzdata files are made of `Leap` (and `Expires`) lines; the IETF list is
+  // made of numbers
+  std::string line, keyword;
+  while (std::getline(contents, line) && skip_line(line)) {
+  }
+  std::istringstream(line) >> keyword;
+  bool is_tzdata = keyword == "Leap" || keyword == "Expires";
+  contents.clear();
+  contents.seekg(0);
+  auto dates = is_tzdata ? ParseTzdataLeapSeconds(contents)
+                         : ParseLeapSecondsList(contents);
+  if (dates.empty()) {
+    auto msg = fmt::format("No leap seconds in '{}'", path);
+    throw std::runtime_error(msg);
+  }
+  SetLeapSeconds(dates);
+}
+
+} /** namespace femtotime */
@@ -0,0 +1,70 @@
+/**
+ * @file thread_chunks.hpp
+ * @brief Splitting the rows of a column across threads
+ * @date 16 Oct 2026
+ *
+ * An internal header shared by the column routines that take a `threads`
+ * argument; it is not installed.
+ */
+#pragma once
+
+// [C++ headers]
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// [Namespaces]
+namespace femtotime {
+
+/** @brief The fewest rows worth starting another thread for */
+constexpr std::size_t rows_per_thread = 65'536;
+
+/**
+ * @brief How many parts to split `rows` rows into for `threads` threads, 0
+ * meaning one per hardware thread, so each has at least `min_rows` rows
+ */
+inline std::size_t chunk_count(std::size_t rows, unsigned threads,
+                               std::size_t min_rows = rows_per_thread)
+{
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  return std::clamp<std::size_t>(rows / min_rows, 1, threads);
+}
+
+/**
+ * @brief Call `chunk(c, begin, end)` for each of `chunks` equal parts of
+ * `[0, rows)`, each on its own thread but the first, and wait for them all.
+ *
+ * `chunk` is called concurrently, so it must be safe to. If any call
+ * throws, the others still run to the end, and then the exception from the
+ * first part that threw is rethrown here.
+ */
+template <typename F>
+void run_chunks(std::size_t rows, std::size_t chunks, F &&chunk)
+{
+  std::vector<std::exception_ptr> errors(chunks);
+  auto run = [&](std::size_t c) {
+    try {
+      chunk(c, rows * c / chunks, rows * (c + 1) / chunks);
+    } catch (...) {
+      errors[c] = std::current_exception();
+    }
+  };
+  {
+    std::vector<std::jthread> workers;
+    for (std::size_t c = 1; c < chunks; c++) {
+      workers.emplace_back(run, c);
+    }
+    run(0);
+  }
+  for (const auto &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+} /** namespace femtotime */
@@ -0,0 +1,235 @@
+/**
+ * @file time_bucket.cpp
+ * @brief Rounding times to a grid, and bucketing them by grid or calendar
+ * @date 16 Oct 2026
+ */
+
+// [femtotime headers]
+#include "femtotime/time_bucket.hpp"
+#include "femtotime/calendar.hpp"
+#include "femtotime/leap_cursor.hpp"
+#include "thread_chunks.hpp"
+
+// [C++ headers]
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace std;
+
+namespace femtotime {
+
+namespace {
+
+/**
+ * @brief The fewest times per bin, on average, for `time_grid_t::Bins` to
+ * bin a run at a time
+ */
+constexpr std::size_t dense_bin_size = 4;
+
+/** @brief Throw if a batch's input and output sizes differ */
+void check_sizes(const char *name, std::size_t input, std::size_t output)
+{
+  if (input != output) {
+    auto msg = fmt::format("{}: {} times but room for {} bins", name, input,
+                           output);
+    throw std::runtime_error(msg);
+  }
+}
+
+/** @brief The UTC day holding a UTC time, counted from the UTC epoch */
+int64_t utc_day(const utc_time_t &time)
+{
+  return euclidean_div(split_secs(time.get_fs()).secs, secs_per_day_64).first;
+}
+
+/** @brief The calendar bin holding UTC day `day` */
+int64_t bin_of_day(int64_t day, calendar_unit_t unit)
+{
+  if (unit == calendar_unit_t::day) {
+    return day;
+  }
+  auto [year, month, day_of_month] = civil_from_days(day, utc_y2000_epoch);
+  if (unit == calendar_unit_t::month) {
+    return (int64_t{year} - 1970) * 12 + month - 1;
+  }
+  return int64_t{year} - 1970;
+}
+
+/** @brief The UTC day that calendar bin `bin` starts on */
+int64_t first_day(int64_t bin, calendar_unit_t unit)
+{
+  switch (unit) {
+  case calendar_unit_t::day:
+    return bin;
+  case calendar_unit_t::month: {
+    auto [years, month] = euclidean_div(bin, 12);
+    return days_from_civil(1970 + years, month + 1, 1, utc_y2000_epoch);
+  }
+  case calendar_unit_t::year:
+    break;
+  }
+  return days_from_civil(1970 + bin, 1, 1, utc_y2000_epoch);
+}
+
+/** @brief Midnight UTC at the start of UTC day `day` */
+utc_time_t utc_midnight(int64_t day)
+{
+  return utc_time_t(femtosecs_t(day) * fs_per_day);
+}
+
+/**
+ * @class calendar_cursor_t
+ *
+ * Bins times by calendar, remembering the GPS times that the last bin
+ * starts and ends at, so that a time in the same bin as the one before it
+ * costs two comparisons. Like the `leap_cursor_t` it converts with, it is
+ * not thread-safe.
+ */
+class calendar_cursor_t
+{
+public:
+  explicit calendar_cursor_t(calendar_unit_t unit) : _unit(unit)
+  {}
+
+  int64_t Bin(const gps_time_t &time)
+  {
+    auto fs = time.get_fs();
+    if (fs < _begin || fs >= _end) {
+      Seek(time);
+    }
+    return _bin;
+  }
+
+private:
+  void Seek(const gps_time_t &time)
+  {
+    _bin = bin_of_day(utc_day(_leaps.ToUTC(time)), _unit);
+    _begin = _leaps.FromUTC(utc_midnight(first_day(_bin, _unit))).get_fs();
+    _end = _leaps.FromUTC(utc_midnight(first_day(_bin + 1, _unit))).get_fs();
+  }
+
+  calendar_unit_t _unit;
+  leap_cursor_t _leaps;
+  femtosecs_t _begin = std::numeric_limits<femtosecs_t>::max();
+  femtosecs_t _end = std::numeric_limits<femtosecs_t>::min();
+  int64_t _bin = 0;
+};
+
+} // namespace
+
+time_grid_t::time_grid_t(duration_t width, gps_time_t origin)
+  : _width(width), _origin(origin)
+{
+  if (width.get_fs() <= 0) {
+    char buffer[time_string_capacity];
+    auto end = width.FormatTo(buffer);
+    auto msg = fmt::format("time_grid_t: the width {} is not positive",
+                           std::string_view(buffer, end - buffer));
+    throw std::runtime_error(msg);
+  }
+  auto magnitude = static_cast<uint128_t>(width.get_fs());
+  auto low = static_cast<uint64_t>(magnitude);
+  auto high = static_cast<uint64_t>(magnitude >> 64);
+  _shift = low != 0 ? std::countr_zero(low) : 64 + std::countr_zero(high);
+  auto divisor = magnitude >> _shift;
+  if (divisor >> 64 == 0) {
+    _reciprocal.emplace(static_cast<uint64_t>(divisor));
+  }
+}
+
+std::pair<int64_t, femtosecs_t> time_grid_t::slow_divide(femtosecs_t offset)
+  const
+{
+  auto quot = offset / _width.get_fs();
+  auto rem = offset % _width.get_fs();
+  if (rem < 0) {
+    quot -= 1;
+    rem += _width.get_fs();
+  }
+  return {static_cast<int64_t>(quot), rem};
+}
+
+void time_grid_t::Bins(std::span<const gps_time_t> times,
+                       std::span<int64_t> bins, unsigned threads) const
+{
+  check_sizes("time_grid_t::Bins", times.size(), bins.size());
+  run_chunks(times.size(), chunk_count(times.size(), threads),
+             [&](std::size_t, std::size_t begin, std::size_t end) {
+    // A copy, since the stores to `bins` could otherwise change the
+    // reciprocal as far as the compiler knows, and it would be loaded again
+    // for every time
+    auto grid = *this;
+    if (begin == end) {
+      return;
+    }
+    // A sorted series with a few times to a bin is binned a run at a time,
+    // reusing the last bin while the times stay in it. Otherwise each time
+    // is divided on its own, which leaves the divisions independent of each
+    // other so that they overlap
+    auto spanned = grid.Bin(times[end - 1]) - grid.Bin(times[begin]);
+    if (spanned < 0 || static_cast<uint64_t>(spanned) >
+        (end - begin) / dense_bin_size) {
+      for (auto i = begin; i < end; i++) {
+        bins[i] = grid.Bin(times[i]);
+      }
+      return;
+    }
+    auto first = std::numeric_limits<femtosecs_t>::max();
+    auto last = std::numeric_limits<femtosecs_t>::min();
+    int64_t bin = 0;
+    for (auto i = begin; i < end; i++) {
+      auto fs = times[i].get_fs();
+      if (fs < first || fs >= last) {
+        auto [quot, rem] = grid.Divide(times[i]);
+        bin = quot;
+        first = fs - rem;
+        last = first + grid._width.get_fs();
+      }
+      bins[i] = bin;
+    }
+  });
+}
+
+int64_t CalendarBin(const gps_time_t &time, calendar_unit_t unit)
+{
+  return bin_of_day(utc_day(time.ToUTC()), unit);
+}
+
+gps_time_t CalendarStart(int64_t bin, calendar_unit_t unit)
+{
+  return gps_time_t::FromUTC(utc_midnight(first_day(bin, unit)));
+}
+
+gps_time_t CalendarFloor(const gps_time_t &time, calendar_unit_t unit)
+{
+  return CalendarStart(CalendarBin(time, unit), unit);
+}
+
+gps_time_t CalendarCeil(const gps_time_t &time, calendar_unit_t unit)
+{
+  auto bin = CalendarBin(time, unit);
+  auto start = CalendarStart(bin, unit);
+  return start == time ? time : CalendarStart(bin + 1, unit);
+}
+
+void CalendarBins(std::span<const gps_time_t> times, std::span<int64_t> bins,
+                  calendar_unit_t unit, unsigned threads)
+{
+  check_sizes("CalendarBins", times.size(), bins.size());
+  run_chunks(times.size(), chunk_count(times.size(), threads),
+             [&](std::size_t, std::size_t begin, std::size_t end) {
+    calendar_cursor_t cursor(unit);
+    for (auto i = begin; i < end; i++) {
+      bins[i] = cursor.Bin(times[i]);
+    }
+  });
+}
+
+} /** namespace femtotime */
@@ -0,0 +1,510 @@
+/**
+ * @file time_codec.cpp
+ * @brief Compressed storage for columns of gps_time_t
+ * @date 16 Oct 2026
+ *
+ * A column is its blocks back to back, then a footer of the blocks' offsets
+ * (8 bytes each), the number of times (8 bytes), the number of blocks (8
+ * bytes) and a magic number (4 bytes). A block is:
+ *
+ *  - its number of times (2 bytes) and its kind (1 byte);
+ *  - its first time (16 bytes);
+ *  - if it has more than one time, either the rest of its times (raw
+ *    blocks), or its first difference (16 bytes) and then, for each group of
+ *    up to `time_group_size` delta-of-deltas, their bit width (1 byte) and
+ *    the zigzag-encoded values, packed least significant bit first.
+ *
+ * The bit unpacking reads whole words, up to 15 bytes past the end of a
+ * group; the footer is always longer than that, so it never reads past the
+ * end of the column.
+ */
+
+// [femtotime headers]
+#include "femtotime/time_codec.hpp"
+
+// [C++ headers]
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define FEMTOTIME_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace std;
+
+namespace femtotime {
+
+namespace {
+
+/** @brief "FTC1" */
+constexpr uint32_t column_magic = 0x31435446;
+
+constexpr std::size_t footer_size = 8 + 8 + 4;
+
+/** @brief How a block's times after the first are stored */
+enum block_kind_t : uint8_t
+{
+  /** @brief Every time is within 2^63 fs of the first */
+  packed_narrow = 0,
+
+  /** @brief Packed, but needing 128-bit arithmetic to decode */
+  packed_wide = 1,
+
+  /** @brief As 16-byte times */
+  raw = 2,
+};
+
+static_assert(std::endian::native == std::endian::little
+              || std::endian::native == std::endian::big);
+
+inline uint64_t load_u64(const uint8_t *in)
+{
+  uint64_t value;
+  std::memcpy(&value, in, sizeof(value));
+  if constexpr (std::endian::native == std::endian::big) {
+    value = __builtin_bswap64(value);
+  }
+  return value;
+}
+
+inline void store_u64(std::vector<uint8_t> &out, uint64_t value)
+{
+  for (int i = 0; i < 8; i++) {
+    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+inline femtosecs_t load_fs(const uint8_t *in)
+{
+  auto low = load_u64(in);
+  auto high = load_u64(in + 8);
+  return static_cast<femtosecs_t>((static_cast<uint128_t>(high) << 64) | low);
+}
+
+inline void store_fs(std::vector<uint8_t> &out, femtosecs_t value)
+{
+  auto bits = static_cast<uint128_t>(value);
+  store_u64(out, static_cast<uint64_t>(bits));
+  store_u64(out, static_cast<uint64_t>(bits >> 64));
+}
+
+/** @brief Append `count` values of `width` bits each */
+void pack_bits(const uint64_t *values, std::size_t count, int width,
+               std::vector<uint8_t> &out)
+{
+  if (width == 0) {
+    return;
+  }
+  uint128_t buffer = 0;
+  int bits = 0;
+  for (std::size_t i = 0; i < count; i++) {
+    buffer |= static_cast<uint128_t>(values[i]) << bits;
+    bits += width;
+    for (; bits >= 8; bits -= 8) {
+      out.push_back(static_cast<uint8_t>(buffer));
+      buffer >>= 8;
+    }
+  }
+  if (bits > 0) {
+    out.push_back(static_cast<uint8_t>(buffer));
+  }
+}
+
+/** @brief The bytes `count` values of `width` bits take */
+constexpr std::size_t packed_bytes(std::size_t count, int width)
+{
+  return (count * width + 7) / 8;
+}
+
+/**
+ * @brief Read `count` values of `width` bits each, one at a time, starting
+ * `bit` bits into `in`
+ */
+void unpack_from(const uint8_t *in, std::size_t bit, std::size_t count,
+                 int width, uint64_t *out)
+{
+  if (width == 0) {
+    std::fill_n(out, count, 0);
+    return;
+  }
+  uint64_t mask = width == 64 ? ~uint64_t{0} : (uint64_t{1} << width) - 1;
+  if (width <= 56) {
+    // A value and its offset into its first byte fit in one word
+    for (std::size_t i = 0; i < count; i++, bit += width) {
+      out[i] = (load_u64(in + bit / 8) >> (bit % 8)) & mask;
+    }
+    return;
+  }
+  for (std::size_t i = 0; i < count; i++, bit += width) {
+    auto low = load_u64(in + bit / 8);
+    auto high = load_u64(in + bit / 8 + 8);
+    auto word = (static_cast<uint128_t>(high) << 64) | low;
+    out[i] = static_cast<uint64_t>(word >> (bit % 8)) & mask;
+  }
+}
+
+/** @brief Read `count` values of `width` bits each, one at a time */
+void unpack_scalar(const uint8_t *in, std::size_t count, int width,
+                   uint64_t *out)
+{
+  unpack_from(in, 0, count, width, out);
+}
+
+#ifdef FEMTOTIME_X86_KERNELS
+/**
+ * @brief Read `count` values of `width` bits each, four at a time: gather
+ * the word each starts in, then shift and mask
+ */
+__attribute__((target("avx2")))
+void unpack_avx2(const uint8_t *in, std::size_t count, int width,
+                 uint64_t *out)
+{
+  if (width == 0 || width > 56) {
+    unpack_scalar(in, count, width, out);
+    return;
+  }
+  auto w = static_cast<long long>(width);
+  __m256i mask = _mm256_set1_epi64x((1LL << width) - 1);
+  __m256i seven = _mm256_set1_epi64x(7);
+  __m256i step = _mm256_set1_epi64x(4 * w);
+  __m256i bit = _mm256_setr_epi64x(0, w, 2 * w, 3 * w);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i words = _mm256_i64gather_epi64(
+      reinterpret_cast<const long long *>(in), _mm256_srli_epi64(bit, 3), 1);
+    __m256i values = _mm256_and_si256(
+      _mm256_srlv_epi64(words, _mm256_and_si256(bit, seven)), mask);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), values);
+    bit = _mm256_add_epi64(bit, step);
+  }
+  unpack_from(in, i * width, count - i, width, out + i);
+}
+#endif
+
+using unpack_fn = void (*)(const uint8_t *, std::size_t, int, uint64_t *);
+
+unpack_fn select_unpack(codec_kernel_t kernel)
+{
+  kernel = std::min(kernel, SupportedCodecKernel());
+#ifdef FEMTOTIME_X86_KERNELS
+  if (kernel == codec_kernel_t::avx2) {
+    return unpack_avx2;
+  }
+#endif
+  return unpack_scalar;
+}
+
+/** @brief The inverse of the zigzag encoding, as a 64-bit pattern */
+inline uint64_t unzigzag(uint64_t value)
+{
+  return (value >> 1) ^ (0 - (value & 1));
+}
+
+void encode_block(std::span<const femtosecs_t> times,
+                  std::vector<uint8_t> &out)
+{
+  auto count = times.size();
+  out.push_back(static_cast<uint8_t>(count));
+  out.push_back(static_cast<uint8_t>(count >> 8));
+  auto kind_at = out.size();
+  out.push_back(raw);
+  store_fs(out, times[0]);
+  if (count == 1) {
+    return;
+  }
+
+  // The delta-of-deltas, if they all fit in 64 bits once zigzag-encoded
+  std::array<uint64_t, time_block_size> zigzags;
+  femtosecs_t first_delta;
+  bool packable = !__builtin_sub_overflow(times[1], times[0], &first_delta);
+  auto previous = first_delta;
+  for (std::size_t i = 2; packable && i < count; i++) {
+    femtosecs_t delta;
+    femtosecs_t dod;
+    packable = !__builtin_sub_overflow(times[i], times[i - 1], &delta)
+      && !__builtin_sub_overflow(delta, previous, &dod);
+    if (!packable) {
+      break;
+    }
+    auto zigzag = (static_cast<uint128_t>(dod) << 1)
+      ^ static_cast<uint128_t>(dod >> 127);
+    packable = packable && (zigzag >> 64) == 0;
+    zigzags[i - 2] = static_cast<uint64_t>(zigzag);
+    previous = delta;
+  }
+  if (!packable) {
+    for (std::size_t i = 1; i < count; i++) {
+      store_fs(out, times[i]);
+    }
+    return;
+  }
+
+  bool narrow = true;
+  for (std::size_t i = 1; i < count; i++) {
+    femtosecs_t offset;
+    narrow = narrow && !__builtin_sub_overflow(times[i], times[0], &offset)
+      && offset == static_cast<int64_t>(offset);
+  }
+  out[kind_at] = narrow ? packed_narrow : packed_wide;
+  store_fs(out, first_delta);
+  for (std::size_t begin = 0; begin < count - 2; begin += time_group_size) {
+    auto group = std::min(time_group_size, count - 2 - begin);
+    uint64_t all_bits = 0;
+    for (std::size_t i = 0; i < group; i++) {
+      all_bits |= zigzags[begin + i];
+    }
+    auto width = std::bit_width(all_bits);
+    out.push_back(static_cast<uint8_t>(width));
+    pack_bits(&zigzags[begin], group, width, out);
+  }
+}
+
+[[noreturn]] void throw_corrupt(const char *what)
+{
+  auto msg = fmt::format("time_column_t: corrupt column ({})", what);
+  throw std::runtime_error(msg);
+}
+
+/**
+ * @brief Decode the block in `[in, end)`, which should have `count` times,
+ * into `times`
+ */
+void decode_block(const uint8_t *in, const uint8_t *end, std::size_t count,
+                  gps_time_t *times, unpack_fn unpack)
+{
+  auto need = [&](std::size_t bytes) {
+    if (static_cast<std::size_t>(end - in) < bytes) {
+      throw_corrupt("block is truncated");
+    }
+  };
+  need(3 + 16);
+  if (in[0] + (std::size_t{in[1]} << 8) != count) {
+    throw_corrupt("wrong block length");
+  }
+  auto kind = in[2];
+  auto first = load_fs(in + 3);
+  in += 3 + 16;
+  times[0] = gps_time_t(first);
+  if (count == 1) {
+    if (in != end) {
+      throw_corrupt("block has trailing bytes");
+    }
+    return;
+  }
+
+  if (kind == raw) {
+    need((count - 1) * 16);
+    for (std::size_t i = 1; i < count; i++, in += 16) {
+      times[i] = gps_time_t(load_fs(in));
+    }
+  } else if (kind == packed_narrow || kind == packed_wide) {
+    need(16);
+    auto first_delta = load_fs(in);
+    in += 16;
+    uint64_t zigzags[time_block_size];
+    for (std::size_t begin = 0; begin < count - 2;
+         begin += time_group_size) {
+      auto group = std::min(time_group_size, count - 2 - begin);
+      need(1);
+      int width = *in++;
+      if (width > 64) {
+        throw_corrupt("bit width over 64");
+      }
+      need(packed_bytes(group, width));
+      unpack(in, group, width, zigzags + begin);
+      in += packed_bytes(group, width);
+    }
+
+    if (kind == packed_narrow) {
+      // Wrapping 64-bit sums give the exact offsets, which fit
+      auto delta = static_cast<uint64_t>(first_delta);
+      uint64_t offset = delta;
+      times[1] = gps_time_t(first + static_cast<int64_t>(offset));
+      for (std::size_t i = 2; i < count; i++) {
+        delta += unzigzag(zigzags[i - 2]);
+        offset += delta;
+        times[i] = gps_time_t(first + static_cast<int64_t>(offset));
+      }
+    } else {
+      auto delta = first_delta;
+      auto time = first + delta;
+      times[1] = gps_time_t(time);
+      for (std::size_t i = 2; i < count; i++) {
+        delta += static_cast<int64_t>(unzigzag(zigzags[i - 2]));
+        time += delta;
+        times[i] = gps_time_t(time);
+      }
+    }
+  } else {
+    throw_corrupt("unknown block kind");
+  }
+  if (in != end) {
+    throw_corrupt("block has trailing bytes");
+  }
+}
+
+} // namespace
+
+codec_kernel_t SupportedCodecKernel()
+{
+#ifdef FEMTOTIME_X86_KERNELS
+  static const codec_kernel_t supported = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? codec_kernel_t::avx2
+                                          : codec_kernel_t::scalar;
+  }();
+  return supported;
+#else
+  return codec_kernel_t::scalar;
+#endif
+}
+
+void time_column_encoder_t::Append(std::span<const gps_time_t> times)
+{
+  for (const auto &time : times) {
+    Append(time);
+  }
+}
+
+void time_column_encoder_t::EncodeBlock()
+{
+  _block_offsets.push_back(_data.size());
+  encode_block(_pending, _data);
+  _count += _pending.size();
+  _pending.clear();
+}
+
+std::vector<uint8_t> time_column_encoder_t::Finish()
+{
+  if (!_pending.empty()) {
+    EncodeBlock();
+  }
+  for (auto offset : _block_offsets) {
+    store_u64(_data, offset);
+  }
+  store_u64(_data, _count);
+  store_u64(_data, _block_offsets.size());
+  for (int i = 0; i < 4; i++) {
+    _data.push_back(static_cast<uint8_t>(column_magic >> (8 * i)));
+  }
+  auto data = std::move(_data);
+  *this = time_column_encoder_t();
+  return data;
+}
+
+std::vector<uint8_t> EncodeTimeColumn(std::span<const gps_time_t> times)
+{
+  time_column_encoder_t encoder;
+  encoder.Append(times);
+  return encoder.Finish();
+}
+
+time_column_t::time_column_t(std::span<const uint8_t> data) : _data(data)
+{
+  if (data.size() < footer_size) {
+    throw_corrupt("too short for a footer");
+  }
+  auto footer = data.data() + data.size() - footer_size;
+  uint32_t magic = 0;
+  for (int i = 3; i >= 0; i--) {
+    magic = (magic << 8) | footer[16 + i];
+  }
+  if (magic != column_magic) {
+    throw_corrupt("bad magic number");
+  }
+  _count = load_u64(footer);
+  _block_count = load_u64(footer + 8);
+  if (_block_count != (_count + time_block_size - 1) / time_block_size
+      || _block_count > (data.size() - footer_size) / 8) {
+    throw_corrupt("bad counts");
+  }
+  _offsets = footer - 8 * _block_count;
+  // Blocks are in order and before the block table
+  uint64_t previous = 0;
+  for (std::size_t b = 0; b < _block_count; b++) {
+    auto offset = load_u64(_offsets + 8 * b);
+    if ((b == 0 && offset != 0) || offset < previous
+        || offset > static_cast<uint64_t>(_offsets - data.data())) {
+      throw_corrupt("bad block offsets");
+    }
+    previous = offset;
+  }
+}
+
+gps_time_t time_column_t::operator[](std::size_t index) const
+{
+  if (index >= _count) {
+    auto msg = fmt::format("time_column_t: index {} is past the {} times",
+                           index, _count);
+    throw std::runtime_error(msg);
+  }
+  gps_time_t block[time_block_size];
+  DecodeBlock(index / time_block_size, block);
+  return block[index % time_block_size];
+}
+
+std::size_t time_column_t::DecodeBlock(std::size_t block,
+                                       std::span<gps_time_t> times,
+                                       codec_kernel_t kernel) const
+{
+  if (block >= _block_count) {
+    auto msg = fmt::format("time_column_t: block {} is past the {} blocks",
+                           block, _block_count);
+    throw std::runtime_error(msg);
+  }
+  auto count = std::min(time_block_size, _count - block * time_block_size);
+  if (times.size() < count) {
+    auto msg = fmt::format("time_column_t: block {} has {} times but there "
+                           "is room for {}", block, count, times.size());
+    throw std::runtime_error(msg);
+  }
+  auto begin = _data.data() + load_u64(_offsets + 8 * block);
+  auto end = block + 1 < _block_count
+    ? _data.data() + load_u64(_offsets + 8 * (block + 1)) : _offsets;
+  decode_block(begin, end, count, times.data(), select_unpack(kernel));
+  return count;
+}
+
+void time_column_t::Decode(std::size_t first, std::span<gps_time_t> times,
+                           codec_kernel_t kernel) const
+{
+  if (first > _count || times.size() > _count - first) {
+    auto msg = fmt::format("time_column_t: times {} to {} are past the {} "
+                           "times", first, first + times.size(), _count);
+    throw std::runtime_error(msg);
+  }
+  gps_time_t partial[time_block_size];
+  std::size_t done = 0;
+  while (done < times.size()) {
+    auto index = first + done;
+    auto block = index / time_block_size;
+    auto skip = index % time_block_size;
+    auto remaining = times.size() - done;
+    if (skip == 0 && remaining >= time_block_size) {
+      done += DecodeBlock(block, times.subspan(done), kernel);
+      continue;
+    }
+    auto count = DecodeBlock(block, partial, kernel);
+    auto take = std::min(count - skip, remaining);
+    std::copy_n(partial + skip, take, times.begin() + done);
+    done += take;
+  }
+}
+
+std::vector<gps_time_t> time_column_t::Decode(codec_kernel_t kernel) const
+{
+  std::vector<gps_time_t> times(_count);
+  Decode(0, times, kernel);
+  return times;
+}
+
+} /** namespace femtotime */
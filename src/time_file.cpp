@@ -0,0 +1,305 @@
+/**
+ * @file time_file.cpp
+ * @brief Memory-mapped files of sorted gps_time_t columns
+ * @date 16 Oct 2026
+ *
+ * The header is, with every number little-endian:
+ *
+ *  - the magic bytes "FTIMECOL" and the format version (4 bytes);
+ *  - the header size (4 bytes), the number of times (8 bytes) and the number
+ *    of times per index entry (8 bytes);
+ *  - the offset and number of index entries (8 bytes each);
+ *  - the offset of the times (8 bytes), then 8 reserved bytes.
+ *
+ * Each index entry is the first and last time of its run (16 bytes each).
+ */
+
+// [femtotime headers]
+#include "femtotime/time_file.hpp"
+
+// [C++ headers]
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// [POSIX headers]
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace std;
+
+namespace femtotime {
+
+namespace {
+
+constexpr std::array<char, 8> file_magic = {'F', 'T', 'I', 'M',
+                                            'E', 'C', 'O', 'L'};
+constexpr uint32_t file_version = 1;
+constexpr std::size_t header_size = 64;
+constexpr std::size_t entry_size = 32;
+
+/** @brief The times start on a page boundary, so mapping aligns them */
+constexpr std::size_t data_alignment = 4096;
+
+static_assert(sizeof(gps_time_t) == 16);
+
+inline void store_u64(char *out, uint64_t value)
+{
+  for (int i = 0; i < 8; i++) {
+    out[i] = static_cast<char>(value >> (8 * i));
+  }
+}
+
+inline void store_fs(char *out, femtosecs_t value)
+{
+  auto bits = static_cast<uint128_t>(value);
+  store_u64(out, static_cast<uint64_t>(bits));
+  store_u64(out + 8, static_cast<uint64_t>(bits >> 64));
+}
+
+inline uint64_t load_u64(const uint8_t *in)
+{
+  uint64_t value = 0;
+  for (int i = 7; i >= 0; i--) {
+    value = (value << 8) | in[i];
+  }
+  return value;
+}
+
+inline femtosecs_t load_fs(const uint8_t *in)
+{
+  auto low = load_u64(in);
+  auto high = load_u64(in + 8);
+  return static_cast<femtosecs_t>((static_cast<uint128_t>(high) << 64) | low);
+}
+
+constexpr std::size_t round_up(std::size_t value, std::size_t multiple)
+{
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+[[noreturn]] void throw_bad_file(const std::string &path, const char *what)
+{
+  auto msg = fmt::format("time_file_t: '{}' is not a time file ({})", path,
+                         what);
+  throw std::runtime_error(msg);
+}
+
+} // namespace
+
+void WriteTimeFile(const std::string &path, std::span<const gps_time_t> times,
+                   std::size_t index_stride)
+{
+  if (index_stride == 0) {
+    throw std::runtime_error("WriteTimeFile: the index stride is zero");
+  }
+  auto unsorted = std::is_sorted_until(times.begin(), times.end());
+  if (unsorted != times.end()) {
+    auto msg = fmt::format("WriteTimeFile: time {} is before the one before "
+                           "it", unsorted - times.begin());
+    throw std::runtime_error(msg);
+  }
+
+  auto entries = (times.size() + index_stride - 1) / index_stride;
+  auto data_offset = round_up(header_size + entries * entry_size,
+                              data_alignment);
+  std::vector<char> head(data_offset, 0);
+  std::copy(file_magic.begin(), file_magic.end(), head.begin());
+  uint64_t sizes = file_version | (uint64_t{header_size} << 32);
+  store_u64(&head[8], sizes);
+  store_u64(&head[16], times.size());
+  store_u64(&head[24], index_stride);
+  store_u64(&head[32], header_size);
+  store_u64(&head[40], entries);
+  store_u64(&head[48], data_offset);
+  for (std::size_t e = 0; e < entries; e++) {
+    auto first = e * index_stride;
+    auto last = std::min(first + index_stride, times.size()) - 1;
+    store_fs(&head[header_size + e * entry_size], times[first].get_fs());
+    store_fs(&head[header_size + e * entry_size + 16], times[last].get_fs());
+  }
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    auto msg = fmt::format("WriteTimeFile: cannot open '{}'", path);
+    throw std::runtime_error(msg);
+  }
+  file.write(head.data(), head.size());
+  std::vector<char> chunk(16 * std::min(times.size(), index_stride));
+  for (std::size_t begin = 0; begin < times.size(); begin += index_stride) {
+    auto end = std::min(begin + index_stride, times.size());
+    for (auto i = begin; i < end; i++) {
+      store_fs(&chunk[16 * (i - begin)], times[i].get_fs());
+    }
+    file.write(chunk.data(), 16 * (end - begin));
+  }
+  file.close();
+  if (!file) {
+    auto msg = fmt::format("WriteTimeFile: cannot write '{}'", path);
+    throw std::runtime_error(msg);
+  }
+}
+
+time_file_t::time_file_t(const std::string &path)
+{
+  if constexpr (std::endian::native != std::endian::little) {
+    auto msg = fmt::format("time_file_t: cannot map '{}' on a big-endian "
+                           "host", path);
+    throw std::runtime_error(msg);
+  }
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    auto msg = fmt::format("time_file_t: cannot open '{}': {}", path,
+                           std::strerror(errno));
+    throw std::runtime_error(msg);
+  }
+  struct stat status;
+  if (::fstat(fd, &status) != 0 || status.st_size < 0) {
+    ::close(fd);
+    auto msg = fmt::format("time_file_t: cannot stat '{}'", path);
+    throw std::runtime_error(msg);
+  }
+  auto file_size = static_cast<std::size_t>(status.st_size);
+  if (file_size < header_size) {
+    ::close(fd);
+    throw_bad_file(path, "too short");
+  }
+  void *map = ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED) {
+    auto msg = fmt::format("time_file_t: cannot map '{}': {}", path,
+                           std::strerror(errno));
+    throw std::runtime_error(msg);
+  }
+  _map = map;
+  _map_size = file_size;
+
+  // Unmap the file if a check below throws
+  struct unmap_on_throw_t
+  {
+    time_file_t *file;
+    ~unmap_on_throw_t()
+    {
+      if (file) {
+        ::munmap(file->_map, file->_map_size);
+      }
+    }
+  } guard{this};
+
+  auto bytes = static_cast<const uint8_t *>(map);
+  if (!std::equal(file_magic.begin(), file_magic.end(), bytes)) {
+    throw_bad_file(path, "bad magic bytes");
+  }
+  auto sizes = load_u64(bytes + 8);
+  if ((sizes & 0xffffffff) != file_version) {
+    throw_bad_file(path, "unknown version");
+  }
+  auto count = load_u64(bytes + 16);
+  auto stride = load_u64(bytes + 24);
+  auto index_offset = load_u64(bytes + 32);
+  auto entries = load_u64(bytes + 40);
+  auto data_offset = load_u64(bytes + 48);
+  if ((sizes >> 32) != header_size || index_offset != header_size
+      || stride == 0 || entries != count / stride + (count % stride != 0)
+      || entries > (file_size - header_size) / entry_size
+      || data_offset % 16 != 0
+      || data_offset < header_size + entries * entry_size
+      || data_offset > file_size
+      || count != (file_size - data_offset) / 16
+      || (file_size - data_offset) % 16 != 0) {
+    throw_bad_file(path, "sizes don't match");
+  }
+  guard.file = nullptr;
+  _index = bytes + index_offset;
+  _times = reinterpret_cast<const gps_time_t *>(bytes + data_offset);
+  _count = count;
+  _stride = stride;
+}
+
+time_file_t::time_file_t(time_file_t &&other) noexcept
+{
+  *this = std::move(other);
+}
+
+time_file_t &time_file_t::operator=(time_file_t &&other) noexcept
+{
+  if (this != &other) {
+    if (_map) {
+      ::munmap(_map, _map_size);
+    }
+    _map = std::exchange(other._map, nullptr);
+    _map_size = std::exchange(other._map_size, 0);
+    _index = std::exchange(other._index, nullptr);
+    _times = std::exchange(other._times, nullptr);
+    _count = std::exchange(other._count, 0);
+    _stride = std::exchange(other._stride, 0);
+  }
+  return *this;
+}
+
+time_file_t::~time_file_t()
+{
+  if (_map) {
+    ::munmap(_map, _map_size);
+  }
+}
+
+std::size_t time_file_t::Bound(const gps_time_t &time, bool upper) const
+{
+  auto fs = time.get_fs();
+  auto before = [&](femtosecs_t value) {
+    return upper ? value <= fs : value < fs;
+  };
+  // The first run whose last time isn't before the bound holds it
+  std::size_t low = 0;
+  std::size_t high = (_count + _stride - 1) / _stride;
+  while (low < high) {
+    auto middle = low + (high - low) / 2;
+    if (before(load_fs(_index + middle * entry_size + 16))) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  auto begin = low * _stride;
+  if (begin >= _count || !before(load_fs(_index + low * entry_size))) {
+    return std::min(begin, _count);
+  }
+  auto first = _times + begin;
+  auto last = _times + std::min(begin + _stride, _count);
+  auto found = upper ? std::upper_bound(first, last, time)
+                     : std::lower_bound(first, last, time);
+  return found - _times;
+}
+
+std::size_t time_file_t::lower_bound(const gps_time_t &time) const
+{
+  return Bound(time, false);
+}
+
+std::size_t time_file_t::upper_bound(const gps_time_t &time) const
+{
+  return Bound(time, true);
+}
+
+std::span<const gps_time_t> time_file_t::Range(const gps_time_t &begin,
+                                               const gps_time_t &end) const
+{
+  auto first = lower_bound(begin);
+  auto last = std::max(first, lower_bound(end));
+  return times().subspan(first, last - first);
+}
+
+} /** namespace femtotime */
@@ -0,0 +1,355 @@
+/**
+ * @file time_format_batch.cpp
+ * @brief Formatting whole columns of times into one buffer
+ * @date 16 Oct 2026
+ *
+ * A `record_writer_t` keeps the text of the date it last wrote and that
+ * day's bounds, so within a day each record is a copy of the date, the time
+ * of day from 64-bit arithmetic, and the fraction as 16 digits at once.
+ *
+ * Writing a record may touch up to `time_string_capacity` bytes from its
+ * start, past the end of a short record, which is harmless as the next
+ * record is written over them. Records too near the end of a thread's part
+ * of the buffer are written to a local buffer and copied instead.
+ */
+
+// [femtotime headers]
+#include "femtotime/time_format_batch.hpp"
+#include "femtotime/time_format.hpp"
+#include "femtotime/time_split.hpp"
+#include "thread_chunks.hpp"
+
+// [C++ headers]
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace std;
+
+namespace femtotime {
+
+namespace {
+
+/**
+ * @brief The fewest times worth starting another thread for; formatting
+ * costs more per row than the other column routines
+ */
+constexpr std::size_t rows_per_format_thread = 16'384;
+
+/** @brief The most characters a year beyond 0-9999 adds (`-2147483648`) */
+constexpr std::size_t max_extra_year_chars = 7;
+
+#ifdef __SSE2__
+/**
+ * @brief The 8 decimal digits of `value` (below 10^8), one per 16-bit lane,
+ * most significant first.
+ *
+ * Each half of the value is spread over four lanes and divided by 1000,
+ * 100, 10 and 1 with multiplies by reciprocals; taking away ten times the
+ * lane before leaves one digit per lane (the method of Wojciech Mula's and
+ * RapidJSON's SSE2 integer printing).
+ */
+inline __m128i digits_8(uint32_t value)
+{
+  // abcd, efgh = value divmod 10000
+  __m128i abcdefgh = _mm_cvtsi32_si128(static_cast<int>(value));
+  __m128i abcd = _mm_srli_epi64(
+    _mm_mul_epu32(abcdefgh, _mm_set1_epi32(static_cast<int>(0xd1b71759))),
+    45);
+  __m128i efgh = _mm_sub_epi32(abcdefgh,
+                               _mm_mul_epu32(abcd, _mm_set1_epi32(10000)));
+  // abcd * 4 in the low four lanes, efgh * 4 in the high four
+  __m128i spread = _mm_slli_epi64(_mm_unpacklo_epi16(abcd, efgh), 2);
+  spread = _mm_unpacklo_epi16(spread, spread);
+  spread = _mm_unpacklo_epi32(spread, spread);
+  // a, ab, abc, abcd, e, ef, efg, efgh
+  __m128i prefixes = _mm_mulhi_epu16(
+    _mm_mulhi_epu16(spread, _mm_setr_epi16(8389, 5243, 13108, -32768,
+                                           8389, 5243, 13108, -32768)),
+    _mm_setr_epi16(128, 2048, 8192, -32768, 128, 2048, 8192, -32768));
+  __m128i tens = _mm_slli_epi64(
+    _mm_mullo_epi16(prefixes, _mm_set1_epi16(10)), 16);
+  return _mm_sub_epi16(prefixes, tens);
+}
+#endif
+
+/** @brief Write the 16 decimal digits of `value` (below 10^16) */
+inline void write_16_digits(char *out, uint64_t value)
+{
+#ifdef __SSE2__
+  auto high = static_cast<uint32_t>(value / 100'000'000);
+  auto low = static_cast<uint32_t>(value % 100'000'000);
+  __m128i digits = _mm_packus_epi16(digits_8(high), digits_8(low));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                   _mm_add_epi8(digits, _mm_set1_epi8('0')));
+#else
+  write_digits(out, value, 16);
+#endif
+}
+
+/**
+ * @class record_writer_t
+ *
+ * Writes times in one format, as `T::FormatTo(out, format)` would, reusing
+ * the date text across times on the same day.
+ */
+template <typename T>
+class record_writer_t
+{
+public:
+  explicit record_writer_t(const time_format_t &format)
+    : _format(format), _keep(format.style != time_style_t::basic),
+      _digits(static_cast<int>(format.precision))
+  {}
+
+  /**
+   * @brief Write a time to `out`, which must have room for
+   * `time_string_capacity` characters, and return the end
+   */
+  char *Write(char *out, const T &time)
+  {
+    auto fs = time.get_fs();
+    if (fs < _day_begin || fs >= _day_end) [[unlikely]] {
+      Seek(time);
+    }
+    auto [secs, subsec] = split_secs(fs - _day_begin);
+    auto second = static_cast<unsigned>(secs % sec_per_min_64);
+    if constexpr (std::is_same_v<T, utc_time_t>) {
+      second += time.is_leap();
+    }
+    // A fixed-size copy, which has room as the prefix is at most 22 bytes
+    std::copy_n(_prefix.data(), prefix_copy_size, out);
+    out += _prefix_size;
+    out = write_2_digits(out, static_cast<unsigned>(secs / secs_per_hour_64));
+    *out = ':';
+    out = write_2_digits(out + _keep,
+                         static_cast<unsigned>(secs / sec_per_min_64 % 60));
+    *out = ':';
+    out = write_2_digits(out + _keep, second);
+    if (_digits > 0) {
+      // subsec is below 10^15, so the first of the 16 digits is the '.'
+      write_16_digits(out, static_cast<uint64_t>(subsec));
+      *out = '.';
+      out += _digits + 1;
+    }
+    return write_zone(out, _format.style);
+  }
+
+private:
+  /** @brief Move the cached day to a time's */
+  void Seek(const T &time)
+  {
+    auto fields = time.Fields();
+    char *end = write_time(_prefix.data(), fields,
+                           {_format.style, time_precision_t::s});
+    // Drop the time of day and zone, leaving the text up to the 'T'
+    _prefix_size = static_cast<std::size_t>(end - _prefix.data())
+      - (_keep ? 8 : 6) - (_format.style == time_style_t::rfc3339 ? 6 : 1);
+
+    int second = fields.second;
+    if constexpr (std::is_same_v<T, utc_time_t>) {
+      second -= time.is_leap();
+    }
+    int64_t sec_of_day = fields.hour * secs_per_hour_64
+      + fields.minute * sec_per_min_64 + second;
+    femtosecs_t subsec = int64_t{fields.nanosecond} * fs_per_ns_64
+      + fields.femtosecond;
+    _day_begin = time.get_fs() - sec_of_day * fs_per_sec - subsec;
+    _day_end = _day_begin + fs_per_day;
+  }
+
+  static constexpr std::size_t prefix_copy_size = 32;
+
+  time_format_t _format;
+  int _keep;
+  int _digits;
+
+  /** @brief The text of the cached day, up to and including the 'T' */
+  std::array<char, time_string_capacity> _prefix{};
+  std::size_t _prefix_size = 0;
+
+  femtosecs_t _day_begin = std::numeric_limits<femtosecs_t>::max();
+  femtosecs_t _day_end = std::numeric_limits<femtosecs_t>::min();
+};
+
+/**
+ * @brief The times whose years are 0-9999, and so are `FormattedWidth` long
+ */
+template <typename T>
+struct four_digit_years_t
+{
+  femtosecs_t begin = T(civil_fields_t{0, 1, 1, 0, 0, 0, 0, 0, 0}).get_fs();
+  femtosecs_t end = T(civil_fields_t{10000, 1, 1, 0, 0, 0, 0, 0, 0}).get_fs();
+
+  /** @brief The length of a time in the given format */
+  std::size_t Width(const T &time, const time_format_t &format) const
+  {
+    if (time.get_fs() >= begin && time.get_fs() < end) [[likely]] {
+      return FormattedWidth(format);
+    }
+    char buffer[time_string_capacity];
+    return static_cast<std::size_t>(time.FormatTo(buffer, format) - buffer);
+  }
+};
+
+/**
+ * @brief Write `times[i]` at `start(i)` and pass its end to `finish(i, end)`,
+ * never touching the buffer at or past `limit`
+ */
+template <typename T, typename Start, typename Finish>
+void format_rows(std::span<const T> times, const time_format_t &format,
+                 const char *limit, Start &&start, Finish &&finish)
+{
+  record_writer_t<T> writer(format);
+  for (std::size_t i = 0; i < times.size(); i++) {
+    char *out = start(i);
+    char *end;
+    if (limit - out >= static_cast<std::ptrdiff_t>(time_string_capacity)) {
+      end = writer.Write(out, times[i]);
+    } else {
+      char buffer[time_string_capacity];
+      end = std::copy(buffer, writer.Write(buffer, times[i]), out);
+    }
+    finish(i, end);
+  }
+}
+
+template <typename T>
+std::size_t formatted_size(std::span<const T> times,
+                           const time_format_t &format)
+{
+  four_digit_years_t<T> years;
+  std::size_t size = 0;
+  for (const auto &time : times) {
+    size += years.Width(time, format);
+  }
+  return size;
+}
+
+template <typename T>
+std::size_t format_fixed(std::span<const T> times, std::span<char> out,
+                         std::size_t stride, const time_format_t &format,
+                         unsigned threads)
+{
+  auto rows = times.size();
+  if (stride < FormattedWidth(format)) {
+    auto msg = fmt::format("FormatColumn: a stride of {} is shorter than "
+                           "the {}-byte times", stride, FormattedWidth(format));
+    throw std::runtime_error(msg);
+  }
+  if (out.size() / stride < rows) {
+    auto msg = fmt::format("FormatColumn: {} times of {} bytes need more "
+                           "than {} bytes", rows, stride, out.size());
+    throw std::runtime_error(msg);
+  }
+  if (stride < FormattedWidth(format) + max_extra_year_chars) {
+    four_digit_years_t<T> years;
+    for (const auto &time : times) {
+      if (auto width = years.Width(time, format); width > stride) {
+        auto msg = fmt::format("FormatColumn: {} is {} bytes, longer than "
+                               "the stride of {}", time.ToString(format),
+                               width, stride);
+        throw std::runtime_error(msg);
+      }
+    }
+  }
+
+  char *base = out.data();
+  run_chunks(rows, chunk_count(rows, threads, rows_per_format_thread),
+             [&](std::size_t, std::size_t begin, std::size_t end) {
+    format_rows(times.subspan(begin, end - begin), format, base + end * stride,
+                [&](std::size_t i) { return base + (begin + i) * stride; },
+                [&](std::size_t i, char *record_end) {
+                  std::fill(record_end, base + (begin + i + 1) * stride, ' ');
+                });
+  });
+  return rows * stride;
+}
+
+template <typename T>
+std::size_t format_packed(std::span<const T> times, std::span<char> out,
+                          std::span<std::size_t> offsets,
+                          const time_format_t &format, unsigned threads)
+{
+  auto rows = times.size();
+  if (offsets.size() < rows + 1) {
+    auto msg = fmt::format("FormatColumn: {} times need {} offsets, not {}",
+                           rows, rows + 1, offsets.size());
+    throw std::runtime_error(msg);
+  }
+  four_digit_years_t<T> years;
+  offsets[0] = 0;
+  for (std::size_t i = 0; i < rows; i++) {
+    offsets[i + 1] = offsets[i] + years.Width(times[i], format);
+  }
+  if (offsets[rows] > out.size()) {
+    auto msg = fmt::format("FormatColumn: {} times need {} bytes, not {}",
+                           rows, offsets[rows], out.size());
+    throw std::runtime_error(msg);
+  }
+
+  char *base = out.data();
+  run_chunks(rows, chunk_count(rows, threads, rows_per_format_thread),
+             [&](std::size_t, std::size_t begin, std::size_t end) {
+    format_rows(times.subspan(begin, end - begin), format,
+                base + offsets[end],
+                [&](std::size_t i) { return base + offsets[begin + i]; },
+                [](std::size_t, char *) {});
+  });
+  return offsets[rows];
+}
+
+} // namespace
+
+std::size_t FormattedSize(std::span<const gps_time_t> times,
+                          const time_format_t &format)
+{
+  return formatted_size(times, format);
+}
+
+std::size_t FormattedSize(std::span<const utc_time_t> times,
+                          const time_format_t &format)
+{
+  return formatted_size(times, format);
+}
+
+std::size_t FormatColumn(std::span<const gps_time_t> times,
+                         std::span<char> out, std::size_t stride,
+                         const time_format_t &format, unsigned threads)
+{
+  return format_fixed(times, out, stride, format, threads);
+}
+
+std::size_t FormatColumn(std::span<const utc_time_t> times,
+                         std::span<char> out, std::size_t stride,
+                         const time_format_t &format, unsigned threads)
+{
+  return format_fixed(times, out, stride, format, threads);
+}
+
+std::size_t FormatColumn(std::span<const gps_time_t> times,
+                         std::span<char> out, std::span<std::size_t> offsets,
+                         const time_format_t &format, unsigned threads)
+{
+  return format_packed(times, out, offsets, format, threads);
+}
+
+std::size_t FormatColumn(std::span<const utc_time_t> times,
+                         std::span<char> out, std::span<std::size_t> offsets,
+                         const time_format_t &format, unsigned threads)
+{
+  return format_packed(times, out, offsets, format, threads);
+}
+
+} /** namespace femtotime */
@@ -0,0 +1,107 @@
+/**
+ * @file time_index.cpp
+ * @brief A search index over sorted times, laid out for the cache
+ * @date 16 Oct 2026
+ */
+
+// [femtotime headers]
+#include "femtotime/time_index.hpp"
+
+// [C++ headers]
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace std;
+
+namespace femtotime {
+
+namespace {
+
+/** @brief The number of searches LowerBounds runs side by side */
+constexpr std::size_t search_group = 16;
+
+inline femtosecs_t key_of(const gps_time_t &time)
+{
+  return time.get_fs();
+}
+
+inline femtosecs_t key_of(femtosecs_t fs)
+{
+  return fs;
+}
+
+} // namespace
+
+time_index_t::time_index_t(std::span<const gps_time_t> times)
+{
+  Build(times);
+}
+
+time_index_t::time_index_t(std::span<const femtosecs_t> times)
+{
+  Build(times);
+}
+
+template<typename T>
+void time_index_t::Build(std::span<const T> sorted)
+{
+  for (std::size_t i = 1; i < sorted.size(); i++) {
+    if (key_of(sorted[i]) < key_of(sorted[i - 1])) {
+      auto msg = fmt::format("time_index_t: time {} is before the one before "
+                             "it", i);
+      throw std::runtime_error(msg);
+    }
+  }
+  _count = sorted.size();
+  _height = std::bit_width(_count);
+  _last_level = _count - ((std::size_t{1} << _height) / 2 - 1);
+  // Node 0 is unused, so node k's children share a cache line
+  auto bytes = (_count + 1) * sizeof(femtosecs_t);
+  _keys.reset(static_cast<femtosecs_t *>(
+    ::operator new[](bytes, std::align_val_t{64})));
+  _keys[0] = 0;
+  for (std::size_t k = 1; k <= _count; k++) {
+    _keys[k] = key_of(sorted[Rank(k)]);
+  }
+}
+
+void time_index_t::LowerBounds(std::span<const gps_time_t> times,
+                               std::span<std::size_t> out) const
+{
+  if (out.size() < times.size()) {
+    auto msg = fmt::format("LowerBounds: {} times but room for {}",
+                           times.size(), out.size());
+    throw std::runtime_error(msg);
+  }
+  if (_count == 0) {
+    std::fill_n(out.begin(), times.size(), 0);
+    return;
+  }
+  std::array<femtosecs_t, search_group> keys;
+  std::array<std::size_t, search_group> nodes;
+  for (std::size_t start = 0; start < times.size(); start += search_group) {
+    auto group = std::min(search_group, times.size() - start);
+    for (std::size_t i = 0; i < group; i++) {
+      keys[i] = times[start + i].get_fs();
+      nodes[i] = 1;
+    }
+    // One level of every search before the next level of any; the loads
+    // of a level are independent, so they are already in flight together
+    // and prefetching as well only crowds the memory system
+    for (std::size_t level = 1; level < _height; level++) {
+      for (std::size_t i = 0; i < group; i++) {
+        nodes[i] = Step<false>(nodes[i], keys[i]);
+      }
+    }
+    for (std::size_t i = 0; i < group; i++) {
+      out[start + i] = Position(LastStep<false>(nodes[i], keys[i]));
+    }
+  }
+}
+
+} /** namespace femtotime */
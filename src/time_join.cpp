@@ -0,0 +1,151 @@
+/**
+ * @file time_join.cpp
+ * @brief As-of joins between two sorted columns of times
+ * @date 16 Oct 2026
+ */
+
+// [femtotime headers]
+#include "femtotime/time_join.hpp"
+#include "thread_chunks.hpp"
+
+// [C++ headers]
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace std;
+
+namespace femtotime {
+
+namespace {
+
+/**
+ * @brief Right times per left time past which each search starts from the
+ * whole column, whose first few steps then stay in cache
+ */
+constexpr std::size_t sparse_ratio = 256;
+
+/**
+ * @brief The first position from `from` on whose time is after `time`
+ * (`upper`) or not before it, found by galloping forward from `from`, or
+ * with `sparse`, by a binary search of all of `right`
+ */
+template<bool upper>
+std::size_t gallop(std::span<const gps_time_t> right, std::size_t from,
+                   const gps_time_t &time, bool sparse)
+{
+  auto before = [&](const gps_time_t &other) {
+    return upper ? !(time < other) : other < time;
+  };
+  if (from == right.size() || !before(right[from])) {
+    return from;
+  }
+  if (sparse) {
+    return std::partition_point(right.begin(), right.end(), before) -
+      right.begin();
+  }
+  // right[low] is before the bound; double the step until one isn't
+  std::size_t low = from;
+  std::size_t step = 1;
+  while (step < right.size() - low && before(right[low + step])) {
+    low += step;
+    step *= 2;
+  }
+  auto high = std::min(low + step, right.size());
+  return std::partition_point(right.begin() + low + 1, right.begin() + high,
+                              before) - right.begin();
+}
+
+/**
+ * @brief Match `left[begin, end)`, starting the cursor with a binary
+ * search, and return the number matched
+ */
+std::size_t join_part(std::span<const gps_time_t> left,
+                      std::span<const gps_time_t> right,
+                      std::span<std::size_t> matches,
+                      join_direction_t direction,
+                      const std::optional<duration_t> &tolerance,
+                      std::size_t begin, std::size_t end)
+{
+  if (begin == end) {
+    return 0;
+  }
+  bool forward = direction == join_direction_t::forward;
+  bool sparse = right.size() / (end - begin) >= sparse_ratio;
+  // Backward and nearest follow the first right time after the left time;
+  // forward follows the first not before it
+  std::size_t cursor = forward
+    ? std::lower_bound(right.begin(), right.end(), left[begin]) - right.begin()
+    : std::upper_bound(right.begin(), right.end(), left[begin]) - right.begin();
+  std::size_t count = 0;
+  for (auto i = begin; i < end; i++) {
+    const auto &time = left[i];
+    auto match = join_no_match;
+    duration_t distance(0);
+    if (forward) {
+      cursor = gallop<false>(right, cursor, time, sparse);
+      if (cursor < right.size()) {
+        match = cursor;
+        distance = right[cursor] - time;
+      }
+    } else {
+      cursor = gallop<true>(right, cursor, time, sparse);
+      if (cursor > 0) {
+        match = cursor - 1;
+        distance = time - right[match];
+      }
+      if (direction == join_direction_t::nearest && cursor < right.size()) {
+        auto after = right[cursor] - time;
+        if (match == join_no_match || after < distance) {
+          match = cursor;
+          distance = after;
+        }
+      }
+    }
+    if (match != join_no_match && tolerance && *tolerance < distance) {
+      match = join_no_match;
+    }
+    matches[i] = match;
+    count += match != join_no_match;
+  }
+  return count;
+}
+
+} // namespace
+
+std::size_t AsOfJoin(std::span<const gps_time_t> left,
+                     std::span<const gps_time_t> right,
+                     std::span<std::size_t> matches,
+                     join_direction_t direction,
+                     std::optional<duration_t> tolerance, unsigned threads)
+{
+  if (matches.size() != left.size()) {
+    auto msg = fmt::format("AsOfJoin: {} left times but {} matches",
+                           left.size(), matches.size());
+    throw std::runtime_error(msg);
+  }
+  if (tolerance && *tolerance < duration_t(0)) {
+    throw std::runtime_error("AsOfJoin: the tolerance is negative");
+  }
+  auto unsorted = std::is_sorted_until(left.begin(), left.end());
+  if (unsorted != left.end()) {
+    auto msg = fmt::format("AsOfJoin: left time {} is before the one before "
+                           "it", unsorted - left.begin());
+    throw std::runtime_error(msg);
+  }
+
+  std::atomic<std::size_t> count = 0;
+  run_chunks(left.size(), chunk_count(left.size(), threads),
+             [&](std::size_t, std::size_t begin, std::size_t end) {
+    count += join_part(left, right, matches, direction, tolerance, begin,
+                       end);
+  });
+  return count;
+}
+
+} /** namespace femtotime */
@@ -0,0 +1,408 @@
+/**
+ * @file time_parse_batch.cpp
+ * @brief Parsing columns of fixed-width UTC timestamps with SIMD
+ * @date 16 Oct 2026
+ *
+ * Each kernel checks a block of up to 64 rows against a `column_pattern_t`
+ * and fills in their fields; the conversion to GPS or UTC times is shared.
+ *
+ * The vector kernels read 32 bytes from the start of every row, which may be
+ * past the end of a short row, so rows too near the end of the data are
+ * always parsed by the scalar kernel.
+ */
+
+// [femtotime headers]
+#include "femtotime/time_parse_batch.hpp"
+#include "femtotime/calendar.hpp"
+#include "femtotime/leap_cursor.hpp"
+#include "femtotime/time_parse.hpp"
+#include "femtotime/time_split.hpp"
+
+// [C++ headers]
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define FEMTOTIME_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace std;
+
+namespace femtotime {
+
+namespace {
+
+/** @brief The most bytes a vector kernel looks at in a row */
+constexpr std::size_t pattern_bytes = 32;
+
+/**
+ * @struct column_pattern_t
+ *
+ * What each byte of a row must be, as masks for the vector kernels, and how
+ * to gather its digits into pairs for `maddubs`.
+ */
+struct column_pattern_t
+{
+  explicit column_pattern_t(const iso_column_t &column);
+
+  /** @brief 0xFF where a digit is needed */
+  alignas(32) std::array<uint8_t, pattern_bytes> digit_mask{};
+
+  /** @brief 0xFF where `text` must be matched */
+  alignas(32) std::array<uint8_t, pattern_bytes> exact_mask{};
+
+  /** @brief The separators, where `exact_mask` is set */
+  alignas(32) std::array<char, pattern_bytes> text{};
+
+  /**
+   * @brief Within each 16-byte half, where each digit goes so that every
+   * field is in whole byte pairs: `YY YY MM DD hh mm` in the low half and
+   * `ss 0f ff ff ff ff` (the nanoseconds) in the high half. 0x80 gives a
+   * zero.
+   */
+  alignas(32) std::array<uint8_t, pattern_bytes> shuffle{};
+
+  /** @brief The same masks, eight bytes at a time, for the scalar kernel */
+  std::array<char_pattern_t, pattern_bytes / 8> words{};
+
+  /** @brief The `movemask` bits of the bytes in a timestamp */
+  uint32_t required;
+
+  std::size_t width;
+  int fraction_digits;
+};
+
+column_pattern_t::column_pattern_t(const iso_column_t &column)
+  : width(column.width()), fraction_digits(column.fraction_digits)
+{
+  std::string layout = "0000-00-00T00:00:00";
+  if (column.fraction_digits > 0) {
+    layout += '.';
+    layout.append(column.fraction_digits, '0');
+  }
+  if (column.zulu) {
+    layout += 'Z';
+  }
+  for (std::size_t i = 0; i < layout.size(); i++) {
+    if (layout[i] == '0') {
+      digit_mask[i] = 0xFF;
+    } else {
+      exact_mask[i] = 0xFF;
+      text[i] = layout[i];
+    }
+  }
+  for (std::size_t i = 0; i < pattern_bytes; i++) {
+    auto &word = words[i / 8];
+    auto shift = 8 * (i % 8);
+    word.separator_mask |= uint64_t{exact_mask[i]} << shift;
+    word.separators |= uint64_t{static_cast<uint8_t>(text[i])} << shift;
+  }
+  required = width == 32 ? ~uint32_t{0} : (uint32_t{1} << width) - 1;
+
+  shuffle.fill(0x80);
+  constexpr uint8_t date_time[] = {0, 1, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15};
+  std::copy(std::begin(date_time), std::end(date_time), shuffle.begin());
+  shuffle[16] = 17 - 16;
+  shuffle[17] = 18 - 16;
+  for (int i = 0; i < column.fraction_digits; i++) {
+    shuffle[19 + i] = 20 - 16 + i;
+  }
+}
+
+/** @brief The fields from the pairs of digits gathered by `shuffle` */
+inline void fields_from_pairs(const uint16_t (&pairs)[16],
+                              civil_fields_t &fields)
+{
+  fields.year = pairs[0] * 100 + pairs[1];
+  fields.month = pairs[2];
+  fields.day = pairs[3];
+  fields.hour = pairs[4];
+  fields.minute = pairs[5];
+  fields.second = pairs[8];
+  fields.nanosecond = pairs[9] * 100'000'000 + pairs[10] * 1'000'000
+    + pairs[11] * 10'000 + pairs[12] * 100 + pairs[13];
+  fields.femtosecond = 0;
+}
+
+/**
+ * @brief Parse `count` (at most 64) rows without vector instructions,
+ * checking eight bytes at a time while they're within the row
+ */
+uint64_t scalar_rows(const char *row, std::size_t stride, std::size_t count,
+                     const column_pattern_t &pattern, civil_fields_t *fields)
+{
+  constexpr int nanos_scale[10] = {1'000'000'000, 100'000'000, 10'000'000,
+                                   1'000'000, 100'000, 10'000, 1'000, 100,
+                                   10, 1};
+  uint64_t valid = 0;
+  for (std::size_t r = 0; r < count; r++, row += stride) {
+    std::string_view text(row, pattern.width);
+    std::size_t i = 0;
+    bool ok = true;
+    for (; i + 8 <= pattern.width; i += 8) {
+      auto word = load_8_chars(text, i);
+      ok &= match_8_chars(word, pattern.words[i / 8]);
+    }
+    for (; i < pattern.width; i++) {
+      ok &= pattern.digit_mask[i] ? is_digit(row[i])
+                                  : row[i] == pattern.text[i];
+    }
+    if (!ok) {
+      continue;
+    }
+    auto &f = fields[r];
+    f.year = two_digits(text, 0) * 100 + two_digits(text, 2);
+    f.month = two_digits(text, 5);
+    f.day = two_digits(text, 8);
+    f.hour = two_digits(text, 11);
+    f.minute = two_digits(text, 14);
+    f.second = two_digits(text, 17);
+    int nanos = 0;
+    for (int d = 0; d < pattern.fraction_digits; d++) {
+      nanos = nanos * 10 + (row[20 + d] - '0');
+    }
+    f.nanosecond = nanos * nanos_scale[pattern.fraction_digits];
+    f.femtosecond = 0;
+    valid |= uint64_t{1} << r;
+  }
+  return valid;
+}
+
+#ifdef FEMTOTIME_X86_KERNELS
+
+/** @brief Parse `count` (at most 64) rows, each in two 16-byte registers */
+__attribute__((target("ssse3")))
+uint64_t ssse3_rows(const char *row, std::size_t stride, std::size_t count,
+                    const column_pattern_t &pattern, civil_fields_t *fields)
+{
+  const __m128i zero = _mm_set1_epi8('0');
+  const __m128i nine = _mm_set1_epi8(9);
+  const __m128i weights = _mm_set1_epi16(0x010A);
+  __m128i digit_mask[2], exact_mask[2], text[2], shuffle[2];
+  for (int h = 0; h < 2; h++) {
+    digit_mask[h] = _mm_load_si128(
+      reinterpret_cast<const __m128i *>(pattern.digit_mask.data()) + h);
+    exact_mask[h] = _mm_load_si128(
+      reinterpret_cast<const __m128i *>(pattern.exact_mask.data()) + h);
+    text[h] = _mm_load_si128(
+      reinterpret_cast<const __m128i *>(pattern.text.data()) + h);
+    shuffle[h] = _mm_load_si128(
+      reinterpret_cast<const __m128i *>(pattern.shuffle.data()) + h);
+  }
+
+  uint64_t valid = 0;
+  for (std::size_t r = 0; r < count; r++, row += stride) {
+    uint32_t matched = 0;
+    alignas(16) uint16_t pairs[16];
+    for (int h = 0; h < 2; h++) {
+      auto bytes = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(row + 16 * h));
+      auto digits = _mm_sub_epi8(bytes, zero);
+      auto is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digits, nine), digits);
+      auto is_exact = _mm_cmpeq_epi8(bytes, text[h]);
+      auto ok = _mm_or_si128(_mm_and_si128(is_digit, digit_mask[h]),
+                             _mm_and_si128(is_exact, exact_mask[h]));
+      matched |= static_cast<uint32_t>(_mm_movemask_epi8(ok)) << (16 * h);
+      auto gathered = _mm_shuffle_epi8(digits, shuffle[h]);
+      _mm_store_si128(reinterpret_cast<__m128i *>(pairs + 8 * h),
+                      _mm_maddubs_epi16(gathered, weights));
+    }
+    if ((matched & pattern.required) == pattern.required) {
+      fields_from_pairs(pairs, fields[r]);
+      valid |= uint64_t{1} << r;
+    }
+  }
+  return valid;
+}
+
+/** @brief Parse `count` (at most 64) rows, each in one 32-byte register */
+__attribute__((target("avx2")))
+uint64_t avx2_rows(const char *row, std::size_t stride, std::size_t count,
+                   const column_pattern_t &pattern, civil_fields_t *fields)
+{
+  const __m256i zero = _mm256_set1_epi8('0');
+  const __m256i nine = _mm256_set1_epi8(9);
+  const __m256i weights = _mm256_set1_epi16(0x010A);
+  const __m256i digit_mask = _mm256_load_si256(
+    reinterpret_cast<const __m256i *>(pattern.digit_mask.data()));
+  const __m256i exact_mask = _mm256_load_si256(
+    reinterpret_cast<const __m256i *>(pattern.exact_mask.data()));
+  const __m256i text = _mm256_load_si256(
+    reinterpret_cast<const __m256i *>(pattern.text.data()));
+  const __m256i shuffle = _mm256_load_si256(
+    reinterpret_cast<const __m256i *>(pattern.shuffle.data()));
+
+  uint64_t valid = 0;
+  for (std::size_t r = 0; r < count; r++, row += stride) {
+    auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row));
+    auto digits = _mm256_sub_epi8(bytes, zero);
+    auto is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digits, nine), digits);
+    auto is_exact = _mm256_cmpeq_epi8(bytes, text);
+    auto ok = _mm256_or_si256(_mm256_and_si256(is_digit, digit_mask),
+                              _mm256_and_si256(is_exact, exact_mask));
+    auto matched = static_cast<uint32_t>(_mm256_movemask_epi8(ok));
+    if ((matched & pattern.required) != pattern.required) {
+      continue;
+    }
+    alignas(32) uint16_t pairs[16];
+    auto gathered = _mm256_shuffle_epi8(digits, shuffle);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(pairs),
+                       _mm256_maddubs_epi16(gathered, weights));
+    fields_from_pairs(pairs, fields[r]);
+    valid |= uint64_t{1} << r;
+  }
+  return valid;
+}
+
+#endif
+
+/**
+ * @brief The same as `utc_time_t(fields)` for the fields a kernel sets, but
+ * inline
+ */
+inline utc_time_t utc_from_fields(const civil_fields_t &fields)
+{
+  bool leap = fields.second == 60;
+  auto days = days_from_civil(fields.year, fields.month, fields.day,
+                              utc_y2000_epoch);
+  int64_t secs = days * secs_per_day_64 + fields.hour * secs_per_hour_64
+    + fields.minute * sec_per_min_64 + fields.second - leap;
+  return utc_time_t(femtosecs_t(secs) * fs_per_sec
+                    + int64_t{fields.nanosecond} * fs_per_ns, leap);
+}
+
+using rows_kernel_t = uint64_t (*)(const char *, std::size_t, std::size_t,
+                                   const column_pattern_t &,
+                                   civil_fields_t *);
+
+rows_kernel_t select_kernel(parse_kernel_t kernel)
+{
+  auto supported = SupportedParseKernel();
+  if (kernel == parse_kernel_t::automatic || kernel > supported) {
+    kernel = supported;
+  }
+  switch (kernel) {
+#ifdef FEMTOTIME_X86_KERNELS
+  case parse_kernel_t::avx2:
+    return avx2_rows;
+  case parse_kernel_t::ssse3:
+    return ssse3_rows;
+#endif
+  default:
+    return scalar_rows;
+  }
+}
+
+/**
+ * @brief Check the arguments and parse the column in blocks of 64 rows,
+ * passing each valid row's fields to `store` and setting invalid rows to
+ * `T()`
+ */
+template <typename T, typename S>
+std::size_t parse_column(const iso_column_t &column, std::span<T> times,
+                         std::span<uint64_t> valid, parse_kernel_t kernel,
+                         S &&store)
+{
+  if (column.fraction_digits < 0 || column.fraction_digits > 9) {
+    auto msg = fmt::format("ParseUTCColumn: {} fraction digits is not "
+                           "supported (0-9)", column.fraction_digits);
+    throw std::runtime_error(msg);
+  }
+  if (column.stride < column.width()) {
+    auto msg = fmt::format("ParseUTCColumn: a stride of {} is shorter than "
+                           "the {}-byte timestamps", column.stride,
+                           column.width());
+    throw std::runtime_error(msg);
+  }
+  auto rows = column.rows();
+  if (times.size() != rows || valid.size() < (rows + 63) / 64) {
+    auto msg = fmt::format("ParseUTCColumn: {} rows but room for {} times "
+                           "and {} validity words", rows, times.size(),
+                           valid.size());
+    throw std::runtime_error(msg);
+  }
+
+  column_pattern_t pattern(column);
+  auto vector_rows = select_kernel(kernel);
+  // The rows that have a whole vector's worth of data after their start
+  std::size_t safe_rows = column.data.size() < pattern_bytes ? 0
+    : std::min(rows, (column.data.size() - pattern_bytes) / column.stride + 1);
+
+  std::size_t count = 0;
+  civil_fields_t fields[64];
+  for (std::size_t begin = 0; begin < rows; begin += 64) {
+    auto block = std::min<std::size_t>(64, rows - begin);
+    auto vector_block = std::min(block, safe_rows > begin ? safe_rows - begin
+                                                          : 0);
+    const char *row = column.data.data() + begin * column.stride;
+    uint64_t bits = vector_rows(row, column.stride, vector_block, pattern,
+                                fields);
+    if (vector_block < block) {
+      bits |= scalar_rows(row + vector_block * column.stride, column.stride,
+                          block - vector_block, pattern,
+                          fields + vector_block) << vector_block;
+    }
+    for (std::size_t r = 0; r < block; r++) {
+      times[begin + r] = (bits >> r) & 1 ? store(fields[r]) : T();
+    }
+    valid[begin / 64] = bits;
+    count += std::popcount(bits);
+  }
+  return count;
+}
+
+} // namespace
+
+parse_kernel_t SupportedParseKernel()
+{
+#ifdef FEMTOTIME_X86_KERNELS
+  static const parse_kernel_t supported = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      return parse_kernel_t::avx2;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+      return parse_kernel_t::ssse3;
+    }
+    return parse_kernel_t::scalar;
+  }();
+  return supported;
+#else
+  return parse_kernel_t::scalar;
+#endif
+}
+
+std::size_t ParseUTCColumn(const iso_column_t &column,
+                           std::span<gps_time_t> times,
+                           std::span<uint64_t> valid,
+                           parse_kernel_t kernel)
+{
+  // The same conversion as gps_time_t::FromUTC, but with one table lookup
+  // per leap-second segment rather than per row
+  leap_cursor_t cursor;
+  return parse_column(column, times, valid, kernel,
+                      [&](const civil_fields_t &fields) {
+                        return cursor.FromUTC(utc_from_fields(fields));
+                      });
+}
+
+std::size_t ParseUTCColumn(const iso_column_t &column,
+                           std::span<utc_time_t> times,
+                           std::span<uint64_t> valid,
+                           parse_kernel_t kernel)
+{
+  return parse_column(column, times, valid, kernel,
+                      [](const civil_fields_t &fields) {
+                        return utc_from_fields(fields);
+                      });
+}
+
+} /** namespace femtotime */
@@ -0,0 +1,282 @@
+/**
+ * @file time_sort.cpp
+ * @brief Radix sorts for columns of times and durations
+ * @date 16 Oct 2026
+ *
+ * The sort key is the femtosecond count less the smallest in the column,
+ * as an unsigned 128-bit number, so only the bytes below the width of the
+ * column's range can differ. One pass over the column counts every one of
+ * those bytes, and a byte whose counts are all in one bucket gets no pass.
+ */
+
+// [femtotime headers]
+#include "femtotime/time_sort.hpp"
+#include "thread_chunks.hpp"
+
+// [C++ headers]
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace std;
+
+namespace femtotime {
+
+namespace {
+
+using sort_key_t = unsigned __int128;
+using counts_t = std::array<std::size_t, 256>;
+
+/**
+ * @brief The fewest elements worth splitting by their high bits first; the
+ * passes over each part then stay in cache
+ */
+constexpr std::size_t rows_per_split = 65'536;
+
+/** @brief An unsigned key in the same order as a femtosecond count */
+inline sort_key_t to_key(femtosecs_t fs)
+{
+  return static_cast<sort_key_t>(fs) ^ (sort_key_t{1} << 127);
+}
+
+inline int key_width(sort_key_t key)
+{
+  auto high = static_cast<uint64_t>(key >> 64);
+  return high ? 64 + std::bit_width(high)
+              : std::bit_width(static_cast<uint64_t>(key));
+}
+
+inline unsigned key_byte(sort_key_t key, int byte)
+{
+  return static_cast<uint8_t>(key >> (8 * byte));
+}
+
+/**
+ * @struct keyed_t
+ *
+ * A key and the position it came from, for `SortedOrder`; 24 bytes where
+ * an `unsigned __int128` member would pad it to 32.
+ */
+struct keyed_t
+{
+  uint64_t low;
+  uint64_t high;
+  std::size_t index;
+};
+
+inline sort_key_t key_of(const gps_time_t &time)
+{
+  return to_key(time.get_fs());
+}
+
+inline sort_key_t key_of(const duration_t &duration)
+{
+  return to_key(duration.get_fs());
+}
+
+inline sort_key_t key_of(const keyed_t &keyed)
+{
+  return (static_cast<sort_key_t>(keyed.high) << 64) | keyed.low;
+}
+
+/** @brief The smallest and largest keys of `data` */
+template<typename T>
+std::pair<sort_key_t, sort_key_t> key_range(std::span<const T> data)
+{
+  sort_key_t low = ~sort_key_t{0};
+  sort_key_t high = 0;
+  for (const auto &value : data) {
+    auto key = key_of(value);
+    low = std::min(low, key);
+    high = std::max(high, key);
+  }
+  return {low, high};
+}
+
+/**
+ * @brief Sort `data` by key with `scratch` as the other buffer of each
+ * pass, returning true if the sorted elements ended up in `scratch`.
+ */
+template<typename T>
+bool radix_sort(std::span<T> data, std::span<T> scratch)
+{
+  if (data.size() < 2) {
+    return false;
+  }
+  auto [low, high] = key_range(std::span<const T>(data));
+  int bytes = (key_width(high - low) + 7) / 8;
+  std::array<counts_t, 16> counts{};
+  for (const auto &value : data) {
+    auto key = key_of(value) - low;
+    for (int byte = 0; byte < bytes; byte++) {
+      counts[byte][key_byte(key, byte)]++;
+    }
+  }
+
+  T *from = data.data();
+  T *to = scratch.data();
+  for (int byte = 0; byte < bytes; byte++) {
+    auto &count = counts[byte];
+    if (std::find(count.begin(), count.end(), data.size()) != count.end()) {
+      continue;
+    }
+    std::size_t offset = 0;
+    for (auto &bucket : count) {
+      offset += std::exchange(bucket, offset);
+    }
+    for (std::size_t i = 0; i < data.size(); i++) {
+      auto key = key_of(from[i]) - low;
+      to[count[key_byte(key, byte)]++] = from[i];
+    }
+    std::swap(from, to);
+  }
+  return from == scratch.data();
+}
+
+/**
+ * @brief Sort `data` in place, with `scratch` as space of the same size.
+ *
+ * A part of at least `rows_per_split` elements is first split by the top
+ * eight bits of its own key range into 256 buckets, across threads. The
+ * buckets below that size are then radix sorted, one per thread at a time,
+ * and each larger one is split again the same way. A few outliers, such as
+ * a zero or sentinel time in a day of telemetry, widen the range so that
+ * the rest of the column falls in one bucket; that bucket's own range is
+ * narrow again, so its split spreads it out.
+ */
+template<typename T>
+void sort_part(std::span<T> data, std::span<T> scratch, unsigned threads)
+{
+  if (data.size() < rows_per_split) {
+    if (radix_sort(data, scratch)) {
+      std::copy(scratch.begin(), scratch.end(), data.begin());
+    }
+    return;
+  }
+
+  auto chunks = chunk_count(data.size(), threads);
+
+  // The range of the keys, and the shift that leaves their top eight bits
+  std::vector<std::pair<sort_key_t, sort_key_t>> ranges(chunks);
+  run_chunks(data.size(), chunks, [&](std::size_t c, std::size_t begin,
+                                      std::size_t end) {
+    ranges[c] = key_range(std::span<const T>(data).subspan(begin,
+                                                           end - begin));
+  });
+  sort_key_t low = ~sort_key_t{0};
+  sort_key_t high = 0;
+  for (auto [chunk_low, chunk_high] : ranges) {
+    low = std::min(low, chunk_low);
+    high = std::max(high, chunk_high);
+  }
+  if (low == high) {
+    return;
+  }
+  int shift = std::max(key_width(high - low) - 8, 0);
+  auto bucket_of = [&](const T &value) {
+    return static_cast<unsigned>((key_of(value) - low) >> shift);
+  };
+
+  // Each chunk scatters its elements to its own part of each bucket
+  std::vector<counts_t> counts(chunks);
+  run_chunks(data.size(), chunks, [&](std::size_t c, std::size_t begin,
+                                      std::size_t end) {
+    counts[c].fill(0);
+    for (std::size_t i = begin; i < end; i++) {
+      counts[c][bucket_of(data[i])]++;
+    }
+  });
+  std::array<std::size_t, 257> starts;
+  std::size_t offset = 0;
+  for (std::size_t bucket = 0; bucket < 256; bucket++) {
+    starts[bucket] = offset;
+    for (auto &count : counts) {
+      offset += std::exchange(count[bucket], offset);
+    }
+  }
+  starts[256] = offset;
+  run_chunks(data.size(), chunks, [&](std::size_t c, std::size_t begin,
+                                      std::size_t end) {
+    for (std::size_t i = begin; i < end; i++) {
+      scratch[counts[c][bucket_of(data[i])]++] = data[i];
+    }
+  });
+
+  // Then each thread takes the next small bucket until they are all sorted
+  auto bucket_span = [&](std::span<T> column, std::size_t bucket) {
+    return column.subspan(starts[bucket],
+                          starts[bucket + 1] - starts[bucket]);
+  };
+  std::atomic<std::size_t> next = 0;
+  run_chunks(data.size(), chunks, [&](std::size_t, std::size_t,
+                                      std::size_t) {
+    for (auto bucket = next++; bucket < 256; bucket = next++) {
+      auto from = bucket_span(scratch, bucket);
+      auto to = bucket_span(data, bucket);
+      if (from.size() < rows_per_split && !radix_sort(from, to)) {
+        std::copy(from.begin(), from.end(), to.begin());
+      }
+    }
+  });
+
+  // And the large ones are split again, each with all the threads
+  for (std::size_t bucket = 0; bucket < 256; bucket++) {
+    auto from = bucket_span(scratch, bucket);
+    if (from.size() >= rows_per_split) {
+      auto to = bucket_span(data, bucket);
+      sort_part(from, to, threads);
+      std::copy(from.begin(), from.end(), to.begin());
+    }
+  }
+}
+
+/** @brief Sort `data` in place, across up to `threads` threads */
+template<typename T>
+void sort_column(std::span<T> data, unsigned threads)
+{
+  if (data.size() < 2) {
+    return;
+  }
+  std::vector<T> scratch(data.size(), data.front());
+  sort_part(data, std::span(scratch), threads);
+}
+
+} // namespace
+
+void SortTimes(std::span<gps_time_t> times, unsigned threads)
+{
+  sort_column(times, threads);
+}
+
+void SortTimes(std::span<duration_t> durations, unsigned threads)
+{
+  sort_column(durations, threads);
+}
+
+void SortedOrder(std::span<const gps_time_t> times,
+                 std::span<std::size_t> order, unsigned threads)
+{
+  if (order.size() != times.size()) {
+    auto msg = fmt::format("SortedOrder: {} times but {} positions",
+                           times.size(), order.size());
+    throw std::runtime_error(msg);
+  }
+  std::vector<keyed_t> keyed(times.size());
+  for (std::size_t i = 0; i < times.size(); i++) {
+    auto key = key_of(times[i]);
+    keyed[i] = {static_cast<uint64_t>(key), static_cast<uint64_t>(key >> 64),
+                i};
+  }
+  sort_column(std::span(keyed), threads);
+  for (std::size_t i = 0; i < keyed.size(); i++) {
+    order[i] = keyed[i].index;
+  }
+}
+
+} /** namespace femtotime */
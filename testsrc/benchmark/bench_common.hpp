@@ -0,0 +1,111 @@
+/**
+ * @file   bench_common.hpp
+ * @brief  Timing helpers shared by the femtotime benchmarks
+ *
+ */
+#pragma once
+
+// [C++ headers]
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// [fmt]
+#include <fmt/format.h>
+
+namespace bench {
+
+/** @brief Read the time stamp counter (0 where there is none) */
+inline uint64_t cycle_count()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+/** @brief Keep the compiler from optimizing away a computed value */
+template<typename T>
+inline void do_not_optimize(const T &value)
+{
+  asm volatile("" : : "m"(value) : "memory");
+}
+
+/**
+ * @struct result_t
+ *
+ * The cost of one operation, averaged over a timed loop.
+ */
+struct result_t
+{
+  double ns_per_op;
+  double cycles_per_op;
+};
+
+/**
+ * @brief Time `ops` calls of `body(i)` after a short warm-up.
+ */
+template<typename F>
+result_t time_ops(size_t ops, F &&body)
+{
+  for (size_t i = 0; i < ops / 10 + 1; i++) {
+    body(i);
+  }
+  auto start = std::chrono::steady_clock::now();
+  auto start_cycles = cycle_count();
+  for (size_t i = 0; i < ops; i++) {
+    body(i);
+  }
+  auto end_cycles = cycle_count();
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::nano> elapsed = end - start;
+  return {elapsed.count() / ops,
+          static_cast<double>(end_cycles - start_cycles) / ops};
+}
+
+/**
+ * @brief Time a single run of `body()` that processes `items` elements.
+ */
+template<typename F>
+result_t time_batch(size_t items, F &&body)
+{
+  auto start = std::chrono::steady_clock::now();
+  auto start_cycles = cycle_count();
+  body();
+  auto end_cycles = cycle_count();
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::nano> elapsed = end - start;
+  return {elapsed.count() / items,
+          static_cast<double>(end_cycles - start_cycles) / items};
+}
+
+/** @brief Print one line of results */
+inline void report(const std::string &name, const result_t &result)
+{
+  fmt::print("{:<48} {:>10.2f} ns/op {:>10.2f} cycles/op\n",
+             name, result.ns_per_op, result.cycles_per_op);
+}
+
+/** @brief Print a before/after pair and the speedup */
+inline void compare(const std::string &name, const result_t &before,
+                    const result_t &after)
+{
+  report(name + " (before)", before);
+  report(name + " (after)", after);
+  fmt::print("{:<48} {:>10.2f}x\n", name + " speedup",
+             before.ns_per_op / after.ns_per_op);
+}
+
+/** @brief The element count from the command line, or a default */
+inline size_t count_arg(int argc, char **argv, size_t fallback)
+{
+  return argc > 1 ? std::strtoull(argv[1], nullptr, 10) : fallback;
+}
+
+} // namespace bench
@@ -0,0 +1,74 @@
+/**
+ * @file   bench_compact_time.cpp
+ * @brief  Sorting, searching and decomposing 16-byte gps_time_t against the
+ *         8-byte gps_time_ns_t
+ *
+ * The times are nanosecond-resolution and spread over fifty years, so both
+ * representations hold them exactly.
+ */
+
+// [C++ headers]
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/compact_time.hpp"
+
+#include "bench_common.hpp"
+
+// [Namespaces]
+using namespace femtotime;
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 10'000'000);
+  std::mt19937_64 rng(42);
+  std::vector<gps_time_t> wide;
+  std::vector<gps_time_ns_t> narrow;
+  wide.reserve(count);
+  narrow.reserve(count);
+  constexpr uint64_t span_ns = 50ULL * 365 * 86'400 * 1'000'000'000;
+  for (size_t i = 0; i < count; i++) {
+    auto ns = static_cast<int64_t>(rng() % span_ns);
+    narrow.push_back(gps_time_ns_t(ns));
+    wide.push_back(narrow.back().ToGPS());
+  }
+  size_t key_count = std::min<size_t>(count, 1'000'000);
+  std::vector<size_t> keys(key_count);
+  for (auto &key : keys) {
+    key = rng() % count;
+  }
+
+  bench::compare("std::sort",
+    bench::time_batch(count, [&] {
+      std::sort(wide.begin(), wide.end());
+    }),
+    bench::time_batch(count, [&] {
+      std::sort(narrow.begin(), narrow.end());
+    }));
+
+  auto wide_keys = wide;
+  auto narrow_keys = narrow;
+  std::shuffle(wide_keys.begin(), wide_keys.end(), std::mt19937_64(7));
+  std::shuffle(narrow_keys.begin(), narrow_keys.end(), std::mt19937_64(7));
+  bench::compare("std::lower_bound",
+    bench::time_ops(key_count, [&](size_t i) {
+      bench::do_not_optimize(std::lower_bound(
+        wide.begin(), wide.end(), wide_keys[keys[i]]));
+    }),
+    bench::time_ops(key_count, [&](size_t i) {
+      bench::do_not_optimize(std::lower_bound(
+        narrow.begin(), narrow.end(), narrow_keys[keys[i]]));
+    }));
+
+  bench::compare("Fields",
+    bench::time_ops(key_count, [&](size_t i) {
+      bench::do_not_optimize(wide_keys[i].Fields());
+    }),
+    bench::time_ops(key_count, [&](size_t i) {
+      bench::do_not_optimize(narrow_keys[i].Fields());
+    }));
+  return 0;
+}
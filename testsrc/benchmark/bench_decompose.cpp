@@ -0,0 +1,103 @@
+/**
+ * @file   bench_decompose.cpp
+ * @brief  Field extraction with 128-bit division vs. the split-seconds layer
+ *
+ * The "before" numbers use out-of-line copies of the 128-bit division code
+ * that the accessors used to run; the "after" numbers call the library.
+ */
+
+// [C++ headers]
+#include <random>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_split.hpp"
+
+#include "bench_common.hpp"
+
+// [Namespaces]
+using namespace femtotime;
+
+namespace {
+
+__attribute__((noinline)) std::pair<int128_t, int128_t>
+legacy_euclidean_div(int128_t x, int128_t y)
+{
+  auto quot = x / y;
+  auto rem = x % y;
+  if (rem >= 0) {
+    return std::pair(quot, rem);
+  } else {
+    return std::pair(quot - 1, rem + y);
+  }
+}
+
+int legacy_hour(femtosecs_t fs)
+{
+  auto [days, partial_days] = legacy_euclidean_div(fs, fs_per_day);
+  return partial_days / fs_per_hour;
+}
+
+int legacy_time_of_day_sum(femtosecs_t fs)
+{
+  auto [days, partial_days] = legacy_euclidean_div(fs, fs_per_day);
+  auto [hours, partial_hours] = legacy_euclidean_div(partial_days, fs_per_hour);
+  auto [mins, partial_mins] = legacy_euclidean_div(partial_hours, fs_per_min);
+  auto [secs, femtos] = legacy_euclidean_div(partial_mins, fs_per_sec);
+  return hours + mins + secs + femtos / fs_per_ns;
+}
+
+__attribute__((noinline)) long legacy_total_milliseconds(femtosecs_t fs)
+{
+  return fs / fs_per_ms;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 1'000'000);
+  std::mt19937_64 rng(42);
+  std::vector<gps_time_t> times;
+  times.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    auto secs = static_cast<femtosecs_t>(1'000'000'000 + rng() % 500'000'000);
+    times.emplace_back(secs * fs_per_sec + rng() % fs_per_sec);
+  }
+  auto at = [&](size_t i) -> const gps_time_t& { return times[i]; };
+
+  bench::compare("split into seconds",
+    bench::time_ops(count, [&](size_t i) {
+      bench::do_not_optimize(legacy_euclidean_div(at(i).get_fs(), fs_per_sec));
+    }),
+    bench::time_ops(count, [&](size_t i) {
+      bench::do_not_optimize(split_secs(at(i).get_fs()));
+    }));
+
+  bench::compare("gps_time_t::Hour()",
+    bench::time_ops(count, [&](size_t i) {
+      bench::do_not_optimize(legacy_hour(at(i).get_fs()));
+    }),
+    bench::time_ops(count, [&](size_t i) {
+      bench::do_not_optimize(at(i).Hour());
+    }));
+
+  bench::compare("hour/minute/second/nanosecond",
+    bench::time_ops(count, [&](size_t i) {
+      bench::do_not_optimize(legacy_time_of_day_sum(at(i).get_fs()));
+    }),
+    bench::time_ops(count, [&](size_t i) {
+      auto f = at(i).Fields();
+      bench::do_not_optimize(f.hour + f.minute + f.second + f.nanosecond);
+    }));
+
+  bench::compare("duration_t::total_milliseconds()",
+    bench::time_ops(count, [&](size_t i) {
+      bench::do_not_optimize(legacy_total_milliseconds(at(i).get_fs()));
+    }),
+    bench::time_ops(count, [&](size_t i) {
+      bench::do_not_optimize(duration_t(at(i).get_fs()).total_milliseconds());
+    }));
+  return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file   bench_format.cpp
+ * @brief  Timestamp formatting: fmt::format of the fields vs. FormatTo and
+ *         the femtotime formatters
+ *
+ * The "before" numbers use an out-of-line copy of the `fmt::format`-based
+ * `ToString()` that the library used to have; the "after" numbers call the
+ * library.
+ */
+
+// [C++ headers]
+#include <random>
+#include <string>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_format.hpp"
+
+#include "bench_common.hpp"
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace femtotime;
+
+namespace {
+
+__attribute__((noinline)) std::string legacy_to_string(const gps_time_t &t)
+{
+  auto f = t.Fields();
+  int64_t femtos = f.nanosecond * int64_t{1'000'000} + f.femtosecond;
+  return fmt::format(
+    "GPS_{:04}-{:02}-{:02}T{:02}:{:02}:{:02}.{:015}Z",
+    f.year, f.month, f.day, f.hour, f.minute, f.second, femtos
+  );
+}
+
+__attribute__((noinline)) std::string legacy_to_ms_string(const utc_time_t &t)
+{
+  auto f = t.Fields();
+  return fmt::format("{:04}-{:02}-{:02}T{:02}:{:02}:{:02}.{:03}Z", f.year,
+                     f.month, f.day, f.hour, f.minute, f.second,
+                     f.nanosecond / 1'000'000);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 1'000'000);
+  std::mt19937_64 rng(42);
+  std::vector<gps_time_t> times;
+  times.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    auto secs = static_cast<femtosecs_t>(rng() % 2'000'000'000);
+    times.push_back(gps_time_t(secs * fs_per_sec + rng() % fs_per_sec));
+  }
+
+  auto legacy = bench::time_ops(count, [&](size_t i) {
+    bench::do_not_optimize(legacy_to_string(times[i]));
+  });
+
+  bench::compare("ToString", legacy,
+    bench::time_ops(count, [&](size_t i) {
+      bench::do_not_optimize(times[i].ToString());
+    }));
+
+  char buffer[time_string_capacity];
+  bench::compare("FormatTo", legacy,
+    bench::time_ops(count, [&](size_t i) {
+      bench::do_not_optimize(times[i].FormatTo(buffer));
+      bench::do_not_optimize(buffer);
+    }));
+
+  // Millisecond UTC timestamps, as most logs and feeds want them
+  std::vector<utc_time_t> utc_times;
+  utc_times.reserve(count);
+  for (auto &t : times) {
+    utc_times.push_back(t.ToUTC());
+  }
+  bench::compare("{:.ms} UTC",
+    bench::time_ops(count, [&](size_t i) {
+      bench::do_not_optimize(legacy_to_ms_string(utc_times[i]));
+    }),
+    bench::time_ops(count, [&](size_t i) {
+      bench::do_not_optimize(fmt::format("{:.ms}", utc_times[i]));
+    }));
+
+  // A log line into a reused buffer, as a logger would
+  fmt::memory_buffer line;
+  bench::compare("fmt::format_to log line",
+    bench::time_ops(count, [&](size_t i) {
+      line.clear();
+      fmt::format_to(fmt::appender(line), "{} event {}\n",
+                     legacy_to_string(times[i]), i);
+      bench::do_not_optimize(line.data());
+    }),
+    bench::time_ops(count, [&](size_t i) {
+      line.clear();
+      fmt::format_to(fmt::appender(line), "{} event {}\n", times[i], i);
+      bench::do_not_optimize(line.data());
+    }));
+  return 0;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file   bench_format_batch.cpp
+ * @brief  Formatting a column of times: a ToString() loop vs. FormatColumn
+ *
+ * The column is a sorted series of about three years, as in
+ * bench_parse_batch. The "before" numbers build a vector of strings with
+ * `ToString(format)`, which is what exporting a column takes without
+ * `FormatColumn`.
+ */
+
+// [C++ headers]
+#include <random>
+#include <string>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_format_batch.hpp"
+
+#include "bench_common.hpp"
+
+// [Namespaces]
+using namespace femtotime;
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 1'000'000);
+  std::mt19937_64 rng(42);
+  std::vector<gps_time_t> times;
+  times.reserve(count);
+  auto t = gps_time_t::FromUTCString("2015-01-01T00:00:00Z");
+  for (size_t i = 0; i < count; i++) {
+    t += duration_t(static_cast<femtosecs_t>(rng() % 200'000) * fs_per_ns
+                    * 1'000'000 + rng() % fs_per_ns);
+    times.push_back(t);
+  }
+  std::span<const gps_time_t> column(times);
+  time_format_t format{time_style_t::extended, time_precision_t::fs};
+  auto width = FormattedWidth(format);
+
+  std::vector<std::string> strings(count);
+  auto per_time = bench::time_batch(count, [&] {
+    for (size_t i = 0; i < count; i++) {
+      strings[i] = times[i].ToString(format);
+    }
+    bench::do_not_optimize(strings.data());
+  });
+
+  std::string out(count * width, ' ');
+  bench::compare("FormatColumn, fixed width", per_time,
+    bench::time_batch(count, [&] {
+      bench::do_not_optimize(FormatColumn(column, out, width, format));
+    }));
+
+  std::vector<size_t> offsets(count + 1);
+  bench::compare("FormatColumn, offsets", per_time,
+    bench::time_batch(count, [&] {
+      bench::do_not_optimize(FormatColumn(column, out, offsets, format));
+    }));
+
+  bench::compare("FormatColumn, fixed width, all cores", per_time,
+    bench::time_batch(count, [&] {
+      bench::do_not_optimize(FormatColumn(column, out, width, format, 0));
+    }));
+  return 0;
+}
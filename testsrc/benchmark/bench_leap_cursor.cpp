@@ -0,0 +1,81 @@
+/**
+ * @file   bench_leap_cursor.cpp
+ * @brief  Batch GPS/UTC conversion of a sorted series vs. per-element calls
+ *
+ * A sorted series of times spanning several leap seconds is converted with
+ * the per-element `ToUTC()`/`FromUTC()`/`LeapSecondsBetween()` ("before") and
+ * with the span functions built on `leap_cursor_t` ("after").
+ */
+
+// [C++ headers]
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/leap_cursor.hpp"
+
+#include "bench_common.hpp"
+
+// [Namespaces]
+using namespace femtotime;
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 1'000'000);
+  std::mt19937_64 rng(42);
+  std::vector<gps_time_t> gps(count);
+  for (auto &t : gps) {
+    // 2005 to 2020
+    auto secs = static_cast<femtosecs_t>(790'000'000 + rng() % 480'000'000);
+    t = gps_time_t(secs * fs_per_sec + rng() % fs_per_sec);
+  }
+  std::sort(gps.begin(), gps.end());
+  std::vector<utc_time_t> utc(count);
+  ToUTC(gps, utc);
+  std::vector<utc_time_t> later(count);
+  for (size_t i = 0; i < count; i++) {
+    later[i] = utc_time_t(utc[i].get_fs() + fs_per_year);
+  }
+  std::vector<utc_time_t> utc_out(count);
+  std::vector<gps_time_t> gps_out(count);
+  std::vector<int> between(count);
+
+  bench::compare("ToUTC, sorted",
+    bench::time_batch(count, [&]() {
+      for (size_t i = 0; i < count; i++) {
+        utc_out[i] = gps[i].ToUTC();
+      }
+      bench::do_not_optimize(utc_out.back());
+    }),
+    bench::time_batch(count, [&]() {
+      ToUTC(gps, utc_out);
+      bench::do_not_optimize(utc_out.back());
+    }));
+
+  bench::compare("FromUTC, sorted",
+    bench::time_batch(count, [&]() {
+      for (size_t i = 0; i < count; i++) {
+        gps_out[i] = gps_time_t::FromUTC(utc[i]);
+      }
+      bench::do_not_optimize(gps_out.back());
+    }),
+    bench::time_batch(count, [&]() {
+      FromUTC(utc, gps_out);
+      bench::do_not_optimize(gps_out.back());
+    }));
+
+  bench::compare("LeapSecondsBetween, sorted",
+    bench::time_batch(count, [&]() {
+      for (size_t i = 0; i < count; i++) {
+        between[i] = LeapSecondsBetween(utc[i], later[i]);
+      }
+      bench::do_not_optimize(between.back());
+    }),
+    bench::time_batch(count, [&]() {
+      LeapSecondsBetween(utc, later, between);
+      bench::do_not_optimize(between.back());
+    }));
+  return 0;
+}
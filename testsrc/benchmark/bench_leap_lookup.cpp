@@ -0,0 +1,76 @@
+/**
+ * @file   bench_leap_lookup.cpp
+ * @brief  Leap-second lookup: binary search vs. the bucketed index
+ *
+ * The "before" numbers run `std::upper_bound` over a vector of the leap
+ * seconds through an out-of-line comparison, as `elapsed_leap_seconds` used
+ * to; the "after" numbers use `builtin_leap_table` and `gps_time_t::ToUTC`.
+ */
+
+// [C++ headers]
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/leap_seconds.hpp"
+
+#include "bench_common.hpp"
+
+// [Namespaces]
+using namespace femtotime;
+
+namespace {
+
+__attribute__((noinline)) bool legacy_less(const gps_time_t &a,
+                                           const gps_time_t &b)
+{
+  return a.get_fs() < b.get_fs();
+}
+
+const std::vector<gps_time_t> legacy_table(gps_time_t::leap_seconds.begin(),
+                                           gps_time_t::leap_seconds.end());
+
+ptrdiff_t legacy_count(const gps_time_t &t)
+{
+  return std::upper_bound(legacy_table.begin(), legacy_table.end(), t,
+                          legacy_less) - legacy_table.begin();
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 1'000'000);
+  std::mt19937_64 rng(42);
+  std::vector<gps_time_t> historic;
+  std::vector<gps_time_t> current;
+  historic.reserve(count);
+  current.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    // 1975-2020, and 2020 onwards
+    auto secs = static_cast<femtosecs_t>(-150'000'000 + rng() % 1'400'000'000);
+    historic.emplace_back(secs * fs_per_sec);
+    secs = static_cast<femtosecs_t>(1'260'000'000 + rng() % 300'000'000);
+    current.emplace_back(secs * fs_per_sec);
+  }
+
+  for (auto [name, times] : {std::pair("historic", &historic),
+                             std::pair("current", &current)}) {
+    const auto &t = *times;
+    bench::compare(std::string("leap count, ") + name + " times",
+      bench::time_ops(count, [&](size_t i) {
+        bench::do_not_optimize(legacy_count(t[i]));
+      }),
+      bench::time_ops(count, [&](size_t i) {
+        auto fs = t[i].get_fs();
+        bench::do_not_optimize(builtin_leap_table.gps.count_through(fs));
+      }));
+    bench::report(std::string("gps_time_t::ToUTC(), ") + name + " times",
+      bench::time_ops(count, [&](size_t i) {
+        bench::do_not_optimize(t[i].ToUTC());
+      }));
+  }
+  return 0;
+}
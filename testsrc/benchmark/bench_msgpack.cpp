@@ -0,0 +1,111 @@
+/**
+ * @file   bench_msgpack.cpp
+ * @brief  Packing arrays of times: the old [high, low] arrays vs. the ext
+ *
+ * The "before" numbers pack and unpack each time as the two-`uint64` array
+ * that femtotime used to write, the "after" numbers as its 16-byte ext. The
+ * times are a sorted series of recent GPS times, whose high word is small, so
+ * the array form is at its most compact.
+ */
+
+// [C++ headers]
+#include <random>
+#include <vector>
+
+// [MessagePack headers]
+#include <msgpack.hpp>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/msgpack.hpp"
+
+#include "bench_common.hpp"
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace femtotime;
+
+namespace {
+
+/** @brief A time packed as femtotime used to pack it */
+struct legacy_time_t
+{
+  gps_time_t time;
+};
+
+} // namespace
+
+namespace msgpack {
+MSGPACK_API_VERSION_NAMESPACE(v2) {
+namespace adaptor {
+
+template<>
+struct pack<legacy_time_t> {
+  template<typename Stream>
+  packer<Stream>& operator()(msgpack::packer<Stream>& o,
+                             const legacy_time_t &t) const {
+    auto femtos = static_cast<uint128_t>(t.time.get_fs());
+    o.pack_array(2);
+    o.pack_uint64(static_cast<uint64_t>(femtos >> 64));
+    o.pack_uint64(static_cast<uint64_t>(femtos));
+    return o;
+  }
+};
+
+} // namespace adaptor
+} // namespace MSGPACK_API_VERSION_NAMESPACE
+} // namespace msgpack
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 10'000'000);
+  std::mt19937_64 rng(42);
+  std::vector<gps_time_t> times;
+  std::vector<legacy_time_t> legacy;
+  std::vector<msgpack_timestamp_t> timestamps;
+  times.reserve(count);
+  auto t = gps_time_t::FromUTCString("2024-01-01T00:00:00Z");
+  for (size_t i = 0; i < count; i++) {
+    t += duration_t(static_cast<femtosecs_t>(rng() % fs_per_sec));
+    times.push_back(t);
+    legacy.push_back({t});
+    timestamps.push_back({t.ToUTC()});
+  }
+
+  msgpack::sbuffer legacy_buffer;
+  msgpack::sbuffer ext_buffer;
+  msgpack::sbuffer timestamp_buffer;
+  bench::compare("pack",
+    bench::time_batch(count, [&] {
+      msgpack::pack(legacy_buffer, legacy);
+    }),
+    bench::time_batch(count, [&] {
+      msgpack::pack(ext_buffer, times);
+    }));
+  bench::report("pack msgpack_timestamp_t",
+    bench::time_batch(count, [&] {
+      msgpack::pack(timestamp_buffer, timestamps);
+    }));
+  fmt::print("{:<48} {:>10.2f} bytes/time\n", "size (before)",
+             static_cast<double>(legacy_buffer.size()) / count);
+  fmt::print("{:<48} {:>10.2f} bytes/time\n", "size (after)",
+             static_cast<double>(ext_buffer.size()) / count);
+  fmt::print("{:<48} {:>10.2f} bytes/time\n", "size (timestamp)",
+             static_cast<double>(timestamp_buffer.size()) / count);
+
+  std::vector<gps_time_t> decoded;
+  bench::compare("unpack and convert",
+    bench::time_batch(count, [&] {
+      auto handle = msgpack::unpack(legacy_buffer.data(),
+                                    legacy_buffer.size());
+      handle.get().convert(decoded);
+    }),
+    bench::time_batch(count, [&] {
+      auto handle = msgpack::unpack(ext_buffer.data(), ext_buffer.size());
+      handle.get().convert(decoded);
+    }));
+  bench::do_not_optimize(decoded.data());
+  return 0;
+}
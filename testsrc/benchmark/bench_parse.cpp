@@ -0,0 +1,136 @@
+/**
+ * @file   bench_parse.cpp
+ * @brief  Timestamp parsing: sscanf vs. the hand-written parser
+ *
+ * The "before" numbers use an out-of-line copy of the sscanf-based
+ * `FromUTCString`/`FromGPSString` that the library used to have; the "after"
+ * numbers call the library. The last comparison is on input with one record
+ * in ten malformed, caught as exceptions vs. checked with `TryFromUTCString`.
+ */
+
+// [C++ headers]
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_parse.hpp"
+
+#include "bench_common.hpp"
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace femtotime;
+
+namespace {
+
+__attribute__((noinline)) civil_fields_t
+legacy_scan(const std::string &text, const char *format_int,
+            const char *format_frac)
+{
+  civil_fields_t f{};
+  if (text.find(".") == std::string::npos) {
+    sscanf(text.c_str(), format_int,
+           &f.year, &f.month, &f.day, &f.hour, &f.minute, &f.second);
+  } else {
+    unsigned long long unscaled_partials;
+    int pre_partials, post_partials;
+    sscanf(text.c_str(), format_frac,
+           &f.year, &f.month, &f.day, &f.hour, &f.minute, &f.second,
+           &pre_partials, &unscaled_partials, &post_partials);
+    femtosecs_t total_femtos = unscaled_partials;
+    for (int i = post_partials - pre_partials; i < 15; i++) {
+      total_femtos *= 10;
+    }
+    f.nanosecond = total_femtos / fs_per_ns;
+    f.femtosecond = total_femtos % fs_per_ns;
+  }
+  return f;
+}
+
+gps_time_t legacy_from_utc_string(const std::string &text)
+{
+  auto f = legacy_scan(text, "%04d-%02d-%02dT%02d:%02d:%02d",
+                       "%04d-%02d-%02dT%02d:%02d:%02d.%n%llu%nZ");
+  utc_time_t parsed_time(f.year, f.month, f.day, f.hour, f.minute, f.second,
+                         f.nanosecond);
+  return gps_time_t::FromUTC(parsed_time) + duration_t(f.femtosecond);
+}
+
+gps_time_t legacy_from_gps_string(const std::string &text)
+{
+  auto f = legacy_scan(text, "GPS_%04d-%02d-%02dT%02d:%02d:%02dZ",
+                       "GPS_%04d-%02d-%02dT%02d:%02d:%02d.%n%llu%nZ");
+  return gps_time_t(f.year, f.month, f.day, f.hour, f.minute, f.second,
+                    f.nanosecond) + duration_t(f.femtosecond);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 1'000'000);
+  std::mt19937_64 rng(42);
+  std::vector<std::string> utc;
+  std::vector<std::string> gps;
+  utc.reserve(count);
+  gps.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    auto text = fmt::format("{:04}-{:02}-{:02}T{:02}:{:02}:{:02}.{:09}Z",
+                            2000 + rng() % 30, 1 + rng() % 12, 1 + rng() % 28,
+                            rng() % 24, rng() % 60, rng() % 60,
+                            rng() % 1'000'000'000);
+    gps.push_back("GPS_" + text);
+    utc.push_back(std::move(text));
+  }
+
+  bench::compare("parse civil fields",
+    bench::time_ops(count, [&](size_t i) {
+      bench::do_not_optimize(
+        legacy_scan(utc[i], "%04d-%02d-%02dT%02d:%02d:%02d",
+                    "%04d-%02d-%02dT%02d:%02d:%02d.%n%llu%nZ"));
+    }),
+    bench::time_ops(count, [&](size_t i) {
+      civil_fields_t fields;
+      parse_iso_fields(utc[i], iso_layout_t::extended, fields);
+      bench::do_not_optimize(fields);
+    }));
+
+  bench::compare("FromUTCString",
+    bench::time_ops(count, [&](size_t i) {
+      bench::do_not_optimize(legacy_from_utc_string(utc[i]));
+    }),
+    bench::time_ops(count, [&](size_t i) {
+      bench::do_not_optimize(gps_time_t::FromUTCString(utc[i]));
+    }));
+
+  bench::compare("FromGPSString",
+    bench::time_ops(count, [&](size_t i) {
+      bench::do_not_optimize(legacy_from_gps_string(gps[i]));
+    }),
+    bench::time_ops(count, [&](size_t i) {
+      bench::do_not_optimize(gps_time_t::FromGPSString(gps[i]));
+    }));
+
+  auto dirty = utc;
+  for (size_t i = 0; i < count; i += 10) {
+    dirty[i][rng() % dirty[i].size()] = '?';
+  }
+  bench::compare("dirty FromUTCString vs. TryFromUTCString",
+    bench::time_ops(count, [&](size_t i) {
+      try {
+        bench::do_not_optimize(gps_time_t::FromUTCString(dirty[i]));
+      } catch (const std::runtime_error &) {
+        bench::do_not_optimize(i);
+      }
+    }),
+    bench::time_ops(count, [&](size_t i) {
+      bench::do_not_optimize(TryFromUTCString(dirty[i]));
+    }));
+  return 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file   bench_parse_batch.cpp
+ * @brief  Parsing a column of fixed-width timestamps: per string vs. batch
+ *
+ * The column is a time series of about three years, with two leap seconds.
+ * The "before" numbers call `TryFromUTCString` on each row, then the batch
+ * parser is timed with each kernel the CPU supports.
+ */
+
+// [C++ headers]
+#include <random>
+#include <string>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_parse.hpp"
+#include "femtotime/time_parse_batch.hpp"
+
+#include "bench_common.hpp"
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace femtotime;
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 1'000'000);
+  std::mt19937_64 rng(42);
+  std::string data;
+  data.reserve(count * 30);
+  auto t = gps_time_t::FromUTCString("2015-01-01T00:00:00Z");
+  for (size_t i = 0; i < count; i++) {
+    t += duration_t(static_cast<femtosecs_t>(rng() % 200'000) * fs_per_ns
+                    * 1'000'000);
+    auto f = t.ToUTC().Fields();
+    data += fmt::format("{:04}-{:02}-{:02}T{:02}:{:02}:{:02}.{:09}Z",
+                        f.year, f.month, f.day, f.hour, f.minute, f.second,
+                        f.nanosecond);
+  }
+  iso_column_t column{data, 30, 9, true};
+  std::vector<gps_time_t> times(count);
+  std::vector<uint64_t> valid((count + 63) / 64);
+
+  auto per_string = bench::time_ops(count, [&](size_t i) {
+    bench::do_not_optimize(
+      TryFromUTCString(std::string_view(data).substr(i * 30, 30)));
+  });
+  auto kernel_names = {std::pair{parse_kernel_t::scalar, "scalar"},
+                       std::pair{parse_kernel_t::ssse3, "SSSE3"},
+                       std::pair{parse_kernel_t::avx2, "AVX2"}};
+  for (auto [kernel, name] : kernel_names) {
+    if (kernel > SupportedParseKernel()) {
+      continue;
+    }
+    ParseUTCColumn(column, times, valid, kernel);
+    bench::compare(fmt::format("ParseUTCColumn ({})", name), per_string,
+      bench::time_batch(count, [&] {
+        bench::do_not_optimize(ParseUTCColumn(column, times, valid, kernel));
+      }));
+  }
+  return 0;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file   bench_sort_search.cpp
+ * @brief  Sort and binary-search throughput over a vector of gps_time_t
+ *
+ * The "before" numbers go through an out-of-line comparison, the way every
+ * operator used to be defined in GPStime.cpp; the "after" numbers use the
+ * inline operators from GPStime.hpp. Defaults to 10^8 timestamps; pass a
+ * count on the command line to change it.
+ */
+
+// [C++ headers]
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+
+#include "bench_common.hpp"
+
+// [Namespaces]
+using namespace femtotime;
+
+namespace {
+
+__attribute__((noinline)) bool legacy_less(const gps_time_t &a,
+                                           const gps_time_t &b)
+{
+  return a.get_fs() < b.get_fs();
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 100'000'000);
+  std::mt19937_64 rng(42);
+  std::vector<gps_time_t> times;
+  times.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    auto secs = static_cast<femtosecs_t>(1'000'000'000 + rng() % 500'000'000);
+    times.emplace_back(secs * fs_per_sec + rng() % fs_per_sec);
+  }
+  std::vector<gps_time_t> keys(times.begin(),
+                               times.begin() + std::min<size_t>(count,
+                                                                1'000'000));
+  std::shuffle(keys.begin(), keys.end(), rng);
+
+  auto before = times;
+  auto sort_before = bench::time_batch(count, [&]() {
+    std::sort(before.begin(), before.end(), legacy_less);
+  });
+  auto after = times;
+  auto sort_after = bench::time_batch(count, [&]() {
+    std::sort(after.begin(), after.end());
+  });
+  bench::compare("std::sort", sort_before, sort_after);
+
+  bench::compare("std::lower_bound",
+    bench::time_ops(keys.size(), [&](size_t i) {
+      bench::do_not_optimize(std::lower_bound(before.begin(), before.end(),
+                                              keys[i], legacy_less));
+    }),
+    bench::time_ops(keys.size(), [&](size_t i) {
+      bench::do_not_optimize(std::lower_bound(after.begin(), after.end(),
+                                              keys[i]));
+    }));
+  return 0;
+}
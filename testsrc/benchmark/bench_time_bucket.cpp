@@ -0,0 +1,123 @@
+/**
+ * @file   bench_time_bucket.cpp
+ * @brief  Bucketing times: 128-bit division vs. time_grid_t, and a
+ *         conversion per time vs. CalendarBins
+ *
+ * Times are spread over years, so that each is in a 10 ms or 1 us bin of
+ * its own, except in one dense series. The "before" numbers divide each offset from the
+ * origin by the width with the built-in `/` and `%`, which call
+ * `__divti3`/`__modti3`, or bin each time by calendar on its own; the
+ * "after" numbers call the batch kernels.
+ */
+
+// [C++ headers]
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_bucket.hpp"
+
+#include "bench_common.hpp"
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace femtotime;
+
+namespace {
+
+/** @brief `count` sorted times over a few years */
+std::vector<gps_time_t> make_times(size_t count)
+{
+  std::mt19937_64 rng(42);
+  auto base = gps_time_t::FromUTCString("2015-01-01T00:00:00Z");
+  std::vector<gps_time_t> times(count);
+  for (auto &time : times) {
+    auto ns = static_cast<femtosecs_t>(rng() % (uint64_t{1} << 57));
+    time = base + duration_t(ns * fs_per_ns + rng() % fs_per_ns);
+  }
+  std::sort(times.begin(), times.end());
+  return times;
+}
+
+/** @brief Floor division of each offset from `origin` by `width` */
+void legacy_bins(const std::vector<gps_time_t> &times, femtosecs_t width,
+                 const gps_time_t &origin, std::vector<int64_t> &bins)
+{
+  for (size_t i = 0; i < times.size(); i++) {
+    auto offset = times[i].get_fs() - origin.get_fs();
+    auto quot = offset / width;
+    quot -= offset % width < 0;
+    bins[i] = static_cast<int64_t>(quot);
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 2'000'000);
+  auto times = make_times(count);
+  std::vector<int64_t> bins(count);
+  auto origin = gps_time_t::FromUTCString("2020-01-01T00:00:00Z");
+
+  const std::pair<const char *, femtosecs_t> widths[] = {
+    {"10 ms", 10 * fs_per_ms}, {"1 us", fs_per_us}, {"1 day", fs_per_day}};
+  for (auto [label, width] : widths) {
+    time_grid_t grid{duration_t(width), origin};
+    bench::compare(fmt::format("{} bins", label),
+      bench::time_batch(count, [&] {
+        legacy_bins(times, width, origin, bins);
+      }),
+      bench::time_batch(count, [&] {
+        grid.Bins(times, bins);
+      }));
+    bench::do_not_optimize(bins);
+  }
+
+  // A 1 MHz series, ten thousand samples to a bin
+  std::vector<gps_time_t> series(count);
+  for (size_t i = 0; i < count; i++) {
+    series[i] = origin + duration_t(femtosecs_t(i) * fs_per_us);
+  }
+  time_grid_t grid{duration_t(10 * fs_per_ms), origin};
+  bench::compare("10 ms bins of a 1 MHz series",
+    bench::time_batch(count, [&] {
+      legacy_bins(series, 10 * fs_per_ms, origin, bins);
+    }),
+    bench::time_batch(count, [&] {
+      grid.Bins(series, bins);
+    }));
+  bench::do_not_optimize(bins);
+
+  bench::compare("10 ms floor",
+    bench::time_ops(count, [&](size_t i) {
+      auto offset = times[i].get_fs() - origin.get_fs();
+      auto rem = offset % (10 * fs_per_ms);
+      rem += rem < 0 ? 10 * fs_per_ms : 0;
+      bench::do_not_optimize(gps_time_t(times[i].get_fs() - rem));
+    }),
+    bench::time_ops(count, [&](size_t i) {
+      bench::do_not_optimize(grid.Floor(times[i]));
+    }));
+
+  const std::pair<const char *, calendar_unit_t> units[] = {
+    {"day", calendar_unit_t::day}, {"month", calendar_unit_t::month},
+    {"year", calendar_unit_t::year}};
+  for (auto [label, unit] : units) {
+    bench::compare(fmt::format("UTC {} bins", label),
+      bench::time_batch(count, [&] {
+        for (size_t i = 0; i < count; i++) {
+          bins[i] = CalendarBin(times[i], unit);
+        }
+      }),
+      bench::time_batch(count, [&] {
+        CalendarBins(times, bins, unit);
+      }));
+    bench::do_not_optimize(bins);
+  }
+  return 0;
+}
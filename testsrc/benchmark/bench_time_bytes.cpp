@@ -0,0 +1,79 @@
+/**
+ * @file   bench_time_bytes.cpp
+ * @brief  Serializing a column of times: per-element byte splitting vs. the
+ *         span forms of ToBytes/FromBytes
+ *
+ * The "before" numbers split each count into high and low words and write
+ * them a byte at a time, big-endian, as a hand-written portable encoder
+ * (and the old msgpack adaptor) does.
+ */
+
+// [C++ headers]
+#include <bit>
+#include <random>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_bytes.hpp"
+
+#include "bench_common.hpp"
+
+// [Namespaces]
+using namespace femtotime;
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 10'000'000);
+  std::mt19937_64 rng(42);
+  std::vector<gps_time_t> times;
+  times.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    times.push_back(gps_time_t(static_cast<femtosecs_t>(rng()) * 1'000'000));
+  }
+  std::span<const gps_time_t> column(times);
+  std::vector<uint8_t> bytes(count * time_byte_size);
+  std::vector<gps_time_t> back(count);
+
+  auto split = bench::time_batch(count, [&] {
+    for (size_t i = 0; i < count; i++) {
+      auto bits = static_cast<uint128_t>(times[i].get_fs());
+      auto high = static_cast<uint64_t>(bits >> 64);
+      auto low = static_cast<uint64_t>(bits);
+      for (int b = 0; b < 8; b++) {
+        bytes[16 * i + b] = static_cast<uint8_t>(high >> (56 - 8 * b));
+        bytes[16 * i + 8 + b] = static_cast<uint8_t>(low >> (56 - 8 * b));
+      }
+    }
+    bench::do_not_optimize(bytes.data());
+  });
+  for (auto [order, name] : {std::pair{std::endian::little, "little"},
+                             {std::endian::big, "big"}}) {
+    bench::compare(fmt::format("ToBytes, {}-endian", name), split,
+      bench::time_batch(count, [&] {
+        bench::do_not_optimize(ToBytes(column, bytes, order));
+      }));
+  }
+
+  auto join = bench::time_batch(count, [&] {
+    for (size_t i = 0; i < count; i++) {
+      uint64_t high = 0;
+      uint64_t low = 0;
+      for (int b = 0; b < 8; b++) {
+        high = (high << 8) | bytes[16 * i + b];
+        low = (low << 8) | bytes[16 * i + 8 + b];
+      }
+      back[i] = gps_time_t(static_cast<femtosecs_t>(
+                             (static_cast<uint128_t>(high) << 64) | low));
+    }
+    bench::do_not_optimize(back.data());
+  });
+  for (auto [order, name] : {std::pair{std::endian::little, "little"},
+                             {std::endian::big, "big"}}) {
+    bench::compare(fmt::format("FromBytes, {}-endian", name), join,
+      bench::time_batch(count, [&] {
+        bench::do_not_optimize(FromBytes(bytes, std::span(back), order));
+      }));
+  }
+  return 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file   bench_time_codec.cpp
+ * @brief  Compressing a column of times with the delta-of-delta codec
+ *
+ * Three 1 kHz series: exactly regular, with nanosecond jitter, and with
+ * microsecond jitter. For each, the compression ratio against 16-byte times,
+ * the cost of encoding, and the cost of decoding with each kernel against
+ * copying the uncompressed column.
+ */
+
+// [C++ headers]
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_codec.hpp"
+
+#include "bench_common.hpp"
+
+// [Namespaces]
+using namespace femtotime;
+
+namespace {
+
+void run(const std::string &name, size_t count, uint64_t jitter)
+{
+  std::mt19937_64 rng(42);
+  std::vector<gps_time_t> times;
+  times.reserve(count);
+  auto start = gps_time_t::FromUTCString("2021-01-01T00:00:00Z");
+  for (size_t i = 0; i < count; i++) {
+    auto offset = jitter ? static_cast<femtosecs_t>(rng() % jitter) : 0;
+    times.push_back(start + duration_t(fs_per_sec / 1000 * i + offset));
+  }
+
+  auto data = EncodeTimeColumn(times);
+  double ratio = static_cast<double>(count * sizeof(gps_time_t)) / data.size();
+  fmt::print("{:<48} {:>10.1f}x ({} bytes)\n", name + " compression", ratio,
+             data.size());
+
+  auto encode = bench::time_batch(count, [&] {
+    bench::do_not_optimize(EncodeTimeColumn(times).data());
+  });
+  bench::report(name + " encode", encode);
+
+  std::vector<gps_time_t> out(count);
+  auto copy = bench::time_batch(count, [&] {
+    std::memcpy(out.data(), times.data(), count * sizeof(gps_time_t));
+    bench::do_not_optimize(out.data());
+  });
+  time_column_t column(data);
+  for (auto [kernel, label] : {std::pair{codec_kernel_t::scalar, "scalar"},
+                               {codec_kernel_t::automatic, "best"}}) {
+    auto decode = bench::time_batch(count, [&] {
+      column.Decode(0, out, kernel);
+      bench::do_not_optimize(out.data());
+    });
+    bench::compare(name + " decode, " + label + " vs. memcpy", copy, decode);
+    fmt::print("{:<48} {:>10.2f} GB/s of times\n", name + " decode, " + label,
+               sizeof(gps_time_t) / decode.ns_per_op);
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 10'000'000);
+  run("regular", count, 0);
+  run("1 ns jitter", count, fs_per_ns);
+  run("1 us jitter", count, fs_per_ns * 1000);
+  return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file   bench_time_file.cpp
+ * @brief  A time-range query on a stored column: reading it all vs. mapping
+ *
+ * The column is a week of times at about 16 Hz (10M by default). The
+ * "before" numbers answer each query the way a serialized column has to:
+ * read the whole file into a vector, then binary-search it. The "after"
+ * numbers open a `time_file_t` and call `Range()`, which reads the header,
+ * the index and the few pages the answer is on.
+ */
+
+// [C++ headers]
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_file.hpp"
+
+#include "bench_common.hpp"
+
+// [Namespaces]
+using namespace femtotime;
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 10'000'000);
+  auto start = gps_time_t::FromUTCString("2024-01-01T00:00:00Z");
+  auto step = duration_t(fs_per_day * 7 / count);
+  std::vector<gps_time_t> times;
+  times.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    times.push_back(start + step * static_cast<femtosecs_t>(i));
+  }
+  auto path = (std::filesystem::temp_directory_path()
+               / "femtotime_bench_times.bin").string();
+  WriteTimeFile(path, times);
+
+  // One-minute windows at random points in the week
+  std::mt19937_64 rng(42);
+  const size_t queries = 20;
+  std::vector<gps_time_t> begins;
+  for (size_t i = 0; i < queries; i++) {
+    begins.push_back(start + duration_t(static_cast<femtosecs_t>(
+                                          rng() % (6 * 86'400)) * fs_per_sec));
+  }
+  auto minute = duration_t(60 * fs_per_sec);
+
+  auto before = bench::time_batch(queries, [&] {
+    for (const auto &begin : begins) {
+      std::ifstream file(path, std::ios::binary);
+      file.seekg(0, std::ios::end);
+      std::vector<char> bytes(file.tellg());
+      file.seekg(0);
+      file.read(bytes.data(), bytes.size());
+      auto first = reinterpret_cast<const gps_time_t *>(bytes.data() + 4096);
+      auto last = first + count;
+      auto lower = std::lower_bound(first, last, begin);
+      auto upper = std::lower_bound(lower, last, begin + minute);
+      bench::do_not_optimize(upper - lower);
+    }
+  });
+  bench::compare("one-minute range query", before,
+    bench::time_batch(queries, [&] {
+      for (const auto &begin : begins) {
+        time_file_t file(path);
+        bench::do_not_optimize(file.Range(begin, begin + minute).size());
+      }
+    }));
+
+  time_file_t file(path);
+  bench::report("one-minute range query, file already open",
+    bench::time_ops(100'000, [&](size_t i) {
+      auto begin = begins[i % queries];
+      bench::do_not_optimize(file.Range(begin, begin + minute).size());
+    }));
+  std::filesystem::remove(path);
+  return 0;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file   bench_time_index.cpp
+ * @brief  Searching sorted times: std::lower_bound vs. time_index_t
+ *
+ * Runs at 10^6 keys and each tenfold size up to the count on the command
+ * line (10^7 by default). The times and the index take 32 bytes per key
+ * together, so 10^9 keys needs a machine with 32 GB to spare.
+ */
+
+// [C++ headers]
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_index.hpp"
+
+#include "bench_common.hpp"
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace femtotime;
+
+namespace {
+
+void run(size_t count, int power)
+{
+  std::mt19937_64 rng(42);
+  std::vector<gps_time_t> times;
+  times.reserve(count);
+  auto time = gps_time_t::FromUTCString("2020-01-01T00:00:00Z");
+  for (size_t i = 0; i < count; i++) {
+    time += duration_t(femtosecs_t(rng() % fs_per_ms));
+    times.push_back(time);
+  }
+  auto span = time - times.front();
+  size_t key_count = 1'000'000;
+  std::vector<gps_time_t> keys;
+  for (size_t i = 0; i < key_count; i++) {
+    keys.push_back(times.front() +
+                   duration_t(femtosecs_t(rng()) % span.get_fs()));
+  }
+  auto index = time_index_t(times);
+
+  auto name = fmt::format("10^{} keys", power);
+  bench::compare(name + ": lower_bound",
+    bench::time_ops(key_count, [&](size_t i) {
+      bench::do_not_optimize(std::lower_bound(
+        times.begin(), times.end(), keys[i]));
+    }),
+    bench::time_ops(key_count, [&](size_t i) {
+      bench::do_not_optimize(index.lower_bound(keys[i]));
+    }));
+  std::vector<size_t> found(key_count);
+  bench::compare(name + ": batched lower_bound",
+    bench::time_ops(key_count, [&](size_t i) {
+      found[i] = std::lower_bound(times.begin(), times.end(), keys[i]) -
+        times.begin();
+    }),
+    bench::time_batch(key_count, [&] {
+      index.LowerBounds(keys, found);
+    }));
+  bench::do_not_optimize(found);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 10'000'000);
+  int power = 6;
+  for (size_t size = 1'000'000; size <= count; size *= 10) {
+    run(size, power++);
+  }
+  return 0;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file   bench_time_join.cpp
+ * @brief  As-of joins: a std::upper_bound per left time vs. AsOfJoin
+ *
+ * Backward joins with a tolerance, for equal columns and for each side
+ * much longer than the other. With thirty right times per left one the
+ * join gallops; with a thousand it searches the whole right column.
+ */
+
+// [C++ headers]
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_join.hpp"
+
+#include "bench_common.hpp"
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace femtotime;
+
+namespace {
+
+/** @brief `count` sorted times over an hour */
+std::vector<gps_time_t> make_times(size_t count, uint64_t seed)
+{
+  std::mt19937_64 rng(seed);
+  auto base = gps_time_t::FromUTCString("2024-06-01T00:00:00Z");
+  std::vector<gps_time_t> times(count);
+  for (auto &time : times) {
+    time = base + duration_t(femtosecs_t(rng() % 3'600'000'000'000) *
+                             fs_per_ns);
+  }
+  std::sort(times.begin(), times.end());
+  return times;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 10'000'000);
+  auto tolerance = duration_t(fs_per_ms);
+  size_t shapes[][2] = {{count, count}, {count / 30, count},
+                        {count / 1000, count}, {count, count / 1000}};
+  for (auto [left_size, right_size] : shapes) {
+    auto left = make_times(left_size, 1);
+    auto right = make_times(right_size, 2);
+    std::vector<size_t> matches(left.size());
+    auto name = fmt::format("{} left, {} right", left_size, right_size);
+    bench::compare(name,
+      bench::time_batch(left_size, [&] {
+        for (size_t i = 0; i < left.size(); i++) {
+          auto upper = std::upper_bound(right.begin(), right.end(), left[i]);
+          matches[i] = join_no_match;
+          if (upper != right.begin() && left[i] - upper[-1] <= tolerance) {
+            matches[i] = upper - right.begin() - 1;
+          }
+        }
+      }),
+      bench::time_batch(left_size, [&] {
+        AsOfJoin(left, right, matches, join_direction_t::backward,
+                 tolerance);
+      }));
+    bench::do_not_optimize(matches);
+  }
+  return 0;
+}
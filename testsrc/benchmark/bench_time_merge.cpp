@@ -0,0 +1,142 @@
+/**
+ * @file   bench_time_merge.cpp
+ * @brief  Merging k sorted streams: a std::priority_queue heap vs. the
+ *         loser tree of time_merge_t
+ *
+ * The heap orders (time, stream) pairs, so it is stable too. Each stream
+ * holds times at random intervals, so the streams interleave closely and
+ * runs are short; the last comparison has each stream send bursts of 64
+ * times, and takes them a run at a time.
+ */
+
+// [C++ headers]
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_merge.hpp"
+
+#include "bench_common.hpp"
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace femtotime;
+
+namespace {
+
+using stream_t = span_stream_t<gps_time_t>;
+using entry_t = std::pair<gps_time_t, size_t>;
+
+std::vector<std::vector<gps_time_t>> make_streams(size_t streams,
+                                                  size_t total, size_t burst)
+{
+  std::mt19937_64 rng(streams);
+  std::vector<std::vector<gps_time_t>> out(streams);
+  auto base = gps_time_t::FromUTCString("2024-06-01T00:00:00Z");
+  for (size_t s = 0; s < streams; s++) {
+    auto time = base;
+    for (size_t i = 0; i < total / streams; i++) {
+      if (i % burst == 0) {
+        time += duration_t(femtosecs_t(rng() % (streams * burst)) * fs_per_us);
+      }
+      time += duration_t(fs_per_ns);
+      out[s].push_back(time);
+    }
+  }
+  return out;
+}
+
+/** @brief Merge with a binary heap, returning a checksum of the order */
+size_t heap_merge(const std::vector<std::vector<gps_time_t>> &streams)
+{
+  std::priority_queue<entry_t, std::vector<entry_t>, std::greater<entry_t>>
+    heap;
+  std::vector<size_t> next(streams.size(), 0);
+  for (size_t s = 0; s < streams.size(); s++) {
+    if (!streams[s].empty()) {
+      heap.push({streams[s][0], s});
+    }
+  }
+  size_t sum = 0;
+  while (!heap.empty()) {
+    auto [time, s] = heap.top();
+    heap.pop();
+    sum = sum * 31 + s;
+    if (++next[s] < streams[s].size()) {
+      heap.push({streams[s][next[s]], s});
+    }
+  }
+  return sum;
+}
+
+time_merge_t<stream_t> tree_for(
+  const std::vector<std::vector<gps_time_t>> &streams)
+{
+  std::vector<stream_t> spans;
+  for (const auto &stream : streams) {
+    spans.emplace_back(stream);
+  }
+  return time_merge_t<stream_t>(std::move(spans));
+}
+
+/** @brief Merge with the loser tree, one record at a time */
+size_t tree_merge(const std::vector<std::vector<gps_time_t>> &streams)
+{
+  auto merge = tree_for(streams);
+  size_t sum = 0;
+  while (!merge.empty()) {
+    sum = sum * 31 + merge.slot();
+    merge.pop();
+  }
+  return sum;
+}
+
+/** @brief Merge with the loser tree, a run at a time */
+size_t run_merge(const std::vector<std::vector<gps_time_t>> &streams)
+{
+  auto merge = tree_for(streams);
+  size_t sum = 0;
+  while (!merge.empty()) {
+    auto slot = merge.slot();
+    merge.PopRun([&](const gps_time_t &) {
+      sum = sum * 31 + slot;
+    });
+  }
+  return sum;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  size_t total = bench::count_arg(argc, argv, 10'000'000);
+  for (size_t streams : {16, 256, 1024, 4096}) {
+    auto name = fmt::format("k = {}", streams);
+    auto close = make_streams(streams, total, 1);
+    size_t heap_sum = 0;
+    size_t tree_sum = 0;
+    bench::compare(name + ", one at a time",
+      bench::time_batch(total, [&] { heap_sum = heap_merge(close); }),
+      bench::time_batch(total, [&] { tree_sum = tree_merge(close); }));
+    if (heap_sum != tree_sum) {
+      fmt::print("the merges disagree\n");
+      return 1;
+    }
+    auto bursts = make_streams(streams, total, 64);
+    bench::compare(name + ", bursts, runs",
+      bench::time_batch(total, [&] { heap_sum = heap_merge(bursts); }),
+      bench::time_batch(total, [&] { tree_sum = run_merge(bursts); }));
+    if (heap_sum != tree_sum) {
+      fmt::print("the merges disagree\n");
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file   bench_time_sort.cpp
+ * @brief  Sorting a column of times: std::sort and std::stable_sort vs. the
+ *         radix sorts
+ *
+ * The times are a day of telemetry at nanosecond resolution, shuffled, so
+ * the radix sort skips the high bytes that are the same in every time.
+ * The threaded sort uses one thread per core. Every timing copies the
+ * unsorted times first, so none of them starts from sorted data. The
+ * outlier cases add a single zero time, as a missing value or sentinel
+ * would, which widens the range of the column to decades.
+ */
+
+// [C++ headers]
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_sort.hpp"
+
+#include "bench_common.hpp"
+
+// [Namespaces]
+using namespace femtotime;
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 10'000'000);
+  std::mt19937_64 rng(42);
+  auto base = gps_time_t::FromUTCString("2024-06-01T00:00:00Z");
+  std::vector<gps_time_t> times;
+  times.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    auto ns = femtosecs_t(rng() % 86'400'000'000'000);
+    times.push_back(base + duration_t(ns * fs_per_ns));
+  }
+
+  auto sorted = times;
+  bench::compare("std::sort vs SortTimes",
+    bench::time_batch(count, [&] {
+      sorted = times;
+      std::sort(sorted.begin(), sorted.end());
+    }),
+    bench::time_batch(count, [&] {
+      sorted = times;
+      SortTimes(sorted);
+    }));
+  bench::compare("std::stable_sort vs SortTimes",
+    bench::time_batch(count, [&] {
+      sorted = times;
+      std::stable_sort(sorted.begin(), sorted.end());
+    }),
+    bench::time_batch(count, [&] {
+      sorted = times;
+      SortTimes(sorted);
+    }));
+  bench::compare("SortTimes, all threads",
+    bench::time_batch(count, [&] {
+      sorted = times;
+      SortTimes(sorted);
+    }),
+    bench::time_batch(count, [&] {
+      sorted = times;
+      SortTimes(sorted, 0);
+    }));
+
+  auto outlier = times;
+  outlier[count / 2] = gps_time_t(0);
+  bench::compare("SortTimes, without vs with an outlier",
+    bench::time_batch(count, [&] {
+      sorted = times;
+      SortTimes(sorted);
+    }),
+    bench::time_batch(count, [&] {
+      sorted = outlier;
+      SortTimes(sorted);
+    }));
+  bench::compare("SortTimes, all threads, without vs with an outlier",
+    bench::time_batch(count, [&] {
+      sorted = times;
+      SortTimes(sorted, 0);
+    }),
+    bench::time_batch(count, [&] {
+      sorted = outlier;
+      SortTimes(sorted, 0);
+    }));
+
+  std::vector<size_t> order(count);
+  bench::compare("stable_sort of positions vs SortedOrder",
+    bench::time_batch(count, [&] {
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return times[a] < times[b];
+      });
+    }),
+    bench::time_batch(count, [&] {
+      SortedOrder(times, order);
+    }));
+  return 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file   bench_time_writer.cpp
+ * @brief  Formatting a 1 MHz stream of times: FormatTo vs. time_writer_t
+ *
+ * The stream is one sample a microsecond from just before a leap second, so
+ * a run of a million crosses a few minutes and the leap second. The "before"
+ * numbers format every time from scratch with `FormatTo`.
+ */
+
+// [C++ headers]
+#include <string>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_writer.hpp"
+
+#include "bench_common.hpp"
+
+// [Namespaces]
+using namespace femtotime;
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 1'000'000);
+  auto start = gps_time_t::FromUTCString("2016-12-31T23:59:59.5Z");
+  std::vector<gps_time_t> times;
+  std::vector<utc_time_t> utc_times;
+  times.reserve(count);
+  utc_times.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    times.push_back(start + duration_t(static_cast<femtosecs_t>(i)
+                                       * fs_per_us));
+    utc_times.push_back(times.back().ToUTC());
+  }
+
+  char buffer[time_string_capacity];
+  for (auto format : {time_format_t{time_style_t::gps, time_precision_t::fs},
+                      time_format_t{time_style_t::extended,
+                                    time_precision_t::us}}) {
+    auto name = format.precision == time_precision_t::fs ? "fs" : "us";
+    gps_time_writer_t gps_writer(format);
+    bench::compare(std::string("gps_time_t, ") + name,
+      bench::time_ops(count, [&](size_t i) {
+        bench::do_not_optimize(times[i].FormatTo(buffer, format));
+        bench::do_not_optimize(buffer);
+      }),
+      bench::time_ops(count, [&](size_t i) {
+        bench::do_not_optimize(gps_writer.FormatTo(buffer, times[i]));
+        bench::do_not_optimize(buffer);
+      }));
+
+    utc_time_writer_t utc_writer(format);
+    bench::compare(std::string("utc_time_t, ") + name,
+      bench::time_ops(count, [&](size_t i) {
+        bench::do_not_optimize(utc_times[i].FormatTo(buffer, format));
+        bench::do_not_optimize(buffer);
+      }),
+      bench::time_ops(count, [&](size_t i) {
+        bench::do_not_optimize(utc_writer.FormatTo(buffer, utc_times[i]));
+        bench::do_not_optimize(buffer);
+      }));
+  }
+  return 0;
+}
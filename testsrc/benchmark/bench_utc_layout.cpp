@@ -0,0 +1,87 @@
+/**
+ * @file   bench_utc_layout.cpp
+ * @brief  Sorting and searching UTC times: the old 32-byte layout vs. the
+ *         packed 16-byte utc_time_t
+ *
+ * The "before" numbers use a copy of the old representation, a femtosecond
+ * count and a separate leap flag, with the old comparison that branches on
+ * the flags. Every thousandth time is in a leap second.
+ */
+
+// [C++ headers]
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+
+#include "bench_common.hpp"
+
+// [Namespaces]
+using namespace femtotime;
+
+namespace {
+
+struct legacy_utc_t
+{
+  femtosecs_t fs;
+  bool leap;
+
+  bool operator<(const legacy_utc_t &other) const
+  {
+    if (leap == other.leap) {
+      return fs < other.fs;
+    }
+    femtosecs_t delta = leap - other.leap;
+    return fs + delta * fs_per_sec < other.fs;
+  }
+};
+
+static_assert(sizeof(legacy_utc_t) == 32);
+static_assert(sizeof(utc_time_t) == 16);
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  size_t count = bench::count_arg(argc, argv, 10'000'000);
+  std::mt19937_64 rng(42);
+  std::vector<legacy_utc_t> legacy;
+  std::vector<utc_time_t> packed;
+  legacy.reserve(count);
+  packed.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    auto secs = static_cast<femtosecs_t>(1'000'000'000 + rng() % 500'000'000);
+    auto fs = secs * fs_per_sec + rng() % fs_per_sec;
+    bool leap = i % 1000 == 0;
+    legacy.push_back({fs, leap});
+    packed.push_back(utc_time_t(fs, leap));
+  }
+  size_t key_count = std::min<size_t>(count, 1'000'000);
+  std::vector<size_t> keys(key_count);
+  for (auto &key : keys) {
+    key = rng() % count;
+  }
+  auto legacy_keys = legacy;
+  auto packed_keys = packed;
+
+  bench::compare("std::sort",
+    bench::time_batch(count, [&] {
+      std::sort(legacy.begin(), legacy.end());
+    }),
+    bench::time_batch(count, [&] {
+      std::sort(packed.begin(), packed.end());
+    }));
+
+  bench::compare("std::lower_bound",
+    bench::time_ops(key_count, [&](size_t i) {
+      bench::do_not_optimize(std::lower_bound(
+        legacy.begin(), legacy.end(), legacy_keys[keys[i]]));
+    }),
+    bench::time_ops(key_count, [&](size_t i) {
+      bench::do_not_optimize(std::lower_bound(
+        packed.begin(), packed.end(), packed_keys[keys[i]]));
+    }));
+  return 0;
+}
@@ -0,0 +1,208 @@
+/**
+ * @file   test_unit_calendar.cpp
+ * @brief  Calendar core tests
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <array>
+#include <string>
+#include <tuple>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/calendar.hpp"
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+namespace {
+
+// The loop-based algorithm that the calendar core replaced. It is kept here
+// verbatim (less comments) as the reference for the equivalence tests.
+
+std::pair<int64_t, int64_t> legacy_euclidean_div(int64_t x, int64_t y)
+{
+  auto quot = x / y;
+  auto rem = x % y;
+  if (rem >= 0) {
+    return std::pair(quot, rem);
+  } else {
+    return std::pair(quot - 1, rem + y);
+  }
+}
+
+constexpr array<int, 12> legacy_rotated_month_days = {
+  31, 30, 31, 30, 31, 31, 30, 31, 30, 31, 31, 29
+};
+
+std::tuple<int, int, int> legacy_dayToDate(int64_t total_days,
+                                           int64_t y2000_epoch)
+{
+  auto adjusted_days = total_days - y2000_epoch;
+  auto [y400_cycles, y400_rem] = legacy_euclidean_div(adjusted_days, 146097);
+  auto [y100_cycles, y100_rem] = legacy_euclidean_div(y400_rem, 36524);
+  if (y100_cycles == 4) {
+    y100_cycles = 3;
+    y100_rem += 36524;
+  }
+  auto [y4_cycles, y4_rem] = legacy_euclidean_div(y100_rem, 1461);
+  auto [years, days] = legacy_euclidean_div(y4_rem, 365);
+  if (years == 4) {
+    years = 3;
+    days += 365;
+  }
+  int day_of_month = days;
+  int month = 0;
+  for (; day_of_month >= legacy_rotated_month_days[month]; month++) {
+    day_of_month -= legacy_rotated_month_days[month];
+  }
+  month = (month + 2) % 12;
+  bool adjust_year = month < 2;
+  auto year = years + 4*y4_cycles + 100*y100_cycles + 400*y400_cycles;
+  year += 2000 + adjust_year;
+  return {year, month + 1, day_of_month + 1};
+}
+
+int64_t legacy_dateToDays(int64_t year, int month, int day,
+                          int64_t y2000_epoch)
+{
+  year -= (month <= 2);
+  month = (month + 9) % 12;
+  year -= 2000;
+  auto day_of_year = day - 1;
+  for (int i = 0; i < month; i++) {
+    day_of_year += legacy_rotated_month_days[i];
+  }
+  auto [y400_cycles, y400_rem] = legacy_euclidean_div(year, 400);
+  auto day_of_cycle =
+    365 * y400_rem + y400_rem / 4 - y400_rem / 100 + day_of_year;
+  auto relative_day = y400_cycles * 146097 + day_of_cycle;
+  return relative_day + y2000_epoch;
+}
+
+int legacy_date2doy(int year, int month, int day)
+{
+  constexpr array<int, 12> basic = {
+    31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
+  };
+  int day_of_year = 0;
+  for (int mo = 0; mo < (month - 1); ++mo) {
+    day_of_year += basic[mo] + (mo == 1 && is_leap_year(year));
+  }
+  return day_of_year + (day - 1);
+}
+
+std::string date_string(const std::tuple<int, int, int> &date)
+{
+  auto [y, m, d] = date;
+  return std::to_string(y) + "-" + std::to_string(m) + "-" + std::to_string(d);
+}
+
+} // namespace
+
+/**
+ * @class CalendarCppUnit
+ */
+class CalendarCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(CalendarCppUnit);
+  CPPUNIT_TEST(test_days_to_date_equivalence);
+  CPPUNIT_TEST(test_date_to_days_equivalence);
+  CPPUNIT_TEST(test_day_of_year_equivalence);
+  CPPUNIT_TEST(test_epochs);
+  CPPUNIT_TEST(test_accessors);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void test_days_to_date_equivalence();
+  void test_date_to_days_equivalence();
+  void test_day_of_year_equivalence();
+  void test_epochs();
+  void test_accessors();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(CalendarCppUnit);
+
+/**
+ * @brief Compare against the legacy algorithm for every day in +/- 1,000,000
+ * days of each epoch
+ */
+void CalendarCppUnit::test_days_to_date_equivalence()
+{
+  for (int64_t epoch : {gps_y2000_epoch, utc_y2000_epoch, mjd_y2000_epoch}) {
+    for (int64_t day = -1'000'000; day <= 1'000'000; day++) {
+      auto expected = legacy_dayToDate(day, epoch);
+      auto actual = civil_from_days(day, epoch);
+      if (expected != actual) {
+        CPPUNIT_FAIL("civil_from_days(" + std::to_string(day) + ") gave "
+                     + date_string(actual) + ", expected "
+                     + date_string(expected));
+      }
+    }
+  }
+}
+
+void CalendarCppUnit::test_date_to_days_equivalence()
+{
+  for (int64_t epoch : {gps_y2000_epoch, utc_y2000_epoch, mjd_y2000_epoch}) {
+    for (int64_t day = -1'000'000; day <= 1'000'000; day++) {
+      auto [y, m, d] = legacy_dayToDate(day, epoch);
+      auto expected = legacy_dateToDays(y, m, d, epoch);
+      auto actual = days_from_civil(y, m, d, epoch);
+      if (expected != actual || actual != day) {
+        CPPUNIT_FAIL("days_from_civil(" + date_string({y, m, d}) + ") gave "
+                     + std::to_string(actual) + ", expected "
+                     + std::to_string(day));
+      }
+    }
+  }
+}
+
+void CalendarCppUnit::test_day_of_year_equivalence()
+{
+  for (int64_t day = -1'000'000; day <= 1'000'000; day++) {
+    auto [y, m, d] = legacy_dayToDate(day, gps_y2000_epoch);
+    CPPUNIT_ASSERT_EQUAL(legacy_date2doy(y, m, d), civil_day_of_year(y, m, d));
+  }
+}
+
+void CalendarCppUnit::test_epochs()
+{
+  using ymd = std::tuple<int, int, int>;
+  static_assert(civil_from_days(0, gps_y2000_epoch) == ymd(1980, 1, 6));
+  static_assert(civil_from_days(0, utc_y2000_epoch) == ymd(1970, 1, 1));
+  static_assert(civil_from_days(0, mjd_y2000_epoch) == ymd(1858, 11, 17));
+  static_assert(days_from_civil(2000, 2, 29, 0) == -1);
+
+  CPPUNIT_ASSERT(civil_from_days(-1, 0) == ymd(2000, 2, 29));
+  CPPUNIT_ASSERT(civil_from_days(0, 0) == ymd(2000, 3, 1));
+  CPPUNIT_ASSERT(civil_from_days(-36526, 0) == ymd(1900, 2, 28));
+  CPPUNIT_ASSERT(civil_from_days(days_from_civil(-4713, 11, 24, 0), 0)
+                 == ymd(-4713, 11, 24));
+  CPPUNIT_ASSERT(civil_from_days(days_from_civil(1'000'000, 12, 31, 0), 0)
+                 == ymd(1'000'000, 12, 31));
+}
+
+void CalendarCppUnit::test_accessors()
+{
+  // Spot check the class accessors that are built on the calendar core
+  for (int64_t day = -200'000; day <= 200'000; day += 7) {
+    gps_time_t t(day * fs_per_day + 5 * fs_per_hour);
+    auto [y, m, d] = legacy_dayToDate(day, gps_y2000_epoch);
+    CPPUNIT_ASSERT_EQUAL(y, t.Year());
+    CPPUNIT_ASSERT_EQUAL(m, t.Month());
+    CPPUNIT_ASSERT_EQUAL(d, t.Day());
+    CPPUNIT_ASSERT_EQUAL(legacy_date2doy(y, m, d) + 1, t.DayOfYear());
+    CPPUNIT_ASSERT(gps_time_t(y, m, d, 5, 0, 0, 0) == t);
+
+    utc_time_t u(day * fs_per_day);
+    auto utc_date = legacy_dayToDate(day, utc_y2000_epoch);
+    CPPUNIT_ASSERT(u.ToDate() == utc_date);
+  }
+}
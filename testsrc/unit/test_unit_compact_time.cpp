@@ -0,0 +1,230 @@
+/**
+ * @file   test_unit_compact_time.cpp
+ * @brief  Tests for the compact time and duration templates
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/compact_time.hpp"
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+/**
+ * @class CompactTimeCppUnit
+ */
+class CompactTimeCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(CompactTimeCppUnit);
+  CPPUNIT_TEST(test_layout);
+  CPPUNIT_TEST(test_checked_conversion);
+  CPPUNIT_TEST(test_fields);
+  CPPUNIT_TEST(test_formatting);
+  CPPUNIT_TEST(test_arithmetic);
+  CPPUNIT_TEST(test_spans);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void test_layout();
+  void test_checked_conversion();
+  void test_fields();
+  void test_formatting();
+  void test_arithmetic();
+  void test_spans();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(CompactTimeCppUnit);
+
+namespace {
+
+/** @brief Tenths of a second in 32 bits, a tick that isn't a power of 1000 */
+using gps_time_ds32_t = basic_gps_time<int32_t, std::deci>;
+
+/** @brief Minutes, a tick longer than a second */
+using gps_time_min_t = basic_gps_time<int64_t, std::ratio<60>>;
+
+} // namespace
+
+void CompactTimeCppUnit::test_layout()
+{
+  static_assert(sizeof(gps_time_ns_t) == 8);
+  static_assert(sizeof(duration_fs_t) == 8);
+  static_assert(sizeof(gps_time_ds32_t) == 4);
+  static_assert(gps_time_ns_t::fs_per_tick == fs_per_ns);
+  static_assert(gps_time_us_t::fs_per_tick == fs_per_us);
+  static_assert(gps_time_min_t::fs_per_tick == fs_per_min);
+  static_assert(duration_ns_t::default_precision == time_precision_t::ns);
+  static_assert(gps_time_ds32_t::default_format.precision
+                == time_precision_t::ms);
+  static_assert(gps_time_min_t::default_format.precision
+                == time_precision_t::s);
+  CPPUNIT_ASSERT(gps_time_ns_t().ToGPS() == gps_time_t());
+}
+
+void CompactTimeCppUnit::test_checked_conversion()
+{
+  auto time = gps_time_t::FromUTCString("2024-02-29T12:34:56.123456789Z");
+  auto ns = gps_time_ns_t::FromGPS(time);
+  CPPUNIT_ASSERT_EQUAL(time, ns.ToGPS());
+  CPPUNIT_ASSERT(time.get_fs() == ns.get_fs());
+  CPPUNIT_ASSERT(ns.count() * fs_per_ns == time.get_fs());
+
+  // Too precise: rejected unless floored
+  auto finer = time + duration_t(1);
+  CPPUNIT_ASSERT(gps_time_ns_t::Check(finer) == compact_check_t::inexact);
+  CPPUNIT_ASSERT_THROW(gps_time_ns_t::FromGPS(finer), std::runtime_error);
+  CPPUNIT_ASSERT(gps_time_ns_t::FloorGPS(finer) == ns);
+  // Floor rounds down before the epoch too
+  auto before = gps_time_t(-1);
+  CPPUNIT_ASSERT_EQUAL(int64_t{-1}, gps_time_ns_t::FloorGPS(before).count());
+
+  // Out of range: 2^63 ns after the epoch is in 2272
+  auto last = gps_time_ns_t(std::numeric_limits<int64_t>::max());
+  CPPUNIT_ASSERT_EQUAL(2272, last.Year());
+  CPPUNIT_ASSERT(gps_time_ns_t::Check(last.ToGPS())
+                 == compact_check_t::exact);
+  auto past = last.ToGPS() + duration_t(fs_per_ns);
+  CPPUNIT_ASSERT(gps_time_ns_t::Check(past)
+                 == compact_check_t::out_of_range);
+  CPPUNIT_ASSERT_THROW(gps_time_ns_t::FromGPS(past), std::runtime_error);
+  CPPUNIT_ASSERT_THROW(gps_time_ns_t::FloorGPS(past), std::runtime_error);
+  auto first = gps_time_ns_t(std::numeric_limits<int64_t>::min());
+  CPPUNIT_ASSERT(gps_time_ns_t::FloorGPS(first.ToGPS() + duration_t(1))
+                 == first);
+  CPPUNIT_ASSERT(gps_time_ns_t::Check(first.ToGPS() - duration_t(1))
+                 == compact_check_t::out_of_range);
+
+  // Durations
+  CPPUNIT_ASSERT_EQUAL(int64_t{3'000'000},
+                       duration_fs_t::FromDuration(duration_t(3'000'000))
+                       .count());
+  CPPUNIT_ASSERT_EQUAL(int64_t{-2}, duration_ns_t::FloorDuration(
+                         duration_t(-fs_per_ns - 1)).count());
+  CPPUNIT_ASSERT_THROW(duration_ns_t::FromDuration(duration_t(1)),
+                       std::runtime_error);
+  CPPUNIT_ASSERT_THROW(duration_fs_t::FromDuration(duration_t(fs_per_day)),
+                       std::runtime_error);
+}
+
+void CompactTimeCppUnit::test_fields()
+{
+  // Around the epoch, leap days, and the ends of the range
+  std::mt19937_64 rng(99);
+  std::vector<gps_time_ns_t> times = {
+    gps_time_ns_t(0), gps_time_ns_t(-1), gps_time_ns_t(1),
+    gps_time_ns_t(std::numeric_limits<int64_t>::max()),
+    gps_time_ns_t(std::numeric_limits<int64_t>::min())};
+  for (int i = 0; i < 10'000; i++) {
+    times.push_back(gps_time_ns_t(static_cast<int64_t>(rng())));
+  }
+  for (const auto &time : times) {
+    auto wide = time.ToGPS();
+    auto expected = wide.Fields();
+    auto fields = time.Fields();
+    CPPUNIT_ASSERT_EQUAL(expected.year, fields.year);
+    CPPUNIT_ASSERT_EQUAL(expected.month, fields.month);
+    CPPUNIT_ASSERT_EQUAL(expected.day, fields.day);
+    CPPUNIT_ASSERT_EQUAL(expected.hour, fields.hour);
+    CPPUNIT_ASSERT_EQUAL(expected.minute, fields.minute);
+    CPPUNIT_ASSERT_EQUAL(expected.second, fields.second);
+    CPPUNIT_ASSERT_EQUAL(expected.nanosecond, fields.nanosecond);
+    CPPUNIT_ASSERT_EQUAL(expected.femtosecond, fields.femtosecond);
+    CPPUNIT_ASSERT_EQUAL(expected.day_of_year, fields.day_of_year);
+    CPPUNIT_ASSERT_EQUAL(wide.Year(), time.Year());
+    CPPUNIT_ASSERT_EQUAL(wide.DayOfYear(), time.DayOfYear());
+    CPPUNIT_ASSERT_EQUAL(wide.Nanoseconds(), time.Nanoseconds());
+  }
+  // The other tick sizes agree too
+  for (int i = 0; i < 1'000; i++) {
+    gps_time_ds32_t deci(static_cast<int32_t>(rng()));
+    CPPUNIT_ASSERT_EQUAL(deci.ToGPS().ToString(), deci.ToString(
+                           {time_style_t::gps, time_precision_t::fs}));
+    gps_time_min_t minutes(static_cast<int64_t>(rng() >> 30));
+    CPPUNIT_ASSERT_EQUAL(minutes.ToGPS().ToString(), minutes.ToString(
+                           {time_style_t::gps, time_precision_t::fs}));
+  }
+  CPPUNIT_ASSERT(gps_time_ns_t(5).ToUTC()
+                 == gps_time_t(5 * fs_per_ns).ToUTC());
+}
+
+void CompactTimeCppUnit::test_formatting()
+{
+  auto ns = gps_time_ns_t::FromGPS(
+    gps_time_t::FromGPSString("GPS_2024-02-29T12:34:56.123456789Z"));
+  CPPUNIT_ASSERT_EQUAL(std::string("GPS_2024-02-29T12:34:56.123456789Z"),
+                       ns.ToString());
+  CPPUNIT_ASSERT_EQUAL(std::string("2024-02-29T12:34:56.123Z"),
+                       ns.ToString({time_style_t::extended,
+                                    time_precision_t::ms}));
+  CPPUNIT_ASSERT_EQUAL(std::string("GPS_2024-02-29T12:34:56.123456789Z"),
+                       fmt::format("{}", ns));
+  CPPUNIT_ASSERT_EQUAL(std::string("20240229T123456.123456Z"),
+                       fmt::format("{:basic.us}", ns));
+  CPPUNIT_ASSERT_EQUAL(std::string("GPS_1980-01-06T00:00:00.100Z"),
+                       gps_time_ds32_t(1).ToString());
+  CPPUNIT_ASSERT_EQUAL(std::string("GPS_1980-01-06T00:01:00Z"),
+                       gps_time_min_t(1).ToString());
+
+  CPPUNIT_ASSERT_EQUAL(std::string("1.500000000s"),
+                       fmt::format("{}", duration_ns_t(1'500'000'000)));
+  CPPUNIT_ASSERT_EQUAL(std::string("-0.000000000000002s"),
+                       fmt::format("{}", duration_fs_t(-2)));
+  CPPUNIT_ASSERT_EQUAL(std::string("1.500s"),
+                       fmt::format("{:.ms}", duration_ns_t(1'500'000'000)));
+}
+
+void CompactTimeCppUnit::test_arithmetic()
+{
+  gps_time_ns_t a(1'000);
+  duration_ns_t step(250);
+  CPPUNIT_ASSERT(a + step == gps_time_ns_t(1'250));
+  CPPUNIT_ASSERT(a - step == gps_time_ns_t(750));
+  CPPUNIT_ASSERT((a + step) - a == step);
+  CPPUNIT_ASSERT(a < a + step && step > duration_ns_t());
+  CPPUNIT_ASSERT(step + step - step == step);
+
+  // Femtosecond offsets from a per-block base
+  auto base = gps_time_t::FromUTCString("2030-01-01T00:00:00Z");
+  auto later = base + duration_t(fs_per_sec * 3'600 + 7);
+  auto offset = duration_fs_t::FromDuration(later - base);
+  CPPUNIT_ASSERT_EQUAL(later, base + offset.ToDuration());
+}
+
+void CompactTimeCppUnit::test_spans()
+{
+  std::vector<gps_time_t> wide;
+  for (int i = 0; i < 100; i++) {
+    wide.push_back(gps_time_t(femtosecs_t{i} * 1'234 * fs_per_ns));
+  }
+  std::vector<gps_time_ns_t> narrow(wide.size());
+  FromGPS(std::span<const gps_time_t>(wide), std::span(narrow));
+  std::vector<gps_time_t> back(wide.size());
+  ToGPS(std::span<const gps_time_ns_t>(narrow), std::span(back));
+  CPPUNIT_ASSERT(wide == back);
+
+  wide[42] += duration_t(1);
+  try {
+    FromGPS(std::span<const gps_time_t>(wide), std::span(narrow));
+    CPPUNIT_FAIL("FromGPS accepted a time with femtoseconds");
+  } catch (const std::runtime_error &error) {
+    CPPUNIT_ASSERT(std::string(error.what()).find("time 42") !=
+                   std::string::npos);
+  }
+  CPPUNIT_ASSERT_THROW(ToGPS(std::span<const gps_time_ns_t>(narrow),
+                             std::span(back).first(99)), std::runtime_error);
+}
@@ -43,6 +43,8 @@ class GPSTimeCppUnit : public CppUnit::TestFixture
   CPPUNIT_TEST(test_to_utc);
   CPPUNIT_TEST(test_leap_second_order);
   CPPUNIT_TEST(test_from_gps_str);
+  CPPUNIT_TEST(test_fields);
+  CPPUNIT_TEST(test_constexpr_ops);
   CPPUNIT_TEST_SUITE_END();
 public: 
   void setUp(){}
@@ -59,6 +61,8 @@ public:
   void test_to_utc();
   void test_leap_second_order();
   void test_from_gps_str();
+  void test_fields();
+  void test_constexpr_ops();
 };
 CPPUNIT_TEST_SUITE_REGISTRATION(GPSTimeCppUnit);
 
@@ -794,4 +798,65 @@ void GPSTimeCppUnit::test_from_gps_str() {
     time1, time2
   );
 }
+void GPSTimeCppUnit::test_fields() {
+  auto time1 = gps_time_t(2022, 1, 1, 12, 34, 56, 789'012'345)
+    + duration_t(678'901);
+  auto f = time1.Fields();
+  CPPUNIT_ASSERT_EQUAL(2022, f.year);
+  CPPUNIT_ASSERT_EQUAL(1, f.month);
+  CPPUNIT_ASSERT_EQUAL(1, f.day);
+  CPPUNIT_ASSERT_EQUAL(12, f.hour);
+  CPPUNIT_ASSERT_EQUAL(34, f.minute);
+  CPPUNIT_ASSERT_EQUAL(56, f.second);
+  CPPUNIT_ASSERT_EQUAL(789'012'345, f.nanosecond);
+  CPPUNIT_ASSERT_EQUAL(678'901, f.femtosecond);
+  CPPUNIT_ASSERT_EQUAL(1, f.day_of_year);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(
+    "Round trip through civil_fields_t failed", time1, gps_time_t(f)
+  );
+
+  // The fields must agree with the individual accessors, including for times
+  // before the epoch
+  std::vector<gps_time_t> times = {
+    gps_time_t(0),
+    gps_time_t(-1),
+    gps_time_t(1600, 2, 29, 23, 59, 59, 999'999'999),
+    gps_time_t(1969, 12, 31, 23, 59, 59, 500'000'000),
+    gps_time_t(2000, 2, 29, 6, 7, 8, 9),
+    gps_time_t(2016, 12, 31, 23, 59, 59, 0),
+  };
+  for (const auto& t : times) {
+    auto tf = t.Fields();
+    CPPUNIT_ASSERT_EQUAL(t.Year(), tf.year);
+    CPPUNIT_ASSERT_EQUAL(t.Month(), tf.month);
+    CPPUNIT_ASSERT_EQUAL(t.Day(), tf.day);
+    CPPUNIT_ASSERT_EQUAL(t.Hour(), tf.hour);
+    CPPUNIT_ASSERT_EQUAL(t.Minute(), tf.minute);
+    CPPUNIT_ASSERT_EQUAL(t.WholeSeconds(), tf.second);
+    CPPUNIT_ASSERT_EQUAL(t.Nanoseconds(), tf.nanosecond);
+    CPPUNIT_ASSERT_EQUAL(t.DayOfYear(), tf.day_of_year);
+    CPPUNIT_ASSERT_EQUAL(t, gps_time_t(tf));
+  }
+}
+
+void GPSTimeCppUnit::test_constexpr_ops() {
+  // The trivial operations are usable in constant expressions
+  constexpr gps_time_t t1(10 * fs_per_sec);
+  constexpr duration_t d(fs_per_sec);
+  static_assert((t1 + d).get_fs() == 11 * fs_per_sec);
+  static_assert(t1 - d < t1 && t1 + d > t1);
+  static_assert(((t1 + d) - t1) == d);
+  static_assert((d * femtosecs_t(3)).get_fs() == 3 * fs_per_sec);
+  static_assert(d.invert_sign().is_negative());
+  static_assert(utc_time_t(0, true) > utc_time_t(0));
+
+  // operator<=> agrees with the femtosecond count
+  gps_time_t t2(-5);
+  CPPUNIT_ASSERT((t1 <=> t2) == std::strong_ordering::greater);
+  CPPUNIT_ASSERT((t2 <=> t2) == std::strong_ordering::equal);
+  CPPUNIT_ASSERT((d <=> d * femtosecs_t(2)) == std::strong_ordering::less);
+  gps_time_t t3 = t2;
+  t3 += d;
+  CPPUNIT_ASSERT(t3.get_fs() == fs_per_sec - 5);
+}
 } /* namespace test */
@@ -0,0 +1,137 @@
+/**
+ * @file   test_unit_leap_cursor.cpp
+ * @brief  Tests for the streaming GPS/UTC converter and batch conversions
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/leap_cursor.hpp"
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+/**
+ * @class LeapCursorCppUnit
+ */
+class LeapCursorCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(LeapCursorCppUnit);
+  CPPUNIT_TEST(test_sorted);
+  CPPUNIT_TEST(test_unsorted);
+  CPPUNIT_TEST(test_batch);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void test_sorted();
+  void test_unsorted();
+  void test_batch();
+
+private:
+  std::vector<gps_time_t> sample_times();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(LeapCursorCppUnit);
+
+/**
+ * @brief Sorted times around every leap second (including within them) and
+ * before, between and after the table
+ */
+std::vector<gps_time_t> LeapCursorCppUnit::sample_times()
+{
+  std::vector<gps_time_t> times = {gps_time_t(0),
+                                   gps_time_t(-fs_per_day * 20'000),
+                                   gps_time_t(fs_per_day * 30'000)};
+  for (const auto &leap : gps_time_t::leap_seconds) {
+    for (auto delta = -2 * fs_per_sec; delta <= 2 * fs_per_sec;
+         delta += fs_per_sec / 4) {
+      times.push_back(gps_time_t(leap.get_fs() + delta));
+      times.push_back(gps_time_t(leap.get_fs() + delta - 1));
+    }
+  }
+  std::mt19937_64 rng(1972);
+  for (int i = 0; i < 10'000; i++) {
+    auto secs = static_cast<femtosecs_t>(rng() % 2'000'000'000) - 300'000'000;
+    times.push_back(gps_time_t(secs * fs_per_sec + rng() % fs_per_sec));
+  }
+  std::sort(times.begin(), times.end());
+  return times;
+}
+
+namespace {
+
+void check_against_per_element(leap_cursor_t &cursor,
+                               const std::vector<gps_time_t> &times)
+{
+  for (const auto &t : times) {
+    auto expected = t.ToUTC();
+    auto actual = cursor.ToUTC(t);
+    CPPUNIT_ASSERT(expected.get_fs() == actual.get_fs());
+    CPPUNIT_ASSERT_EQUAL(expected.is_leap(), actual.is_leap());
+    CPPUNIT_ASSERT_EQUAL(t, cursor.FromUTC(actual));
+    CPPUNIT_ASSERT_EQUAL(gps_time_t::FromUTC(actual), cursor.FromUTC(actual));
+    CPPUNIT_ASSERT_EQUAL(LeapSecondsBetween(utc_time_t::gps_epoch, actual),
+                         static_cast<int>(cursor.Elapsed(actual)));
+  }
+}
+
+} // namespace
+
+void LeapCursorCppUnit::test_sorted()
+{
+  auto times = sample_times();
+  leap_cursor_t cursor;
+  check_against_per_element(cursor, times);
+
+  // Backwards, so every segment change is a jump back
+  std::reverse(times.begin(), times.end());
+  check_against_per_element(cursor, times);
+}
+
+void LeapCursorCppUnit::test_unsorted()
+{
+  auto times = sample_times();
+  std::shuffle(times.begin(), times.end(), std::mt19937_64(6));
+  leap_cursor_t cursor;
+  check_against_per_element(cursor, times);
+}
+
+void LeapCursorCppUnit::test_batch()
+{
+  auto times = sample_times();
+  std::vector<utc_time_t> utc(times.size());
+  ToUTC(times, utc);
+  std::vector<gps_time_t> gps(times.size());
+  FromUTC(utc, gps);
+  for (size_t i = 0; i < times.size(); i++) {
+    auto expected = times[i].ToUTC();
+    CPPUNIT_ASSERT(expected.get_fs() == utc[i].get_fs());
+    CPPUNIT_ASSERT_EQUAL(expected.is_leap(), utc[i].is_leap());
+    CPPUNIT_ASSERT_EQUAL(times[i], gps[i]);
+  }
+
+  // Pair each time with one a year later
+  std::vector<utc_time_t> later(utc.size());
+  for (size_t i = 0; i < utc.size(); i++) {
+    later[i] = utc_time_t(utc[i].get_fs() + fs_per_year);
+  }
+  std::vector<int> between(utc.size());
+  LeapSecondsBetween(utc, later, between);
+  for (size_t i = 0; i < utc.size(); i++) {
+    CPPUNIT_ASSERT_EQUAL(LeapSecondsBetween(utc[i], later[i]), between[i]);
+  }
+
+  std::vector<utc_time_t> too_short(utc.size() - 1);
+  CPPUNIT_ASSERT_THROW(ToUTC(times, too_short), std::runtime_error);
+}
@@ -0,0 +1,300 @@
+/**
+ * @file   test_unit_leap_seconds.cpp
+ * @brief  Tests for the compile-time leap-second tables and their index
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/leap_seconds.hpp"
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+// Constant initialization: usable from other translation units' static
+// initializers without any ordering concerns
+static_assert(gps_time_t::leap_seconds[0].get_fs() < 0);
+static_assert(utc_time_t::leap_seconds.back().is_leap());
+static_assert(gps_time_t::utc_epoch.get_fs() == -315'964'809 * fs_per_sec);
+
+/**
+ * @class LeapSecondsCppUnit
+ */
+class LeapSecondsCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(LeapSecondsCppUnit);
+  CPPUNIT_TEST(test_tables);
+  CPPUNIT_TEST(test_index);
+  CPPUNIT_TEST(test_round_trip);
+  CPPUNIT_TEST(test_parse_list);
+  CPPUNIT_TEST(test_parse_tzdata);
+  CPPUNIT_TEST(test_load_file);
+  CPPUNIT_TEST(test_reload_stress);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() { ResetLeapSeconds(); }
+  void test_tables();
+  void test_index();
+  void test_round_trip();
+  void test_parse_list();
+  void test_parse_tzdata();
+  void test_load_file();
+  void test_reload_stress();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(LeapSecondsCppUnit);
+
+namespace {
+
+// Excerpt of the IETF leap-seconds.list, with a made-up leap second on
+// 2026-06-30 appended
+const char *leap_seconds_list = R"(#
+#	In the following text, the symbol '#' introduces
+#	a comment, which continues from that symbol until
+#	the end of the line.
+#
+#$	 3676924800
+#@	3960057600
+#
+2272060800	10	# 1 Jan 1972
+2287785600	11	# 1 Jul 1972
+2303683200	12	# 1 Jan 1973
+2335219200	13	# 1 Jan 1974
+2366755200	14	# 1 Jan 1975
+2398291200	15	# 1 Jan 1976
+2429913600	16	# 1 Jan 1977
+2461449600	17	# 1 Jan 1978
+2492985600	18	# 1 Jan 1979
+2524521600	19	# 1 Jan 1980
+2571782400	20	# 1 Jul 1981
+2603318400	21	# 1 Jul 1982
+2634854400	22	# 1 Jul 1983
+2698012800	23	# 1 Jul 1985
+2776982400	24	# 1 Jan 1988
+2840140800	25	# 1 Jan 1990
+2871676800	26	# 1 Jan 1991
+2918937600	27	# 1 Jul 1992
+2950473600	28	# 1 Jul 1993
+2982009600	29	# 1 Jul 1994
+3029443200	30	# 1 Jan 1996
+3076704000	31	# 1 Jul 1997
+3124137600	32	# 1 Jan 1999
+3345062400	33	# 1 Jan 2006
+3439756800	34	# 1 Jan 2009
+3550089600	35	# 1 Jul 2012
+3644697600	36	# 1 Jul 2015
+3692217600	37	# 1 Jan 2017
+3991852800	38	# 1 Jul 2026
+#h	16edd0f0 3666784f 37db6bdd e74ced87 59af48f1
+)";
+
+const char *tzdata_leapseconds = R"(# Allowance for leap seconds added to each time zone.
+Leap	1972	Jun	30	23:59:60	+	S
+Leap	1972	Dec	31	23:59:60	+	S
+Leap	2016	Dec	31	23:59:60	+	S
+
+# POSIX timestamps for the data in this file:
+#updated 1467936000 (2016-07-08 00:00:00 UTC)
+Expires	2027	Jun	28	00:00:00
+)";
+
+/** @brief The built-in leap seconds plus one on 2026-06-30 */
+std::vector<leap_date_t> extended_dates()
+{
+  std::vector<leap_date_t> dates(leap_second_dates.begin(),
+                                 leap_second_dates.end());
+  dates.push_back({2026, 6, 30});
+  return dates;
+}
+
+} // namespace
+
+void LeapSecondsCppUnit::test_tables()
+{
+  // The tables match the dates they are generated from
+  for (size_t i = 0; i < leap_second_count; i++) {
+    auto [year, month, day] = leap_second_dates[i];
+    auto f = utc_time_t::leap_seconds[i].Fields();
+    CPPUNIT_ASSERT_EQUAL(year, f.year);
+    CPPUNIT_ASSERT_EQUAL(month, f.month);
+    CPPUNIT_ASSERT_EQUAL(day, f.day);
+    CPPUNIT_ASSERT_EQUAL(23, f.hour);
+    CPPUNIT_ASSERT_EQUAL(59, f.minute);
+    CPPUNIT_ASSERT_EQUAL(60, f.second);
+  }
+  CPPUNIT_ASSERT_EQUAL(gps_time_t(1972, 6, 30, 23, 59, 51, 0),
+                       gps_time_t::leap_seconds.front());
+  CPPUNIT_ASSERT_EQUAL(gps_time_t(2017, 1, 1, 0, 0, 17, 0),
+                       gps_time_t::leap_seconds.back());
+}
+
+/**
+ * @brief The index agrees with a binary search at and around every entry, and
+ * at random times spanning the table
+ */
+void LeapSecondsCppUnit::test_index()
+{
+  std::vector<femtosecs_t> times = {0, -fs_per_day * 10'000,
+                                    fs_per_day * 100'000};
+  for (auto fs : gps_leap_fs) {
+    for (femtosecs_t delta : {-fs_per_sec, femtosecs_t(-1), femtosecs_t(0),
+                              femtosecs_t(1), fs_per_sec - 1, fs_per_sec}) {
+      times.push_back(fs + delta);
+      times.push_back(fs + fs_per_sec + delta);
+    }
+  }
+  std::mt19937_64 rng(2016);
+  auto span = gps_leap_fs.back() - gps_leap_fs.front() + 2 * fs_per_day;
+  for (int i = 0; i < 100'000; i++) {
+    auto offset = static_cast<femtosecs_t>(
+      ((static_cast<uint128_t>(rng()) << 64) | rng()) % span);
+    times.push_back(gps_leap_fs.front() - fs_per_day + offset);
+  }
+
+  for (auto fs : times) {
+    auto expected = std::upper_bound(gps_leap_fs.begin(), gps_leap_fs.end(),
+                                     fs) - gps_leap_fs.begin();
+    CPPUNIT_ASSERT_EQUAL(expected, builtin_leap_table.gps.count_through(fs));
+    expected = std::upper_bound(utc_leap_fs.begin(), utc_leap_fs.end(),
+                                fs - fs_per_sec) - utc_leap_fs.begin();
+    CPPUNIT_ASSERT_EQUAL(expected, builtin_leap_table.utc.count_through(fs));
+  }
+}
+
+/**
+ * @brief Converting to UTC and back is exact on either side of, and during,
+ * each leap second
+ */
+void LeapSecondsCppUnit::test_round_trip()
+{
+  for (const auto &leap : gps_time_t::leap_seconds) {
+    for (femtosecs_t delta : {-fs_per_sec, femtosecs_t(-1), femtosecs_t(0),
+                              fs_per_sec / 2, fs_per_sec - 1, fs_per_sec}) {
+      gps_time_t t(leap.get_fs() + delta);
+      auto utc = t.ToUTC();
+      CPPUNIT_ASSERT_EQUAL(delta >= 0 && delta < fs_per_sec, utc.is_leap());
+      CPPUNIT_ASSERT_EQUAL(t, gps_time_t::FromUTC(utc));
+    }
+  }
+}
+
+void LeapSecondsCppUnit::test_parse_list()
+{
+  std::istringstream input(leap_seconds_list);
+  CPPUNIT_ASSERT(extended_dates() == ParseLeapSecondsList(input));
+
+  std::istringstream negative("2272060800 10\n2287785600 9\n");
+  CPPUNIT_ASSERT_THROW(ParseLeapSecondsList(negative), std::runtime_error);
+  std::istringstream garbage("2272060800 10\nnot a line\n");
+  CPPUNIT_ASSERT_THROW(ParseLeapSecondsList(garbage), std::runtime_error);
+}
+
+void LeapSecondsCppUnit::test_parse_tzdata()
+{
+  std::istringstream input(tzdata_leapseconds);
+  std::vector<leap_date_t> expected = {
+    {1972, 6, 30}, {1972, 12, 31}, {2016, 12, 31}
+  };
+  CPPUNIT_ASSERT(expected == ParseTzdataLeapSeconds(input));
+
+  std::istringstream negative("Leap 2030 Jun 30 23:59:59 - S\n");
+  CPPUNIT_ASSERT_THROW(ParseTzdataLeapSeconds(negative), std::runtime_error);
+}
+
+void LeapSecondsCppUnit::test_load_file()
+{
+  auto path = std::filesystem::temp_directory_path()
+    / "femtotime_test_leap-seconds.list";
+  {
+    std::ofstream file(path);
+    file << leap_seconds_list;
+  }
+  LoadLeapSecondsFile(path.string());
+  std::filesystem::remove(path);
+
+  // A time after the new leap second is one second further from UTC
+  gps_time_t gps(2026, 7, 2, 0, 0, 0, 0);
+  CPPUNIT_ASSERT_EQUAL(utc_time_t(2026, 7, 1, 23, 59, 41), gps.ToUTC());
+  CPPUNIT_ASSERT_EQUAL(gps, gps_time_t::FromUTC(gps.ToUTC()));
+  utc_time_t leap(2026, 6, 30, 23, 59, 60);
+  CPPUNIT_ASSERT(leap.is_leap());
+  CPPUNIT_ASSERT(gps_time_t::FromUTC(leap).ToUTC().is_leap());
+
+  ResetLeapSeconds();
+  CPPUNIT_ASSERT_EQUAL(utc_time_t(2026, 7, 1, 23, 59, 42), gps.ToUTC());
+
+  CPPUNIT_ASSERT_THROW(LoadLeapSecondsFile("/nonexistent/leap-seconds.list"),
+                       std::runtime_error);
+}
+
+/**
+ * @brief Readers convert continuously while a writer swaps tables; every
+ * conversion must match one table or the other
+ */
+void LeapSecondsCppUnit::test_reload_stress()
+{
+  auto dates = extended_dates();
+  const leap_table_t old_table = builtin_leap_table;
+  const leap_table_t new_table(dates);
+
+  // Times spanning the new leap second
+  std::vector<gps_time_t> times;
+  gps_time_t start(2026, 6, 30, 23, 59, 0, 0);
+  for (int i = 0; i < 1000; i++) {
+    times.push_back(start + duration_t(i * fs_per_sec / 8));
+  }
+  auto expected = [&](const leap_table_t &table, const gps_time_t &t) {
+    auto [elapsed, is_leap] = table.elapsed_gps(t.get_fs());
+    return utc_time_t(t.get_fs() - elapsed * fs_per_sec + utc_gps_epoch_offset,
+                      is_leap);
+  };
+
+  std::atomic<bool> done = false;
+  std::atomic<long> mismatches = 0;
+  std::atomic<long> conversions = 0;
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 4; r++) {
+    readers.emplace_back([&]() {
+      while (!done.load(std::memory_order_relaxed)) {
+        for (const auto &t : times) {
+          auto utc = t.ToUTC();
+          auto a = expected(old_table, t);
+          auto b = expected(new_table, t);
+          bool matches = (utc.get_fs() == a.get_fs()
+                          && utc.is_leap() == a.is_leap())
+            || (utc.get_fs() == b.get_fs() && utc.is_leap() == b.is_leap());
+          mismatches += !matches;
+        }
+        conversions += times.size();
+      }
+    });
+  }
+  for (int i = 0; i < 500; i++) {
+    SetLeapSeconds(dates);
+    std::this_thread::yield();
+    ResetLeapSeconds();
+    std::this_thread::yield();
+  }
+  done = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  CPPUNIT_ASSERT_EQUAL(0L, mismatches.load());
+  CPPUNIT_ASSERT(conversions.load() > 0);
+}
@@ -0,0 +1,214 @@
+/**
+ * @file   test_unit_msgpack.cpp
+ * @brief  Tests for the MessagePack adaptors
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <limits>
+#include <string>
+#include <vector>
+
+// [MessagePack headers]
+#include <msgpack.hpp>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/msgpack.hpp"
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+/**
+ * @class MsgpackCppUnit
+ */
+class MsgpackCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(MsgpackCppUnit);
+  CPPUNIT_TEST(test_ext_layout);
+  CPPUNIT_TEST(test_round_trip);
+  CPPUNIT_TEST(test_legacy_arrays);
+  CPPUNIT_TEST(test_timestamps);
+  CPPUNIT_TEST(test_type_errors);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void test_ext_layout();
+  void test_round_trip();
+  void test_legacy_arrays();
+  void test_timestamps();
+  void test_type_errors();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(MsgpackCppUnit);
+
+namespace {
+
+template <typename T>
+std::string packed(const T &value)
+{
+  msgpack::sbuffer buffer;
+  msgpack::pack(buffer, value);
+  return std::string(buffer.data(), buffer.size());
+}
+
+template <typename T>
+T unpacked(const std::string &bytes)
+{
+  auto handle = msgpack::unpack(bytes.data(), bytes.size());
+  return handle.get().template as<T>();
+}
+
+/** @brief The bytes of the old `[high, low]` array form */
+std::string legacy_array(femtosecs_t fs)
+{
+  msgpack::sbuffer buffer;
+  msgpack::packer<msgpack::sbuffer> packer(buffer);
+  auto bits = static_cast<uint128_t>(fs);
+  packer.pack_array(2);
+  packer.pack_uint64(static_cast<uint64_t>(bits >> 64));
+  packer.pack_uint64(static_cast<uint64_t>(bits));
+  return std::string(buffer.data(), buffer.size());
+}
+
+const femtosecs_t sample_fs[] = {
+  0, 1, -1, fs_per_sec * 1'234'567'890 + 123'456'789'012'345,
+  -fs_per_day * 10'000 - 7, std::numeric_limits<femtosecs_t>::max() / 2,
+  std::numeric_limits<femtosecs_t>::min() / 2};
+
+} // namespace
+
+void MsgpackCppUnit::test_ext_layout()
+{
+  // fixext 16, the type, then the count big-endian
+  auto bytes = packed(gps_time_t(0x0102));
+  CPPUNIT_ASSERT_EQUAL(std::size_t{18}, bytes.size());
+  CPPUNIT_ASSERT_EQUAL('\xd8', bytes[0]);
+  CPPUNIT_ASSERT_EQUAL(static_cast<char>(gps_time_ext_type), bytes[1]);
+  CPPUNIT_ASSERT_EQUAL(std::string(14, '\0') + "\x01\x02", bytes.substr(2));
+  CPPUNIT_ASSERT_EQUAL(std::string(16, '\xff'),
+                       packed(duration_t(-1)).substr(2));
+  // A UTC time carries its leap flag in the low bit
+  CPPUNIT_ASSERT_EQUAL(std::string(15, '\0') + "\x05",
+                       packed(utc_time_t(2, true)).substr(2));
+}
+
+void MsgpackCppUnit::test_round_trip()
+{
+  for (auto fs : sample_fs) {
+    CPPUNIT_ASSERT_EQUAL(gps_time_t(fs),
+                         unpacked<gps_time_t>(packed(gps_time_t(fs))));
+    CPPUNIT_ASSERT(duration_t(fs)
+                   == unpacked<duration_t>(packed(duration_t(fs))));
+  }
+  // The ends of the range of a UTC time
+  for (auto fs : {femtosecs_t{0}, femtosecs_t{-7}, utc_fs_max, utc_fs_min}) {
+    for (bool leap : {false, true}) {
+      auto utc = unpacked<utc_time_t>(packed(utc_time_t(fs, leap)));
+      CPPUNIT_ASSERT(fs == utc.get_fs());
+      CPPUNIT_ASSERT_EQUAL(leap, utc.is_leap());
+    }
+  }
+  std::vector<gps_time_t> times = {gps_time_t(1), gps_time_t(-2)};
+  CPPUNIT_ASSERT(times
+                 == unpacked<std::vector<gps_time_t>>(packed(times)));
+}
+
+void MsgpackCppUnit::test_legacy_arrays()
+{
+  for (auto fs : sample_fs) {
+    CPPUNIT_ASSERT_EQUAL(gps_time_t(fs),
+                         unpacked<gps_time_t>(legacy_array(fs)));
+    if (fs >= utc_fs_min && fs <= utc_fs_max) {
+      CPPUNIT_ASSERT(fs == unpacked<utc_time_t>(legacy_array(fs)).get_fs());
+    } else {
+      CPPUNIT_ASSERT_THROW(unpacked<utc_time_t>(legacy_array(fs)),
+                           msgpack::type_error);
+    }
+    CPPUNIT_ASSERT(duration_t(fs) == unpacked<duration_t>(legacy_array(fs)));
+  }
+}
+
+void MsgpackCppUnit::test_timestamps()
+{
+  // One each of the 32-, 64- and 96-bit layouts
+  auto whole = gps_time_t::FromUTCString("2020-01-01T00:00:00Z");
+  auto fraction = gps_time_t::FromUTCString("2020-01-01T00:00:00.123456789Z");
+  auto early = gps_time_t::FromUTCString("1960-01-01T00:00:00.5Z");
+  CPPUNIT_ASSERT_EQUAL(std::size_t{6},
+                       packed(msgpack_timestamp_t{whole.ToUTC()}).size());
+  CPPUNIT_ASSERT_EQUAL(std::size_t{10},
+                       packed(msgpack_timestamp_t{fraction.ToUTC()}).size());
+  CPPUNIT_ASSERT_EQUAL(std::size_t{15},
+                       packed(msgpack_timestamp_t{early.ToUTC()}).size());
+  CPPUNIT_ASSERT_EQUAL('\xff', packed(msgpack_timestamp_t{utc_time_t()}).at(1));
+
+  for (auto t : {whole, fraction, early}) {
+    auto bytes = packed(msgpack_timestamp_t{t.ToUTC()});
+    CPPUNIT_ASSERT_EQUAL(t, unpacked<gps_time_t>(bytes));
+    CPPUNIT_ASSERT(t.ToUTC().get_fs() == unpacked<utc_time_t>(bytes).get_fs());
+  }
+
+  // Femtoseconds are dropped, and a leap second becomes the nanosecond
+  // before it
+  auto fine = fraction + duration_t(999'999);
+  CPPUNIT_ASSERT_EQUAL(fraction, unpacked<gps_time_t>(
+                         packed(msgpack_timestamp_t{fine.ToUTC()})));
+  auto leap = gps_time_t::FromUTCString("2016-12-31T23:59:60.5Z").ToUTC();
+  CPPUNIT_ASSERT_EQUAL(std::string("2016-12-31T23:59:59.999999999000000Z"),
+                       unpacked<utc_time_t>(
+                         packed(msgpack_timestamp_t{leap})).ToString());
+}
+
+void MsgpackCppUnit::test_type_errors()
+{
+  // The wrong ext type, the wrong size, and arrays of the wrong elements
+  auto gps = packed(gps_time_t(5));
+  CPPUNIT_ASSERT_THROW(unpacked<duration_t>(gps), msgpack::type_error);
+  CPPUNIT_ASSERT_THROW(unpacked<utc_time_t>(gps), msgpack::type_error);
+  CPPUNIT_ASSERT_THROW(unpacked<gps_time_t>(packed(duration_t(5))),
+                       msgpack::type_error);
+
+  msgpack::sbuffer buffer;
+  msgpack::packer<msgpack::sbuffer> packer(buffer);
+  char body[8] = {};
+  packer.pack_ext(8, gps_time_ext_type);
+  packer.pack_ext_body(body, 8);
+  packer.pack_array(2);
+  packer.pack_uint64(1);
+  packer.pack_array(0);
+  packer.pack_array(3);
+  packer.pack_uint64(1);
+  packer.pack_uint64(2);
+  packer.pack_uint64(3);
+  std::size_t offset = 0;
+  for (int i = 0; i < 3; i++) {
+    auto handle = msgpack::unpack(buffer.data(), buffer.size(), offset);
+    CPPUNIT_ASSERT_THROW(handle.get().as<gps_time_t>(), msgpack::type_error);
+  }
+
+  // A timestamp with too many nanoseconds
+  packer.pack_ext(8, msgpack_timestamp_ext_type);
+  char bad_nanos[8] = {'\xff', '\xff', '\xff', '\xfc', 0, 0, 0, 0};
+  packer.pack_ext_body(bad_nanos, 8);
+  auto handle = msgpack::unpack(buffer.data(), buffer.size(), offset);
+  CPPUNIT_ASSERT_THROW(handle.get().as<gps_time_t>(), msgpack::type_error);
+
+  // UTC counts past the end of the range, which only the ext's top
+  // second can hold, and past either end in the array form
+  for (auto key : {std::numeric_limits<femtosecs_t>::max(),
+                   utc_fs_max * 2 + 2, utc_fs_max * 2 + 3}) {
+    auto ext = packed(duration_t(key));
+    ext[1] = static_cast<char>(utc_time_ext_type);
+    CPPUNIT_ASSERT_THROW(unpacked<utc_time_t>(ext), msgpack::type_error);
+  }
+  for (auto fs : {utc_fs_max + 1, utc_fs_min - 1}) {
+    CPPUNIT_ASSERT_THROW(unpacked<utc_time_t>(legacy_array(fs)),
+                         msgpack::type_error);
+  }
+}
@@ -0,0 +1,259 @@
+/**
+ * @file   test_unit_time_bucket.cpp
+ * @brief  Tests for rounding times to a grid, and bucketing by grid or
+ *         calendar
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_bucket.hpp"
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+/**
+ * @class TimeBucketCppUnit
+ */
+class TimeBucketCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TimeBucketCppUnit);
+  CPPUNIT_TEST(test_grid);
+  CPPUNIT_TEST(test_against_division);
+  CPPUNIT_TEST(test_bins);
+  CPPUNIT_TEST(test_calendar);
+  CPPUNIT_TEST(test_calendar_bins);
+  CPPUNIT_TEST(test_errors);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void test_grid();
+  void test_against_division();
+  void test_bins();
+  void test_calendar();
+  void test_calendar_bins();
+  void test_errors();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(TimeBucketCppUnit);
+
+namespace {
+
+gps_time_t ms(femtosecs_t count)
+{
+  return gps_time_t(count * fs_per_ms);
+}
+
+/** @brief The bin and remainder, the slow way */
+std::pair<femtosecs_t, femtosecs_t> floor_div(femtosecs_t x, femtosecs_t y)
+{
+  auto quot = x / y;
+  auto rem = x % y;
+  if (rem < 0) {
+    quot -= 1;
+    rem += y;
+  }
+  return {quot, rem};
+}
+
+/** @brief Times from every magnitude, both sides of zero */
+std::vector<gps_time_t> random_times(std::size_t count, uint64_t seed)
+{
+  std::mt19937_64 rng(seed);
+  std::vector<gps_time_t> times(count);
+  for (auto &time : times) {
+    auto fs = static_cast<femtosecs_t>(
+      (static_cast<uint128_t>(rng()) << 64) | rng());
+    time = gps_time_t(fs >> (rng() % 64 + 40));
+  }
+  return times;
+}
+
+} // namespace
+
+void TimeBucketCppUnit::test_grid()
+{
+  time_grid_t grid(duration_t(10 * fs_per_ms), ms(3));
+  CPPUNIT_ASSERT_EQUAL(int64_t{0}, grid.Bin(ms(3)));
+  CPPUNIT_ASSERT_EQUAL(int64_t{0}, grid.Bin(ms(12)));
+  CPPUNIT_ASSERT_EQUAL(int64_t{1}, grid.Bin(ms(13)));
+  CPPUNIT_ASSERT_EQUAL(int64_t{-1}, grid.Bin(ms(2)));
+  CPPUNIT_ASSERT_EQUAL(int64_t{-1}, grid.Bin(ms(-7)));
+  CPPUNIT_ASSERT_EQUAL(int64_t{-2}, grid.Bin(ms(-8)));
+  CPPUNIT_ASSERT_EQUAL(ms(-17), grid.Start(-2));
+
+  CPPUNIT_ASSERT_EQUAL(ms(13), grid.Floor(ms(22)));
+  CPPUNIT_ASSERT_EQUAL(ms(23), grid.Ceil(ms(14)));
+  CPPUNIT_ASSERT_EQUAL(ms(23), grid.Ceil(ms(23)));
+  CPPUNIT_ASSERT_EQUAL(ms(-7), grid.Floor(ms(-1)));
+  CPPUNIT_ASSERT_EQUAL(ms(3), grid.Ceil(ms(-1)));
+  CPPUNIT_ASSERT_EQUAL(ms(13), grid.Round(ms(17)));
+  CPPUNIT_ASSERT_EQUAL(ms(23), grid.Round(ms(19)));
+
+  // Halfway goes to the even bin
+  CPPUNIT_ASSERT_EQUAL(ms(3), grid.Round(ms(8)));
+  CPPUNIT_ASSERT_EQUAL(ms(23), grid.Round(ms(18)));
+  CPPUNIT_ASSERT_EQUAL(ms(-17), grid.Round(ms(-12)));
+}
+
+void TimeBucketCppUnit::test_against_division()
+{
+  // Odd widths, widths with trailing zero bits to shift out, an odd width
+  // too wide for a 64-bit reciprocal, and one just narrow enough
+  const femtosecs_t widths[] = {
+    1, 3, 7, fs_per_us, 10 * fs_per_ms, fs_per_sec, fs_per_hour,
+    fs_per_day, 7 * fs_per_day, femtosecs_t(1) << 100,
+    (femtosecs_t(1) << 70) + 1, (femtosecs_t(1) << 63) + 1};
+  auto times = random_times(20'000, 7);
+  for (auto width : widths) {
+    for (auto origin : {gps_time_t(0), ms(-12'345), gps_time_t(1)}) {
+      time_grid_t grid(duration_t(width), origin);
+      for (const auto &time : times) {
+        auto [quot, rem] = floor_div(time.get_fs() - origin.get_fs(), width);
+        auto floor = gps_time_t(time.get_fs() - rem);
+        CPPUNIT_ASSERT(floor == grid.Floor(time));
+        CPPUNIT_ASSERT(grid.Ceil(time) ==
+                       (rem == 0 ? time : floor + duration_t(width)));
+        auto round = grid.Round(time);
+        CPPUNIT_ASSERT(round == floor || round == floor + duration_t(width));
+        CPPUNIT_ASSERT(2 * rem != width ||
+                       (round == floor) == (quot % 2 == 0));
+        if (quot >= INT64_MIN && quot <= INT64_MAX) {
+          CPPUNIT_ASSERT(static_cast<int64_t>(quot) == grid.Bin(time));
+          CPPUNIT_ASSERT(floor == grid.Start(grid.Bin(time)));
+        }
+      }
+    }
+  }
+}
+
+void TimeBucketCppUnit::test_bins()
+{
+  time_grid_t grid(duration_t(10 * fs_per_ms), ms(-5));
+  auto times = random_times(300'000, 11);
+  std::vector<int64_t> one(times.size());
+  std::vector<int64_t> four(times.size());
+  grid.Bins(times, one);
+  grid.Bins(times, four, 4);
+  for (std::size_t i = 0; i < times.size(); i++) {
+    CPPUNIT_ASSERT_EQUAL(grid.Bin(times[i]), one[i]);
+  }
+  CPPUNIT_ASSERT(one == four);
+
+  // A sorted series with many times to a bin, across the origin, is binned
+  // a run at a time
+  std::vector<gps_time_t> series;
+  for (femtosecs_t i = -150'000; i < 150'000; i++) {
+    series.push_back(gps_time_t(i * fs_per_ms + 7));
+  }
+  one.resize(series.size());
+  four.resize(series.size());
+  grid.Bins(series, one);
+  grid.Bins(series, four, 4);
+  for (std::size_t i = 0; i < series.size(); i++) {
+    CPPUNIT_ASSERT_EQUAL(grid.Bin(series[i]), one[i]);
+  }
+  CPPUNIT_ASSERT(one == four);
+}
+
+void TimeBucketCppUnit::test_calendar()
+{
+  auto utc = [](const char *text) {
+    return gps_time_t::FromUTCString(text);
+  };
+  auto day = calendar_unit_t::day;
+  auto month = calendar_unit_t::month;
+  auto year = calendar_unit_t::year;
+
+  // The leap second at the end of 2016 is part of Dec. 31
+  auto leap = utc("2016-12-31T23:59:60.5Z");
+  CPPUNIT_ASSERT_EQUAL(int64_t{17166}, CalendarBin(leap, day));
+  CPPUNIT_ASSERT_EQUAL(int64_t{46 * 12 + 11}, CalendarBin(leap, month));
+  CPPUNIT_ASSERT_EQUAL(int64_t{46}, CalendarBin(leap, year));
+  CPPUNIT_ASSERT_EQUAL(utc("2016-12-31T00:00:00Z"), CalendarFloor(leap, day));
+  CPPUNIT_ASSERT_EQUAL(utc("2017-01-01T00:00:00Z"), CalendarCeil(leap, day));
+  CPPUNIT_ASSERT_EQUAL(utc("2016-12-01T00:00:00Z"),
+                       CalendarFloor(leap, month));
+  CPPUNIT_ASSERT_EQUAL(utc("2017-01-01T00:00:00Z"), CalendarCeil(leap, year));
+  CPPUNIT_ASSERT_EQUAL(int64_t{17167},
+                       CalendarBin(utc("2017-01-01T00:00:00Z"), day));
+
+  auto leap_day = utc("2024-02-29T12:00:00Z");
+  CPPUNIT_ASSERT_EQUAL(int64_t{54 * 12 + 1}, CalendarBin(leap_day, month));
+  CPPUNIT_ASSERT_EQUAL(utc("2024-03-01T00:00:00Z"),
+                       CalendarCeil(leap_day, month));
+  CPPUNIT_ASSERT_EQUAL(utc("2024-01-01T00:00:00Z"),
+                       CalendarFloor(leap_day, year));
+  auto midnight = utc("2024-03-01T00:00:00Z");
+  CPPUNIT_ASSERT_EQUAL(midnight, CalendarCeil(midnight, month));
+  CPPUNIT_ASSERT_EQUAL(midnight, CalendarFloor(midnight, day));
+
+  // Before the UTC epoch
+  auto before = utc("1969-12-31T23:00:00Z");
+  CPPUNIT_ASSERT_EQUAL(int64_t{-1}, CalendarBin(before, day));
+  CPPUNIT_ASSERT_EQUAL(int64_t{-1}, CalendarBin(before, month));
+  CPPUNIT_ASSERT_EQUAL(int64_t{-1}, CalendarBin(before, year));
+  CPPUNIT_ASSERT_EQUAL(utc("1969-12-01T00:00:00Z"),
+                       CalendarStart(-1, month));
+  CPPUNIT_ASSERT_EQUAL(utc("1955-01-01T00:00:00Z"), CalendarStart(-15, year));
+}
+
+void TimeBucketCppUnit::test_calendar_bins()
+{
+  // Sorted times a few hours apart across many leap seconds, then the same
+  // times shuffled
+  std::mt19937_64 rng(3);
+  std::vector<gps_time_t> times;
+  auto time = gps_time_t::FromUTCString("1965-01-01T00:00:00Z");
+  for (int i = 0; i < 200'000; i++) {
+    times.push_back(time);
+    time += duration_t(femtosecs_t(rng() % (6 * 3'600'000)) * fs_per_ms);
+  }
+  for (auto &leap : gps_time_t::leap_seconds) {
+    times.push_back(leap);
+    times.push_back(leap + duration_t(fs_per_sec - 1));
+    times.push_back(leap + duration_t(fs_per_sec));
+  }
+  std::sort(times.begin(), times.end());
+  auto shuffled = times;
+  std::shuffle(shuffled.begin(), shuffled.end(), rng);
+
+  for (auto unit : {calendar_unit_t::day, calendar_unit_t::month,
+                    calendar_unit_t::year}) {
+    for (const auto *column : {&times, &shuffled}) {
+      std::vector<int64_t> one(column->size());
+      std::vector<int64_t> four(column->size());
+      CalendarBins(*column, one, unit);
+      CalendarBins(*column, four, unit, 4);
+      CPPUNIT_ASSERT(one == four);
+      for (std::size_t i = 0; i < column->size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(CalendarBin((*column)[i], unit), one[i]);
+      }
+    }
+  }
+}
+
+void TimeBucketCppUnit::test_errors()
+{
+  CPPUNIT_ASSERT_THROW(time_grid_t(duration_t(0)), std::runtime_error);
+  CPPUNIT_ASSERT_THROW(time_grid_t(duration_t(-fs_per_sec)),
+                       std::runtime_error);
+  std::vector<gps_time_t> times(3);
+  std::vector<int64_t> bins(2);
+  CPPUNIT_ASSERT_THROW(time_grid_t(duration_t(fs_per_sec)).Bins(times, bins),
+                       std::runtime_error);
+  CPPUNIT_ASSERT_THROW(CalendarBins(times, bins, calendar_unit_t::day),
+                       std::runtime_error);
+}
@@ -0,0 +1,168 @@
+/**
+ * @file   test_unit_time_bytes.cpp
+ * @brief  Tests for the byte forms of times and durations
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_bytes.hpp"
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+/**
+ * @class TimeBytesCppUnit
+ */
+class TimeBytesCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TimeBytesCppUnit);
+  CPPUNIT_TEST(test_layout);
+  CPPUNIT_TEST(test_round_trip);
+  CPPUNIT_TEST(test_wide_utc);
+  CPPUNIT_TEST(test_spans);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void test_layout();
+  void test_round_trip();
+  void test_wide_utc();
+  void test_spans();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(TimeBytesCppUnit);
+
+namespace {
+
+using bytes_t = std::array<uint8_t, time_byte_size>;
+
+const femtosecs_t sample_fs[] = {
+  0, 1, -1, fs_per_sec * 1'234'567'890 + 123'456'789'012'345,
+  -fs_per_day * 10'000 - 7, std::numeric_limits<femtosecs_t>::max() / 4,
+  std::numeric_limits<femtosecs_t>::min() / 4};
+
+} // namespace
+
+void TimeBytesCppUnit::test_layout()
+{
+  bytes_t little = {0x02, 0x01};
+  bytes_t big = {};
+  big[14] = 0x01;
+  big[15] = 0x02;
+  CPPUNIT_ASSERT(little == ToBytes(gps_time_t(0x0102)));
+  CPPUNIT_ASSERT(big == ToBytes(gps_time_t(0x0102), std::endian::big));
+  CPPUNIT_ASSERT(big == ToBytes(duration_t(0x0102), std::endian::big));
+
+  bytes_t ones;
+  ones.fill(0xff);
+  CPPUNIT_ASSERT(ones == ToBytes(duration_t(-1)));
+  CPPUNIT_ASSERT(ones == ToBytes(duration_t(-1), std::endian::big));
+
+  // A UTC time carries its leap flag in the low bit
+  bytes_t leap = {0x05};
+  CPPUNIT_ASSERT(leap == ToBytes(utc_time_t(2, true)));
+}
+
+void TimeBytesCppUnit::test_round_trip()
+{
+  for (auto order : {std::endian::little, std::endian::big}) {
+    for (auto fs : sample_fs) {
+      CPPUNIT_ASSERT_EQUAL(gps_time_t(fs), FromBytes<gps_time_t>(
+                             ToBytes(gps_time_t(fs), order), order));
+      CPPUNIT_ASSERT(duration_t(fs) == FromBytes<duration_t>(
+                       ToBytes(duration_t(fs), order), order));
+      for (bool leap : {false, true}) {
+        auto utc = FromBytes<utc_time_t>(ToBytes(utc_time_t(fs, leap), order),
+                                         order);
+        CPPUNIT_ASSERT(fs == utc.get_fs());
+        CPPUNIT_ASSERT_EQUAL(leap, utc.is_leap());
+      }
+    }
+  }
+}
+
+void TimeBytesCppUnit::test_wide_utc()
+{
+  // The ends of the range of a UTC time
+  for (auto order : {std::endian::little, std::endian::big}) {
+    for (auto fs : {femtosecs_t{0}, utc_fs_max, utc_fs_min}) {
+      for (bool leap : {false, true}) {
+        auto bytes = ToWideBytes(utc_time_t(fs, leap), order);
+        CPPUNIT_ASSERT_EQUAL(uint8_t{leap}, bytes[16]);
+        auto utc = FromWideBytes(bytes, order);
+        CPPUNIT_ASSERT(fs == utc.get_fs());
+        CPPUNIT_ASSERT_EQUAL(leap, utc.is_leap());
+      }
+    }
+  }
+  auto bytes = ToWideBytes(utc_time_t(5, true));
+  bytes[16] = 2;
+  CPPUNIT_ASSERT_THROW(FromWideBytes(bytes), std::runtime_error);
+
+  // The whole range of the 17-byte form, beyond what a UTC time can hold
+  for (auto fs : {std::numeric_limits<femtosecs_t>::max(),
+                  std::numeric_limits<femtosecs_t>::min(), utc_fs_max + 1,
+                  utc_fs_min - 1}) {
+    for (uint8_t leap : {0, 1}) {
+      std::array<uint8_t, utc_time_wide_byte_size> wide{};
+      auto fs_bytes = ToBytes(duration_t(fs));
+      std::copy(fs_bytes.begin(), fs_bytes.end(), wide.begin());
+      wide[16] = leap;
+      CPPUNIT_ASSERT_THROW(FromWideBytes(wide), std::runtime_error);
+    }
+  }
+  // The 16-byte form of a count past the end of the range
+  auto past = ToBytes(duration_t(utc_fs_max * 2 + 3));
+  CPPUNIT_ASSERT_THROW(FromBytes<utc_time_t>(past), std::runtime_error);
+}
+
+void TimeBytesCppUnit::test_spans()
+{
+  std::vector<gps_time_t> times;
+  std::vector<utc_time_t> utc;
+  for (auto fs : sample_fs) {
+    times.push_back(gps_time_t(fs));
+    utc.push_back(utc_time_t(fs, fs % 2 != 0));
+  }
+  std::vector<uint8_t> out(times.size() * 16 + 1, 0xaa);
+  for (auto order : {std::endian::little, std::endian::big}) {
+    CPPUNIT_ASSERT_EQUAL(times.size() * 16, ToBytes(
+                           std::span<const gps_time_t>(times), out, order));
+    CPPUNIT_ASSERT_EQUAL(uint8_t{0xaa}, out.back());
+    std::vector<gps_time_t> times_back(times.size());
+    FromBytes(out, std::span(times_back), order);
+    CPPUNIT_ASSERT(times == times_back);
+    for (std::size_t i = 0; i < times.size(); i++) {
+      auto one = ToBytes(times[i], order);
+      CPPUNIT_ASSERT(std::equal(one.begin(), one.end(), &out[i * 16]));
+    }
+
+    ToBytes(std::span<const utc_time_t>(utc), out, order);
+    std::vector<utc_time_t> utc_back(utc.size());
+    FromBytes(out, std::span(utc_back), order);
+    for (std::size_t i = 0; i < utc.size(); i++) {
+      CPPUNIT_ASSERT(utc[i].get_fs() == utc_back[i].get_fs());
+      CPPUNIT_ASSERT_EQUAL(utc[i].is_leap(), utc_back[i].is_leap());
+    }
+  }
+
+  // Too little room, too few bytes
+  CPPUNIT_ASSERT_THROW(ToBytes(std::span<const gps_time_t>(times),
+                               std::span(out).first(16 * times.size() - 1)),
+                       std::runtime_error);
+  std::vector<gps_time_t> too_many(times.size() + 1);
+  CPPUNIT_ASSERT_THROW(FromBytes(std::span<const uint8_t>(out).first(16),
+                                 std::span(too_many)), std::runtime_error);
+}
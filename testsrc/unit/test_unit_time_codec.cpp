@@ -0,0 +1,223 @@
+/**
+ * @file   test_unit_time_codec.cpp
+ * @brief  Tests for the compressed time-column codec
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_codec.hpp"
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+/**
+ * @class TimeCodecCppUnit
+ */
+class TimeCodecCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TimeCodecCppUnit);
+  CPPUNIT_TEST(test_regular);
+  CPPUNIT_TEST(test_irregular);
+  CPPUNIT_TEST(test_extremes);
+  CPPUNIT_TEST(test_random_access);
+  CPPUNIT_TEST(test_streaming);
+  CPPUNIT_TEST(test_corrupt);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void test_regular();
+  void test_irregular();
+  void test_extremes();
+  void test_random_access();
+  void test_streaming();
+  void test_corrupt();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(TimeCodecCppUnit);
+
+namespace {
+
+const codec_kernel_t all_kernels[] = {
+  codec_kernel_t::scalar, codec_kernel_t::avx2, codec_kernel_t::automatic};
+
+/** @brief Samples every `period` fs, each off by up to `jitter` fs */
+std::vector<gps_time_t> sampled(std::size_t count, femtosecs_t period,
+                                uint64_t jitter, uint64_t seed = 1)
+{
+  std::mt19937_64 rng(seed);
+  auto start = gps_time_t::FromUTCString("2021-06-30T12:00:00Z");
+  std::vector<gps_time_t> times;
+  for (std::size_t i = 0; i < count; i++) {
+    auto offset = jitter ? static_cast<femtosecs_t>(rng() % jitter) : 0;
+    times.push_back(start + duration_t(period * i + offset));
+  }
+  return times;
+}
+
+/** @brief Encode, then check every kernel decodes the same femtoseconds */
+std::vector<uint8_t> check_round_trip(const std::vector<gps_time_t> &times)
+{
+  auto data = EncodeTimeColumn(times);
+  time_column_t column(data);
+  CPPUNIT_ASSERT_EQUAL(times.size(), column.size());
+  CPPUNIT_ASSERT_EQUAL((times.size() + time_block_size - 1) / time_block_size,
+                       column.block_count());
+  for (auto kernel : all_kernels) {
+    auto decoded = column.Decode(kernel);
+    CPPUNIT_ASSERT_EQUAL(times.size(), decoded.size());
+    for (std::size_t i = 0; i < times.size(); i++) {
+      CPPUNIT_ASSERT(times[i].get_fs() == decoded[i].get_fs());
+    }
+  }
+  return data;
+}
+
+} // namespace
+
+void TimeCodecCppUnit::test_regular()
+{
+  // 1 kHz: each full block is its header, first difference and the eight
+  // zero group widths, plus its offset
+  auto times = sampled(100 * time_block_size, fs_per_sec / 1000, 0);
+  auto data = check_round_trip(times);
+  CPPUNIT_ASSERT_EQUAL(std::size_t{100 * 51 + 20}, data.size());
+
+  // Nanosecond jitter still compresses well
+  auto jittered = sampled(100'000, fs_per_sec / 1000,
+                         static_cast<uint64_t>(fs_per_ns));
+  auto size = check_round_trip(jittered).size();
+  CPPUNIT_ASSERT(size * 4 < jittered.size() * sizeof(gps_time_t));
+}
+
+void TimeCodecCppUnit::test_irregular()
+{
+  // Every group width from 0 to 64, and a partial last block
+  std::vector<gps_time_t> times;
+  std::mt19937_64 rng(7);
+  femtosecs_t fs = 0;
+  for (int width = 0; width <= 64; width++) {
+    for (std::size_t i = 0; i < time_group_size; i++) {
+      auto step = width == 0 ? 0 : rng() >> (64 - width);
+      fs += static_cast<femtosecs_t>(step / 4);
+      times.push_back(gps_time_t(fs));
+    }
+  }
+  check_round_trip(times);
+
+  // Times out of order, and a time repeated
+  times = sampled(5'000, fs_per_sec, 3 * fs_per_sec, 11);
+  times[10] = times[9];
+  check_round_trip(times);
+
+  // Short columns
+  for (std::size_t count = 0; count < 5; count++) {
+    check_round_trip(sampled(count, 1, 100));
+  }
+}
+
+void TimeCodecCppUnit::test_extremes()
+{
+  // Differences that overflow 128 bits make raw blocks; differences too
+  // big for 64 bits make wide blocks
+  auto max = std::numeric_limits<femtosecs_t>::max();
+  auto min = std::numeric_limits<femtosecs_t>::min();
+  std::vector<gps_time_t> times;
+  for (int i = 0; i < 2'000; i++) {
+    times.push_back(gps_time_t(i % 2 ? max - i : min + i));
+  }
+  auto raw = check_round_trip(times).size();
+  CPPUNIT_ASSERT(raw > times.size() * 16);
+
+  times.clear();
+  for (int i = 0; i < 2'000; i++) {
+    times.push_back(gps_time_t(min / 2 + static_cast<femtosecs_t>(i) *
+                               fs_per_day * 1'000'000));
+  }
+  auto wide = check_round_trip(times).size();
+  CPPUNIT_ASSERT(wide < 200);
+}
+
+void TimeCodecCppUnit::test_random_access()
+{
+  auto times = sampled(10'000, fs_per_sec / 100, 1'000'000, 3);
+  auto data = EncodeTimeColumn(times);
+  time_column_t column(data);
+  for (std::size_t i : {0, 1, 1023, 1024, 5000, 9999}) {
+    CPPUNIT_ASSERT_EQUAL(times[i], column[i]);
+  }
+  CPPUNIT_ASSERT_THROW(column[10'000], std::runtime_error);
+
+  for (auto [first, count] : {std::pair{0, 10'000}, {5, 1}, {1000, 3000},
+                              {2048, 1024}, {9000, 1000}, {10'000, 0}}) {
+    std::vector<gps_time_t> some(count);
+    column.Decode(first, some);
+    for (int i = 0; i < count; i++) {
+      CPPUNIT_ASSERT_EQUAL(times[first + i], some[i]);
+    }
+  }
+  std::vector<gps_time_t> two(2);
+  CPPUNIT_ASSERT_THROW(column.Decode(9'999, two), std::runtime_error);
+
+  std::vector<gps_time_t> block(time_block_size);
+  CPPUNIT_ASSERT_EQUAL(std::size_t{784}, column.DecodeBlock(9, block));
+  CPPUNIT_ASSERT_EQUAL(times[9 * time_block_size + 783], block[783]);
+  CPPUNIT_ASSERT_THROW(column.DecodeBlock(10, block), std::runtime_error);
+  CPPUNIT_ASSERT_THROW(column.DecodeBlock(0, std::span(block).first(1000)),
+                       std::runtime_error);
+}
+
+void TimeCodecCppUnit::test_streaming()
+{
+  auto times = sampled(3'000, fs_per_sec / 10, 1'000);
+  time_column_encoder_t encoder;
+  for (std::size_t i = 0; i < 1'000; i++) {
+    encoder.Append(times[i]);
+  }
+  encoder.Append(std::span(times).subspan(1'000));
+  CPPUNIT_ASSERT_EQUAL(times.size(), encoder.size());
+  CPPUNIT_ASSERT(EncodeTimeColumn(times) == encoder.Finish());
+  // Finish leaves the encoder empty
+  CPPUNIT_ASSERT_EQUAL(std::size_t{0}, encoder.size());
+  CPPUNIT_ASSERT(EncodeTimeColumn({}) == encoder.Finish());
+}
+
+void TimeCodecCppUnit::test_corrupt()
+{
+  auto times = sampled(3'000, fs_per_sec / 10, 1'000'000);
+  auto data = EncodeTimeColumn(times);
+  auto check_throws = [](std::vector<uint8_t> bytes) {
+    CPPUNIT_ASSERT_THROW(time_column_t(bytes).Decode(), std::runtime_error);
+  };
+
+  // Truncated, a bad magic number, a bad count, bad offsets
+  check_throws({});
+  check_throws(std::vector<uint8_t>(data.begin() + 1, data.end()));
+  auto bad = data;
+  bad.back() ^= 1;
+  check_throws(bad);
+  bad = data;
+  bad[bad.size() - 20] += 1;
+  check_throws(bad);
+  bad = data;
+  bad[bad.size() - 20 - 16] += 1;
+  check_throws(bad);
+
+  // A block's length, kind or group width
+  for (std::size_t at : {0, 2, 3 + 16 + 16}) {
+    bad = data;
+    bad[at] = 0xff;
+    check_throws(bad);
+  }
+}
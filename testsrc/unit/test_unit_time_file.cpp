@@ -0,0 +1,181 @@
+/**
+ * @file   test_unit_time_file.cpp
+ * @brief  Tests for memory-mapped time files
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_file.hpp"
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+/**
+ * @class TimeFileCppUnit
+ */
+class TimeFileCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TimeFileCppUnit);
+  CPPUNIT_TEST(test_round_trip);
+  CPPUNIT_TEST(test_bounds);
+  CPPUNIT_TEST(test_range);
+  CPPUNIT_TEST(test_bad_files);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void test_round_trip();
+  void test_bounds();
+  void test_range();
+  void test_bad_files();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(TimeFileCppUnit);
+
+namespace {
+
+std::string temp_path()
+{
+  return (std::filesystem::temp_directory_path()
+          / "femtotime_test_times.bin").string();
+}
+
+/** @brief Sorted times with runs of repeats, so bounds fall mid-run */
+std::vector<gps_time_t> sample_times(std::size_t count)
+{
+  std::mt19937_64 rng(1729);
+  std::vector<gps_time_t> times;
+  auto t = gps_time_t::FromUTCString("2024-03-01T00:00:00Z");
+  for (std::size_t i = 0; i < count; i++) {
+    if (rng() % 4 != 0) {
+      t += duration_t(static_cast<femtosecs_t>(rng() % 1'000'000'000));
+    }
+    times.push_back(t);
+  }
+  return times;
+}
+
+} // namespace
+
+void TimeFileCppUnit::test_round_trip()
+{
+  auto path = temp_path();
+  for (std::size_t count : {0, 1, 99, 100, 101, 5'000}) {
+    auto times = sample_times(count);
+    WriteTimeFile(path, times, 100);
+    time_file_t file(path);
+    CPPUNIT_ASSERT_EQUAL(count, file.size());
+    CPPUNIT_ASSERT_EQUAL(std::size_t{100}, file.index_stride());
+    CPPUNIT_ASSERT(std::ranges::equal(times, file.times()));
+    // The times are mapped in place, aligned
+    CPPUNIT_ASSERT_EQUAL(std::size_t{0}, reinterpret_cast<std::uintptr_t>(
+                           file.times().data()) % alignof(gps_time_t));
+  }
+
+  // Moving keeps the mapping
+  auto times = sample_times(300);
+  WriteTimeFile(path, times);
+  time_file_t file(path);
+  time_file_t moved(std::move(file));
+  CPPUNIT_ASSERT_EQUAL(std::size_t{0}, file.size());
+  CPPUNIT_ASSERT(std::ranges::equal(times, moved.times()));
+  std::filesystem::remove(path);
+}
+
+void TimeFileCppUnit::test_bounds()
+{
+  auto path = temp_path();
+  auto times = sample_times(2'000);
+  for (std::size_t stride : {1, 7, 64, 2'000, 4'096}) {
+    WriteTimeFile(path, times, stride);
+    time_file_t file(path);
+    std::vector<gps_time_t> probes = {
+      times.front() - duration_t(1), times.back() + duration_t(1)};
+    for (std::size_t i = 0; i < times.size(); i += 13) {
+      probes.push_back(times[i]);
+      probes.push_back(times[i] + duration_t(1));
+    }
+    for (const auto &probe : probes) {
+      auto lower = std::lower_bound(times.begin(), times.end(), probe);
+      auto upper = std::upper_bound(times.begin(), times.end(), probe);
+      CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(lower - times.begin()),
+                           file.lower_bound(probe));
+      CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(upper - times.begin()),
+                           file.upper_bound(probe));
+    }
+  }
+  std::filesystem::remove(path);
+}
+
+void TimeFileCppUnit::test_range()
+{
+  auto path = temp_path();
+  auto times = sample_times(10'000);
+  WriteTimeFile(path, times);
+  time_file_t file(path);
+  auto begin = times[1234];
+  auto end = times[8765];
+  auto range = file.Range(begin, end);
+  CPPUNIT_ASSERT(range.data() == file.times().data() + file.lower_bound(begin));
+  for (const auto &t : range) {
+    CPPUNIT_ASSERT(begin <= t && t < end);
+  }
+  CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(
+                         std::count_if(times.begin(), times.end(), [&](auto t) {
+                           return begin <= t && t < end;
+                         })), range.size());
+  // An empty or backwards range
+  CPPUNIT_ASSERT(file.Range(begin, begin).empty());
+  CPPUNIT_ASSERT(file.Range(end, begin).empty());
+  std::filesystem::remove(path);
+}
+
+void TimeFileCppUnit::test_bad_files()
+{
+  auto path = temp_path();
+  auto times = sample_times(10);
+  CPPUNIT_ASSERT_THROW(WriteTimeFile(path, times, 0), std::runtime_error);
+  std::swap(times[3], times[4]);
+  CPPUNIT_ASSERT_THROW(WriteTimeFile(path, times), std::runtime_error);
+  std::sort(times.begin(), times.end());
+  WriteTimeFile(path, times);
+
+  std::string contents;
+  {
+    std::ifstream file(path, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(file), {});
+  }
+  auto check_throws = [&](const std::string &bytes) {
+    {
+      std::ofstream file(path, std::ios::binary | std::ios::trunc);
+      file << bytes;
+    }
+    CPPUNIT_ASSERT_THROW(time_file_t file(path), std::runtime_error);
+  };
+  // Too short, bad magic, a bad version, a wrong count, a missing time
+  check_throws(contents.substr(0, 63));
+  check_throws("X" + contents.substr(1));
+  auto bad = contents;
+  bad[8] = 2;
+  check_throws(bad);
+  bad = contents;
+  bad[16] = 11;
+  check_throws(bad);
+  check_throws(contents.substr(0, contents.size() - 16));
+  std::filesystem::remove(path);
+  CPPUNIT_ASSERT_THROW(time_file_t file(path), std::runtime_error);
+}
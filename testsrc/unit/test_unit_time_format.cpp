@@ -0,0 +1,249 @@
+/**
+ * @file   test_unit_time_format.cpp
+ * @brief  Tests for formatting times without allocating
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_format.hpp"
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+namespace {
+
+// The fmt::format-based ToString() that FormatTo replaced, as the reference
+std::string legacy_to_string(const civil_fields_t &f, const char *prefix)
+{
+  int64_t femtos = f.nanosecond * int64_t{1'000'000} + f.femtosecond;
+  return fmt::format("{}{:04}-{:02}-{:02}T{:02}:{:02}:{:02}.{:015}Z",
+                     prefix, f.year, f.month, f.day, f.hour, f.minute,
+                     f.second, femtos);
+}
+
+std::string legacy_date_string(const civil_fields_t &f)
+{
+  return fmt::format("{:04}-{:02}-{:02}", f.year, f.month, f.day);
+}
+
+/** @brief Random times from before year 0 to after year 10000 */
+std::vector<femtosecs_t> sample_fs()
+{
+  std::vector<femtosecs_t> samples = {0, -1, 1, fs_per_sec - 1};
+  std::mt19937_64 rng(1234);
+  for (int i = 0; i < 20'000; i++) {
+    auto secs = static_cast<int64_t>(rng() % 800'000'000'000)
+      - 400'000'000'000;
+    samples.push_back(femtosecs_t(secs) * fs_per_sec + rng() % fs_per_sec);
+  }
+  return samples;
+}
+
+} // namespace
+
+/**
+ * @class TimeFormatCppUnit
+ */
+class TimeFormatCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TimeFormatCppUnit);
+  CPPUNIT_TEST(test_legacy_equivalence);
+  CPPUNIT_TEST(test_leap_second);
+  CPPUNIT_TEST(test_fmt_and_streams);
+  CPPUNIT_TEST(test_duration);
+  CPPUNIT_TEST(test_styles_and_precision);
+  CPPUNIT_TEST(test_round_trip);
+  CPPUNIT_TEST(test_format_spec);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void test_legacy_equivalence();
+  void test_leap_second();
+  void test_fmt_and_streams();
+  void test_duration();
+  void test_styles_and_precision();
+  void test_round_trip();
+  void test_format_spec();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(TimeFormatCppUnit);
+
+void TimeFormatCppUnit::test_legacy_equivalence()
+{
+  for (auto fs : sample_fs()) {
+    gps_time_t gps(fs);
+    utc_time_t utc(fs);
+    auto expected = legacy_to_string(gps.Fields(), "GPS_");
+    char buffer[time_string_capacity];
+    CPPUNIT_ASSERT_EQUAL(expected,
+                         std::string(buffer, gps.FormatTo(buffer)));
+    CPPUNIT_ASSERT_EQUAL(expected, gps.ToString());
+    CPPUNIT_ASSERT_EQUAL(legacy_date_string(gps.Fields()), gps.DateString());
+    CPPUNIT_ASSERT_EQUAL(legacy_to_string(utc.Fields(), ""), utc.ToString());
+    CPPUNIT_ASSERT_EQUAL(legacy_date_string(utc.Fields()), utc.DateString());
+  }
+}
+
+void TimeFormatCppUnit::test_leap_second()
+{
+  auto leap = gps_time_t::FromUTCString("2016-12-31T23:59:60.5").ToUTC();
+  CPPUNIT_ASSERT(leap.is_leap());
+  CPPUNIT_ASSERT_EQUAL(std::string("2016-12-31T23:59:60.500000000000000Z"),
+                       leap.ToString());
+  CPPUNIT_ASSERT_EQUAL(std::string("2016-12-31"), leap.DateString());
+}
+
+void TimeFormatCppUnit::test_fmt_and_streams()
+{
+  gps_time_t gps = gps_time_t::FromGPSString("GPS_2024-02-29T01:02:03.25");
+  auto utc = gps.ToUTC();
+  CPPUNIT_ASSERT_EQUAL(gps.ToString(), fmt::format("{}", gps));
+  CPPUNIT_ASSERT_EQUAL(utc.ToString(), fmt::format("{}", utc));
+  CPPUNIT_ASSERT_EQUAL("[" + gps.ToString() + "]",
+                       fmt::format("[{}]", gps));
+  CPPUNIT_ASSERT_THROW((void) fmt::format(fmt::runtime("{:x}"), gps),
+                       fmt::format_error);
+
+  // Stream output still honours the field width
+  std::ostringstream os;
+  os << std::setw(50) << std::left << utc << '|' << gps;
+  CPPUNIT_ASSERT_EQUAL(fmt::format("{:50}|{}", utc.ToString(), gps.ToString()),
+                       os.str());
+}
+
+void TimeFormatCppUnit::test_duration()
+{
+  CPPUNIT_ASSERT_EQUAL(std::string("0.000000000000000s"),
+                       fmt::format("{}", duration_t(0)));
+  CPPUNIT_ASSERT_EQUAL(std::string("-1.500000000000000s"),
+                       fmt::format("{}", duration_t(-fs_per_sec * 3 / 2)));
+  CPPUNIT_ASSERT_EQUAL(std::string("86400.000000000000001s"),
+                       fmt::format("{}", duration_t(fs_per_day + 1)));
+  // The extremes, whose seconds need more than 64 bits
+  auto max = std::numeric_limits<femtosecs_t>::max();
+  CPPUNIT_ASSERT_EQUAL(
+    std::string("170141183460469231731687.303715884105727s"),
+    fmt::format("{}", duration_t(max)));
+  CPPUNIT_ASSERT_EQUAL(
+    std::string("-170141183460469231731687.303715884105728s"),
+    fmt::format("{}", duration_t(-max - 1)));
+}
+
+void TimeFormatCppUnit::test_styles_and_precision()
+{
+  auto utc = gps_time_t::FromUTCString("2024-02-29T01:02:03.123456789012345")
+    .ToUTC();
+  auto format = [&](time_style_t style, time_precision_t precision) {
+    return utc.ToString({style, precision});
+  };
+  using enum time_style_t;
+  using enum time_precision_t;
+  CPPUNIT_ASSERT_EQUAL(utc.ToString(), format(extended, fs));
+  CPPUNIT_ASSERT_EQUAL(std::string("2024-02-29T01:02:03Z"),
+                       format(extended, s));
+  CPPUNIT_ASSERT_EQUAL(std::string("2024-02-29T01:02:03.123Z"),
+                       format(extended, ms));
+  CPPUNIT_ASSERT_EQUAL(std::string("2024-02-29T01:02:03.123456Z"),
+                       format(extended, us));
+  CPPUNIT_ASSERT_EQUAL(std::string("2024-02-29T01:02:03.123456789Z"),
+                       format(extended, ns));
+  CPPUNIT_ASSERT_EQUAL(std::string("2024-02-29T01:02:03.123456789012Z"),
+                       format(extended, ps));
+  CPPUNIT_ASSERT_EQUAL(std::string("20240229T010203.123Z"), format(basic, ms));
+  CPPUNIT_ASSERT_EQUAL(std::string("20240229T010203Z"), format(basic, s));
+  CPPUNIT_ASSERT_EQUAL(std::string("GPS_2024-02-29T01:02:03.123456Z"),
+                       format(gps, us));
+  CPPUNIT_ASSERT_EQUAL(std::string("2024-02-29T01:02:03.123+00:00"),
+                       format(rfc3339, ms));
+
+  // A gps_time_t shows its own fields, whatever the style
+  auto time = gps_time_t::FromUTC(utc);
+  CPPUNIT_ASSERT_EQUAL(time.ToString(), time.ToString({gps, fs}));
+  CPPUNIT_ASSERT_EQUAL(std::string("2024-02-29T01:02:21.123Z"),
+                       time.ToString({extended, ms}));
+
+  // Truncated, not rounded, and a leap second stays second 60
+  auto leap = gps_time_t::FromUTCString("2016-12-31T23:59:60.9999999").ToUTC();
+  CPPUNIT_ASSERT_EQUAL(std::string("2016-12-31T23:59:60.999+00:00"),
+                       leap.ToString({rfc3339, ms}));
+  CPPUNIT_ASSERT_EQUAL(std::string("20161231T235960Z"),
+                       leap.ToString({basic, s}));
+
+  // Years that don't fit in four digits, padded as "{:04}" pads them
+  CPPUNIT_ASSERT_EQUAL(std::string("-0010101T000000Z"),
+                       utc_time_t(civil_fields_t{-1, 1, 1, 0, 0, 0, 0, 0, 0})
+                         .ToString({basic, s}));
+  CPPUNIT_ASSERT_EQUAL(std::string("GPS_12345-01-01T00:00:00.000Z"),
+                       gps_time_t(civil_fields_t{12345, 1, 1, 0, 0, 0, 0, 0,
+                                                 0}).ToString({gps, ms}));
+
+}
+
+void TimeFormatCppUnit::test_round_trip()
+{
+  for (auto fs : sample_fs()) {
+    gps_time_t gps(fs);
+    if (gps.Fields().year < 0 || gps.Fields().year > 9999) {
+      continue;
+    }
+    auto utc = gps.ToUTC();
+    // The nanosecond formats drop the rest of the fraction
+    auto ns = gps_time_t(fs - ((fs % fs_per_ns) + fs_per_ns) % fs_per_ns);
+    CPPUNIT_ASSERT_EQUAL(gps, gps_time_t::FromGPSString(gps.ToString(
+      {time_style_t::gps, time_precision_t::fs})));
+    CPPUNIT_ASSERT_EQUAL(ns, gps_time_t::FromISOString(utc.ToString(
+      {time_style_t::basic, time_precision_t::ns})));
+    CPPUNIT_ASSERT_EQUAL(ns, gps_time_t::FromUTCString(utc.ToString(
+      {time_style_t::extended, time_precision_t::ns})));
+  }
+}
+
+void TimeFormatCppUnit::test_format_spec()
+{
+  auto gps = gps_time_t::FromGPSString("GPS_2024-02-29T01:02:03.25");
+  auto utc = gps.ToUTC();
+  CPPUNIT_ASSERT_EQUAL(std::string("GPS_2024-02-29T01:02:03.250Z"),
+                       fmt::format("{:.ms}", gps));
+  CPPUNIT_ASSERT_EQUAL(std::string("2024-02-29T01:02:03.250Z"),
+                       fmt::format("{:iso.ms}", gps));
+  CPPUNIT_ASSERT_EQUAL(std::string("20240229T010145.250000Z"),
+                       fmt::format("{:basic.us}", utc));
+  CPPUNIT_ASSERT_EQUAL(std::string("GPS_2024-02-29T01:01:45Z"),
+                       fmt::format("{:gps.s}", utc));
+  CPPUNIT_ASSERT_EQUAL(std::string("2024-02-29T01:01:45.250000000+00:00"),
+                       fmt::format("{:rfc3339.ns}", utc));
+  CPPUNIT_ASSERT_EQUAL(utc.ToString({time_style_t::basic,
+                                     time_precision_t::fs}),
+                       fmt::format("{:basic}", utc));
+  CPPUNIT_ASSERT_EQUAL(std::string("86400.000s"),
+                       fmt::format("{:.ms}", duration_t(fs_per_day)));
+  CPPUNIT_ASSERT_EQUAL(std::string("86400s"),
+                       fmt::format("{:.s}", duration_t(fs_per_day)));
+
+  for (auto spec : {"{:iso.}", "{:.sec}", "{:basic.ms.}", "{:ISO}",
+                    "{:.ms>20}", "{:}x{:extended}"}) {
+    CPPUNIT_ASSERT_THROW((void) fmt::format(fmt::runtime(spec), utc, utc),
+                         fmt::format_error);
+  }
+  // A duration takes only a precision
+  CPPUNIT_ASSERT_THROW(
+    (void) fmt::format(fmt::runtime("{:iso.ms}"), duration_t(0)),
+    fmt::format_error);
+}
@@ -0,0 +1,192 @@
+/**
+ * @file   test_unit_time_format_batch.cpp
+ * @brief  Tests for formatting columns of times into one buffer
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_format_batch.hpp"
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+/**
+ * @class TimeFormatBatchCppUnit
+ */
+class TimeFormatBatchCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TimeFormatBatchCppUnit);
+  CPPUNIT_TEST(test_fixed_width);
+  CPPUNIT_TEST(test_offsets);
+  CPPUNIT_TEST(test_threads);
+  CPPUNIT_TEST(test_bad_arguments);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void test_fixed_width();
+  void test_offsets();
+  void test_threads();
+  void test_bad_arguments();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(TimeFormatBatchCppUnit);
+
+namespace {
+
+const time_format_t all_formats[] = {
+  {time_style_t::extended, time_precision_t::fs},
+  {time_style_t::basic, time_precision_t::ms},
+  {time_style_t::gps, time_precision_t::ns},
+  {time_style_t::rfc3339, time_precision_t::s},
+  {time_style_t::rfc3339, time_precision_t::ps},
+};
+
+/**
+ * @brief Runs of times on the same day, with jumps between days, through a
+ * leap second, and (if `wide_years`) in years that aren't four digits
+ */
+std::vector<gps_time_t> sample_times(std::size_t count, bool wide_years)
+{
+  std::mt19937_64 rng(8086);
+  std::vector<gps_time_t> times;
+  auto t = gps_time_t::FromUTCString("2016-12-31T23:59:58Z");
+  for (std::size_t i = 0; i < count; i++) {
+    if (i % 500 == 499) {
+      auto days = static_cast<femtosecs_t>(rng() % 20'000) - 10'000;
+      t += duration_t(days * fs_per_day);
+    } else if (wide_years && i % 1000 == 250) {
+      t = gps_time_t(civil_fields_t{-500 + static_cast<int>(rng() % 2) * 20'500,
+                                    6, 1, 0, 0, 0, 0, 0, 0});
+    }
+    times.push_back(t);
+    t += duration_t(static_cast<femtosecs_t>(rng() % (fs_per_sec / 5)));
+  }
+  return times;
+}
+
+std::vector<utc_time_t> to_utc(const std::vector<gps_time_t> &times)
+{
+  std::vector<utc_time_t> utc;
+  for (const auto &t : times) {
+    utc.push_back(t.ToUTC());
+  }
+  return utc;
+}
+
+template <typename T>
+void check_fixed_width(const std::vector<T> &times, std::size_t stride,
+                       const time_format_t &format, unsigned threads)
+{
+  std::string out(times.size() * stride, '#');
+  CPPUNIT_ASSERT_EQUAL(out.size(),
+                       FormatColumn(std::span<const T>(times), out, stride,
+                                    format, threads));
+  for (std::size_t i = 0; i < times.size(); i++) {
+    auto expected = times[i].ToString(format);
+    expected.resize(stride, ' ');
+    CPPUNIT_ASSERT_EQUAL(expected, out.substr(i * stride, stride));
+  }
+}
+
+template <typename T>
+void check_offsets(const std::vector<T> &times, const time_format_t &format,
+                   unsigned threads)
+{
+  std::span<const T> span(times);
+  auto size = FormattedSize(span, format);
+  // One extra byte, which must be left alone
+  std::string out(size + 1, '#');
+  std::vector<std::size_t> offsets(times.size() + 1);
+  CPPUNIT_ASSERT_EQUAL(size, FormatColumn(span, out, offsets, format,
+                                          threads));
+  CPPUNIT_ASSERT_EQUAL(size, offsets.back());
+  CPPUNIT_ASSERT_EQUAL('#', out.back());
+  for (std::size_t i = 0; i < times.size(); i++) {
+    CPPUNIT_ASSERT_EQUAL(times[i].ToString(format),
+                         out.substr(offsets[i], offsets[i + 1] - offsets[i]));
+  }
+}
+
+} // namespace
+
+void TimeFormatBatchCppUnit::test_fixed_width()
+{
+  auto times = sample_times(3'000, false);
+  auto utc = to_utc(times);
+  for (const auto &format : all_formats) {
+    for (auto stride : {FormattedWidth(format), FormattedWidth(format) + 1,
+                        std::size_t{64}}) {
+      check_fixed_width(times, stride, format, 1);
+      check_fixed_width(utc, stride, format, 1);
+    }
+  }
+  // Wider years fit in a wider stride
+  check_fixed_width(sample_times(3'000, true), 64, all_formats[0], 1);
+}
+
+void TimeFormatBatchCppUnit::test_offsets()
+{
+  auto times = sample_times(3'000, true);
+  auto utc = to_utc(times);
+  for (const auto &format : all_formats) {
+    check_offsets(times, format, 1);
+    check_offsets(utc, format, 1);
+  }
+  check_offsets(std::vector<gps_time_t>(), all_formats[0], 1);
+}
+
+void TimeFormatBatchCppUnit::test_threads()
+{
+  // Enough times for several threads, with parts that end mid-record
+  auto times = sample_times(100'003, true);
+  auto utc = to_utc(times);
+  for (unsigned threads : {2u, 3u, 0u}) {
+    check_fixed_width(times, 40, all_formats[4], threads);
+    check_offsets(times, all_formats[1], threads);
+    check_offsets(utc, all_formats[0], threads);
+  }
+}
+
+void TimeFormatBatchCppUnit::test_bad_arguments()
+{
+  std::vector<gps_time_t> times(3);
+  time_format_t format{time_style_t::extended, time_precision_t::ms};
+  std::string out(100, ' ');
+  std::vector<std::size_t> offsets(4);
+  CPPUNIT_ASSERT_EQUAL(std::size_t{24}, FormattedWidth(format));
+  CPPUNIT_ASSERT_EQUAL(std::size_t{72}, FormatColumn(
+                         std::span<const gps_time_t>(times), out, 24, format));
+  CPPUNIT_ASSERT_EQUAL(std::size_t{72}, FormatColumn(
+                         std::span<const gps_time_t>(times), out, offsets,
+                         format));
+  // Too short a stride, too little room, too few offsets
+  CPPUNIT_ASSERT_THROW(FormatColumn(std::span<const gps_time_t>(times), out,
+                                    23, format), std::runtime_error);
+  CPPUNIT_ASSERT_THROW(FormatColumn(std::span<const gps_time_t>(times), out,
+                                    34, format), std::runtime_error);
+  CPPUNIT_ASSERT_THROW(FormatColumn(std::span<const gps_time_t>(times),
+                                    std::span(out).first(71), offsets,
+                                    format), std::runtime_error);
+  CPPUNIT_ASSERT_THROW(FormatColumn(std::span<const gps_time_t>(times), out,
+                                    std::span(offsets).first(3), format),
+                       std::runtime_error);
+  // A year that doesn't fit the stride
+  times[1] = gps_time_t(civil_fields_t{10000, 1, 1, 0, 0, 0, 0, 0, 0});
+  CPPUNIT_ASSERT_THROW(FormatColumn(std::span<const gps_time_t>(times), out,
+                                    24, format), std::runtime_error);
+  CPPUNIT_ASSERT_EQUAL(std::size_t{75}, FormatColumn(
+                         std::span<const gps_time_t>(times), out, 25, format));
+}
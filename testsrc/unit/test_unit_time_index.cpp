@@ -0,0 +1,173 @@
+/**
+ * @file   test_unit_time_index.cpp
+ * @brief  Tests for the cache-friendly time index
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_index.hpp"
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+/**
+ * @class TimeIndexCppUnit
+ */
+class TimeIndexCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TimeIndexCppUnit);
+  CPPUNIT_TEST(test_every_size);
+  CPPUNIT_TEST(test_duplicates);
+  CPPUNIT_TEST(test_ranges);
+  CPPUNIT_TEST(test_batched);
+  CPPUNIT_TEST(test_errors);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void test_every_size();
+  void test_duplicates();
+  void test_ranges();
+  void test_batched();
+  void test_errors();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(TimeIndexCppUnit);
+
+namespace {
+
+/** @brief Sorted times, `step` femtoseconds apart from an odd start */
+std::vector<gps_time_t> spaced_times(std::size_t count, femtosecs_t step)
+{
+  std::vector<gps_time_t> times;
+  auto start = gps_time_t::FromUTCString("2024-01-01T00:00:00Z");
+  for (std::size_t i = 0; i < count; i++) {
+    times.push_back(start + duration_t(femtosecs_t(i) * step));
+  }
+  return times;
+}
+
+/** @brief Check the index against std::lower_bound and std::upper_bound */
+void check_bounds(const std::vector<gps_time_t> &times,
+                  const time_index_t &index, const gps_time_t &time)
+{
+  auto lower = std::lower_bound(times.begin(), times.end(), time);
+  auto upper = std::upper_bound(times.begin(), times.end(), time);
+  CPPUNIT_ASSERT_EQUAL(std::size_t(lower - times.begin()),
+                       index.lower_bound(time));
+  CPPUNIT_ASSERT_EQUAL(std::size_t(upper - times.begin()),
+                       index.upper_bound(time));
+}
+
+} // namespace
+
+void TimeIndexCppUnit::test_every_size()
+{
+  // Every shape of last level, with keys on, between and outside the times
+  for (std::size_t count = 0; count <= 70; count++) {
+    auto times = spaced_times(count, 10);
+    time_index_t index(times);
+    CPPUNIT_ASSERT_EQUAL(count, index.size());
+    auto before = times.empty() ? gps_time_t() : times.front();
+    for (femtosecs_t offset = -15; offset <= femtosecs_t(count) * 10 + 5;
+         offset += 5) {
+      check_bounds(times, index, before + duration_t(offset));
+    }
+  }
+}
+
+void TimeIndexCppUnit::test_duplicates()
+{
+  std::mt19937_64 rng(7);
+  std::vector<gps_time_t> times;
+  for (int i = 0; i < 5'000; i++) {
+    times.push_back(gps_time_t(femtosecs_t(rng() % 300) * fs_per_sec));
+  }
+  std::sort(times.begin(), times.end());
+  time_index_t index(times);
+  for (int s = -1; s <= 301; s++) {
+    check_bounds(times, index, gps_time_t(femtosecs_t(s) * fs_per_sec));
+  }
+
+  // Raw femtosecond counts build the same index
+  std::vector<femtosecs_t> raw;
+  for (const auto &time : times) {
+    raw.push_back(time.get_fs());
+  }
+  time_index_t raw_index(raw);
+  auto key = gps_time_t(femtosecs_t(150) * fs_per_sec);
+  CPPUNIT_ASSERT_EQUAL(index.lower_bound(key), raw_index.lower_bound(key));
+  CPPUNIT_ASSERT_EQUAL(index.upper_bound(key), raw_index.upper_bound(key));
+}
+
+void TimeIndexCppUnit::test_ranges()
+{
+  auto times = spaced_times(1'000, fs_per_ms);
+  time_index_t index(times);
+  auto begin = times[100] + duration_t(1);
+  auto end = times[200];
+  auto range = index.Range(begin, end);
+  CPPUNIT_ASSERT_EQUAL(std::size_t{101}, range.first);
+  CPPUNIT_ASSERT_EQUAL(std::size_t{200}, range.last);
+  CPPUNIT_ASSERT_EQUAL(std::size_t{99}, index.Count(begin, end));
+  auto slice = range.Slice(std::span<const gps_time_t>(times));
+  CPPUNIT_ASSERT_EQUAL(std::size_t{99}, slice.size());
+  CPPUNIT_ASSERT_EQUAL(times[101], slice.front());
+  CPPUNIT_ASSERT_EQUAL(times[199], slice.back());
+
+  // Empty and reversed ranges, and ranges past either end
+  CPPUNIT_ASSERT(index.Range(end, end).empty());
+  CPPUNIT_ASSERT(index.Range(end, begin).empty());
+  CPPUNIT_ASSERT_EQUAL(std::size_t{1'000},
+                       index.Count(gps_time_t(), times.back() + duration_t(1)));
+  auto after = times.back() + duration_t(1);
+  CPPUNIT_ASSERT_EQUAL(std::size_t{0},
+                       index.Count(after, after + duration_t(fs_per_sec)));
+}
+
+void TimeIndexCppUnit::test_batched()
+{
+  std::mt19937_64 rng(11);
+  for (std::size_t count : {0, 1, 2, 15, 16, 17, 1'000, 65'537}) {
+    auto times = spaced_times(count, 3);
+    time_index_t index(times);
+    std::vector<gps_time_t> keys;
+    for (int i = 0; i < 101; i++) {
+      auto offset = femtosecs_t(rng() % (3 * count + 10)) - 5;
+      keys.push_back(gps_time_t::FromUTCString("2024-01-01T00:00:00Z") +
+                     duration_t(offset));
+    }
+    std::vector<std::size_t> found(keys.size());
+    index.LowerBounds(keys, found);
+    for (std::size_t i = 0; i < keys.size(); i++) {
+      CPPUNIT_ASSERT_EQUAL(index.lower_bound(keys[i]), found[i]);
+    }
+  }
+}
+
+void TimeIndexCppUnit::test_errors()
+{
+  auto times = spaced_times(10, 1);
+  std::swap(times[3], times[4]);
+  CPPUNIT_ASSERT_THROW(time_index_t{std::span<const gps_time_t>(times)},
+                       std::runtime_error);
+  std::swap(times[3], times[4]);
+  time_index_t index(times);
+  std::vector<std::size_t> out(times.size() - 1);
+  CPPUNIT_ASSERT_THROW(index.LowerBounds(times, out), std::runtime_error);
+
+  time_index_t empty;
+  CPPUNIT_ASSERT_EQUAL(std::size_t{0}, empty.lower_bound(times[0]));
+  CPPUNIT_ASSERT_EQUAL(std::size_t{0}, empty.Count(times[0], times[9]));
+}
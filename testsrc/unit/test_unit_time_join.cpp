@@ -0,0 +1,195 @@
+/**
+ * @file   test_unit_time_join.cpp
+ * @brief  Tests for the as-of joins of sorted times
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <algorithm>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_join.hpp"
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+/**
+ * @class TimeJoinCppUnit
+ */
+class TimeJoinCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TimeJoinCppUnit);
+  CPPUNIT_TEST(test_directions);
+  CPPUNIT_TEST(test_against_search);
+  CPPUNIT_TEST(test_threads);
+  CPPUNIT_TEST(test_errors);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void test_directions();
+  void test_against_search();
+  void test_threads();
+  void test_errors();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(TimeJoinCppUnit);
+
+namespace {
+
+std::vector<gps_time_t> seconds(std::initializer_list<int> values)
+{
+  std::vector<gps_time_t> times;
+  for (auto value : values) {
+    times.push_back(gps_time_t(femtosecs_t(value) * fs_per_sec));
+  }
+  return times;
+}
+
+/** @brief `count` sorted times, `spread` seconds apart at most */
+std::vector<gps_time_t> random_times(std::size_t count, int spread,
+                                     uint64_t seed)
+{
+  std::mt19937_64 rng(seed);
+  std::vector<gps_time_t> times(count);
+  for (auto &time : times) {
+    time = gps_time_t(femtosecs_t(rng() % (count * spread + 1)) * fs_per_sec);
+  }
+  std::sort(times.begin(), times.end());
+  return times;
+}
+
+/** @brief The match for one time, the slow way */
+std::size_t search_match(const std::vector<gps_time_t> &right,
+                         const gps_time_t &time, join_direction_t direction,
+                         std::optional<duration_t> tolerance)
+{
+  auto upper = std::upper_bound(right.begin(), right.end(), time);
+  auto lower = std::lower_bound(right.begin(), right.end(), time);
+  auto match = join_no_match;
+  if (direction != join_direction_t::forward && upper != right.begin()) {
+    match = upper - right.begin() - 1;
+  }
+  if (direction == join_direction_t::forward && lower != right.end()) {
+    match = lower - right.begin();
+  }
+  if (direction == join_direction_t::nearest && upper != right.end() &&
+      (match == join_no_match ||
+       *upper - time < time - right[match])) {
+    match = upper - right.begin();
+  }
+  if (match != join_no_match && tolerance) {
+    auto distance = right[match] < time ? time - right[match]
+                                        : right[match] - time;
+    if (*tolerance < distance) {
+      match = join_no_match;
+    }
+  }
+  return match;
+}
+
+const join_direction_t directions[] = {
+  join_direction_t::backward, join_direction_t::forward,
+  join_direction_t::nearest};
+
+} // namespace
+
+void TimeJoinCppUnit::test_directions()
+{
+  auto left = seconds({0, 10, 14, 16, 20, 35, 50});
+  auto right = seconds({10, 10, 12, 18, 30});
+  auto none = join_no_match;
+  std::vector<std::size_t> matches(left.size());
+
+  CPPUNIT_ASSERT_EQUAL(std::size_t{6}, AsOfJoin(left, right, matches));
+  CPPUNIT_ASSERT((std::vector<std::size_t>{none, 1, 2, 2, 3, 4, 4} ==
+                  matches));
+
+  AsOfJoin(left, right, matches, join_direction_t::forward);
+  CPPUNIT_ASSERT((std::vector<std::size_t>{0, 0, 3, 3, 4, none, none} ==
+                  matches));
+
+  // 14 is as near 12 as 16 is to 18: ties go to the earlier time
+  AsOfJoin(left, right, matches, join_direction_t::nearest);
+  CPPUNIT_ASSERT((std::vector<std::size_t>{0, 1, 2, 3, 3, 4, 4} ==
+                  matches));
+
+  auto tolerance = duration_t(2 * fs_per_sec);
+  CPPUNIT_ASSERT_EQUAL(std::size_t{4}, AsOfJoin(
+                         left, right, matches, join_direction_t::nearest,
+                         tolerance));
+  CPPUNIT_ASSERT((std::vector<std::size_t>{none, 1, 2, 3, 3, none, none} ==
+                  matches));
+  AsOfJoin(left, right, matches, join_direction_t::backward, duration_t(0));
+  CPPUNIT_ASSERT((std::vector<std::size_t>{none, 1, none, none, none, none,
+                                           none} == matches));
+
+  // Nothing on the right
+  CPPUNIT_ASSERT_EQUAL(std::size_t{0}, AsOfJoin(left, {}, matches));
+  CPPUNIT_ASSERT(std::all_of(matches.begin(), matches.end(),
+                             [](std::size_t m) {
+                               return m == join_no_match;
+                             }));
+}
+
+void TimeJoinCppUnit::test_against_search()
+{
+  // Equal sizes, and each side much longer than the other, with the right
+  // long enough for a search of it all for each left time
+  std::size_t sizes[][2] = {{1'000, 1'000}, {100, 5'000}, {10, 5'000},
+                            {5'000, 20}, {1, 1}, {0, 10}};
+  for (auto [left_size, right_size] : sizes) {
+    auto left = random_times(left_size, 3, left_size);
+    auto right = random_times(right_size, 3, right_size + 1);
+    std::vector<std::size_t> matches(left.size());
+    for (auto direction : directions) {
+      for (auto tolerance : {std::optional<duration_t>(),
+                             std::optional(duration_t(fs_per_sec))}) {
+        AsOfJoin(left, right, matches, direction, tolerance);
+        for (std::size_t i = 0; i < left.size(); i++) {
+          CPPUNIT_ASSERT_EQUAL(search_match(right, left[i], direction,
+                                            tolerance), matches[i]);
+        }
+      }
+    }
+  }
+}
+
+void TimeJoinCppUnit::test_threads()
+{
+  auto left = random_times(300'000, 2, 1);
+  auto right = random_times(200'000, 3, 2);
+  for (auto direction : directions) {
+    std::vector<std::size_t> one(left.size());
+    std::vector<std::size_t> four(left.size());
+    auto count = AsOfJoin(left, right, one, direction,
+                          duration_t(fs_per_sec));
+    CPPUNIT_ASSERT_EQUAL(count, AsOfJoin(left, right, four, direction,
+                                         duration_t(fs_per_sec), 4));
+    CPPUNIT_ASSERT(one == four);
+  }
+}
+
+void TimeJoinCppUnit::test_errors()
+{
+  auto sorted = seconds({1, 2, 3});
+  auto unsorted = seconds({1, 3, 2});
+  std::vector<std::size_t> matches(3);
+  CPPUNIT_ASSERT_THROW(AsOfJoin(unsorted, sorted, matches),
+                       std::runtime_error);
+  CPPUNIT_ASSERT_THROW(AsOfJoin(sorted, sorted,
+                                std::span(matches).first(2)),
+                       std::runtime_error);
+  CPPUNIT_ASSERT_THROW(AsOfJoin(sorted, sorted, matches,
+                                join_direction_t::nearest, duration_t(-1)),
+                       std::runtime_error);
+}
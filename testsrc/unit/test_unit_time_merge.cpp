@@ -0,0 +1,275 @@
+/**
+ * @file   test_unit_time_merge.cpp
+ * @brief  Tests for the loser-tree merge of time-sorted streams
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_merge.hpp"
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+/**
+ * @class TimeMergeCppUnit
+ */
+class TimeMergeCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TimeMergeCppUnit);
+  CPPUNIT_TEST(test_merge);
+  CPPUNIT_TEST(test_runs);
+  CPPUNIT_TEST(test_add_remove);
+  CPPUNIT_TEST(test_errors);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void test_merge();
+  void test_runs();
+  void test_add_remove();
+  void test_errors();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(TimeMergeCppUnit);
+
+namespace {
+
+/** @brief A sample: its time, and the stream and position it came from */
+struct sample_t
+{
+  gps_time_t time;
+  std::size_t stream;
+  std::size_t index;
+};
+
+struct sample_time_t
+{
+  gps_time_t operator()(const sample_t &sample) const
+  {
+    return sample.time;
+  }
+};
+
+using sample_stream_t = span_stream_t<sample_t, sample_time_t>;
+
+/**
+ * @brief `count` streams of up to `length` samples, with times from a few
+ * hundred values so that many are equal
+ */
+std::vector<std::vector<sample_t>> random_streams(std::size_t count,
+                                                  std::size_t length,
+                                                  uint64_t seed)
+{
+  std::mt19937_64 rng(seed);
+  std::vector<std::vector<sample_t>> streams(count);
+  for (std::size_t s = 0; s < count; s++) {
+    std::vector<femtosecs_t> times(rng() % (length + 1));
+    for (auto &fs : times) {
+      fs = femtosecs_t(rng() % 300) * fs_per_ms;
+    }
+    std::sort(times.begin(), times.end());
+    for (std::size_t i = 0; i < times.size(); i++) {
+      streams[s].push_back({gps_time_t(times[i]), s, i});
+    }
+  }
+  return streams;
+}
+
+/** @brief The stable merge: by time, then stream, then position */
+std::vector<sample_t> expected_merge(
+  const std::vector<std::vector<sample_t>> &streams)
+{
+  std::vector<sample_t> all;
+  for (const auto &stream : streams) {
+    all.insert(all.end(), stream.begin(), stream.end());
+  }
+  std::sort(all.begin(), all.end(), [](const auto &a, const auto &b) {
+    return std::tie(a.time, a.stream, a.index) <
+      std::tie(b.time, b.stream, b.index);
+  });
+  return all;
+}
+
+time_merge_t<sample_stream_t> make_merge(
+  const std::vector<std::vector<sample_t>> &streams)
+{
+  std::vector<sample_stream_t> spans;
+  for (const auto &stream : streams) {
+    spans.emplace_back(std::span<const sample_t>(stream));
+  }
+  return time_merge_t<sample_stream_t>(std::move(spans));
+}
+
+void check_same(const std::vector<sample_t> &expected,
+                const std::vector<sample_t> &merged)
+{
+  CPPUNIT_ASSERT_EQUAL(expected.size(), merged.size());
+  for (std::size_t i = 0; i < expected.size(); i++) {
+    CPPUNIT_ASSERT_EQUAL(expected[i].time, merged[i].time);
+    CPPUNIT_ASSERT_EQUAL(expected[i].stream, merged[i].stream);
+    CPPUNIT_ASSERT_EQUAL(expected[i].index, merged[i].index);
+  }
+}
+
+} // namespace
+
+void TimeMergeCppUnit::test_merge()
+{
+  // Tree sizes from one leaf up to more than a thousand
+  for (std::size_t count : {1, 2, 3, 5, 8, 33, 1'100}) {
+    auto streams = random_streams(count, 40, count);
+    auto merge = make_merge(streams);
+    std::vector<sample_t> merged;
+    while (!merge.empty()) {
+      CPPUNIT_ASSERT_EQUAL(merge.time(), merge.front().time);
+      CPPUNIT_ASSERT_EQUAL(merge.slot(), merge.front().stream);
+      merged.push_back(merge.front());
+      merge.pop();
+    }
+    check_same(expected_merge(streams), merged);
+  }
+
+  // A span of times is a stream
+  std::vector<gps_time_t> a = {gps_time_t(1), gps_time_t(4)};
+  std::vector<gps_time_t> b = {gps_time_t(2), gps_time_t(3)};
+  time_merge_t<span_stream_t<gps_time_t>> times(
+    {span_stream_t<gps_time_t>(a), span_stream_t<gps_time_t>(b)});
+  for (femtosecs_t fs = 1; fs <= 4; fs++) {
+    CPPUNIT_ASSERT_EQUAL(gps_time_t(fs), times.front());
+    times.pop();
+  }
+  CPPUNIT_ASSERT(times.empty());
+  CPPUNIT_ASSERT(time_merge_t<span_stream_t<gps_time_t>>().empty());
+}
+
+void TimeMergeCppUnit::test_runs()
+{
+  for (std::size_t count : {1, 4, 17}) {
+    for (std::size_t limit : {std::size_t{1}, std::size_t{3}, SIZE_MAX}) {
+      auto streams = random_streams(count, 200, count + limit);
+      auto merge = make_merge(streams);
+      std::vector<sample_t> merged;
+      while (!merge.empty()) {
+        auto slot = merge.slot();
+        auto before = merged.size();
+        auto run = merge.PopRun([&](const sample_t &sample) {
+          merged.push_back(sample);
+        }, limit);
+        CPPUNIT_ASSERT(run >= 1 && run <= limit);
+        CPPUNIT_ASSERT_EQUAL(before + run, merged.size());
+        CPPUNIT_ASSERT_EQUAL(slot, merged.back().stream);
+      }
+      check_same(expected_merge(streams), merged);
+    }
+  }
+
+  // Streams that take turns in long runs come out a run at a time
+  std::vector<std::vector<sample_t>> streams(2);
+  for (std::size_t i = 0; i < 1'000; i++) {
+    auto s = i / 100 % 2;
+    streams[s].push_back({gps_time_t(femtosecs_t(i)), s,
+                          streams[s].size()});
+  }
+  auto merge = make_merge(streams);
+  std::size_t runs = 0;
+  std::vector<sample_t> merged;
+  while (merge.PopRun([&](const sample_t &sample) {
+    merged.push_back(sample);
+  })) {
+    runs++;
+  }
+  CPPUNIT_ASSERT_EQUAL(std::size_t{10}, runs);
+  check_same(expected_merge(streams), merged);
+}
+
+void TimeMergeCppUnit::test_add_remove()
+{
+  auto streams = random_streams(6, 50, 21);
+  std::vector<sample_stream_t> first;
+  for (std::size_t s = 0; s < 3; s++) {
+    first.emplace_back(std::span<const sample_t>(streams[s]));
+  }
+  time_merge_t<sample_stream_t> merge(std::move(first));
+
+  // Take some records, then add three streams that start later
+  std::vector<sample_t> merged;
+  auto cutoff = gps_time_t(100 * fs_per_ms);
+  while (!merge.empty() && merge.time() < cutoff) {
+    merged.push_back(merge.front());
+    merge.pop();
+  }
+  for (std::size_t s = 3; s < 6; s++) {
+    auto &stream = streams[s];
+    auto later = std::lower_bound(stream.begin(), stream.end(), cutoff,
+                                  [](const sample_t &sample, gps_time_t time) {
+                                    return sample.time < time;
+                                  });
+    stream.erase(stream.begin(), later);
+    for (std::size_t i = 0; i < stream.size(); i++) {
+      stream[i].index = i;
+    }
+    CPPUNIT_ASSERT_EQUAL(s, merge.Add(sample_stream_t(stream)));
+  }
+
+  // Then drop stream 1 part-way through
+  auto drop = gps_time_t(200 * fs_per_ms);
+  while (!merge.empty() && merge.time() < drop) {
+    merged.push_back(merge.front());
+    merge.pop();
+  }
+  merge.Remove(1);
+  CPPUNIT_ASSERT(merge.stream(1) == nullptr);
+  CPPUNIT_ASSERT(merge.stream(0) != nullptr);
+  while (!merge.empty()) {
+    merged.push_back(merge.front());
+    merge.pop();
+  }
+
+  auto &dropped = streams[1];
+  dropped.erase(std::remove_if(dropped.begin(), dropped.end(),
+                               [&](const sample_t &sample) {
+                                 return !(sample.time < drop);
+                               }), dropped.end());
+  for (std::size_t s = 0; s < 3; s++) {
+    for (auto &sample : streams[s]) {
+      sample.index = 0;
+    }
+  }
+  auto expected = expected_merge(streams);
+  CPPUNIT_ASSERT_EQUAL(expected.size(), merged.size());
+  for (std::size_t i = 0; i < expected.size(); i++) {
+    CPPUNIT_ASSERT_EQUAL(expected[i].time, merged[i].time);
+    CPPUNIT_ASSERT_EQUAL(expected[i].stream, merged[i].stream);
+  }
+
+  // A freed slot is used again
+  CPPUNIT_ASSERT_EQUAL(std::size_t{1}, merge.Add(sample_stream_t(streams[0])));
+  CPPUNIT_ASSERT_THROW(merge.Remove(9), std::runtime_error);
+}
+
+void TimeMergeCppUnit::test_errors()
+{
+  std::vector<gps_time_t> unsorted = {gps_time_t(2), gps_time_t(1)};
+  time_merge_t<span_stream_t<gps_time_t>> merge(
+    {span_stream_t<gps_time_t>(unsorted)});
+  CPPUNIT_ASSERT_THROW(merge.pop(), std::runtime_error);
+
+  std::vector<gps_time_t> last = {
+    gps_time_t(std::numeric_limits<femtosecs_t>::max())};
+  CPPUNIT_ASSERT_THROW(time_merge_t<span_stream_t<gps_time_t>>(
+                         {span_stream_t<gps_time_t>(last)}),
+                       std::runtime_error);
+}
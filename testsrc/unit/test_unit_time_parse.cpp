@@ -0,0 +1,292 @@
+/**
+ * @file   test_unit_time_parse.cpp
+ * @brief  Tests for the hand-written timestamp parser
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_parse.hpp"
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+namespace {
+
+// The sscanf-based parser that the hand-written one replaced, kept here (less
+// comments) as the reference for the equivalence tests.
+gps_time_t legacy_from_utc_string(const std::string& utc_time)
+{
+  int year, month, day, hour, min, seconds;
+  long nanos = 0, femtos = 0;
+  if (utc_time.find(".") == std::string::npos) {
+    auto result = sscanf(utc_time.c_str(), "%04d-%02d-%02dT%02d:%02d:%02d",
+                         &year, &month, &day, &hour, &min, &seconds);
+    CPPUNIT_ASSERT_EQUAL(6, result);
+  } else {
+    unsigned long long unscaled_partials;
+    int pre_partials, post_partials;
+    auto result = sscanf(utc_time.c_str(),
+                         "%04d-%02d-%02dT%02d:%02d:%02d.%n%llu%nZ",
+                         &year, &month, &day, &hour, &min, &seconds,
+                         &pre_partials, &unscaled_partials, &post_partials);
+    CPPUNIT_ASSERT_EQUAL(7, result);
+    femtosecs_t total_femtos = unscaled_partials;
+    for (int i = post_partials - pre_partials; i < 15; i++) {
+      total_femtos *= 10;
+    }
+    for (int i = 15; i < post_partials - pre_partials; i++) {
+      total_femtos /= 10;
+    }
+    nanos = total_femtos / fs_per_ns;
+    femtos = total_femtos % fs_per_ns;
+  }
+  utc_time_t parsed_time(year, month, day, hour, min, seconds, nanos);
+  return gps_time_t::FromUTC(parsed_time) + duration_t(femtos);
+}
+
+} // namespace
+
+/**
+ * @class TimeParseCppUnit
+ */
+class TimeParseCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TimeParseCppUnit);
+  CPPUNIT_TEST(test_legacy_equivalence);
+  CPPUNIT_TEST(test_fraction_digits);
+  CPPUNIT_TEST(test_layouts);
+  CPPUNIT_TEST(test_malformed);
+  CPPUNIT_TEST(test_error_offsets);
+  CPPUNIT_TEST(test_try_matches_throwing);
+  CPPUNIT_TEST(test_string2date);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void test_legacy_equivalence();
+  void test_fraction_digits();
+  void test_layouts();
+  void test_malformed();
+  void test_error_offsets();
+  void test_try_matches_throwing();
+  void test_string2date();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(TimeParseCppUnit);
+
+/**
+ * @brief Random well-formed timestamps parse the same as with sscanf
+ */
+void TimeParseCppUnit::test_legacy_equivalence()
+{
+  std::mt19937_64 rng(8601);
+  for (int i = 0; i < 100'000; i++) {
+    int year = 1900 + rng() % 200;
+    int month = 1 + rng() % 12;
+    int day = 1 + rng() % 28;
+    int hour = rng() % 24;
+    int minute = rng() % 60;
+    int second = rng() % 60;
+    auto text = fmt::format("{:04}-{:02}-{:02}T{:02}:{:02}:{:02}",
+                            year, month, day, hour, minute, second);
+    // Up to 18 fractional digits (the most the legacy parser reads exactly)
+    if (auto digits = rng() % 19; digits > 0) {
+      text += '.';
+      for (size_t d = 0; d < digits; d++) {
+        text += static_cast<char>('0' + rng() % 10);
+      }
+    }
+    if (rng() % 2) {
+      text += 'Z';
+    }
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(text, legacy_from_utc_string(text),
+                                 gps_time_t::FromUTCString(text));
+  }
+}
+
+void TimeParseCppUnit::test_fraction_digits()
+{
+  constexpr auto fraction = [](std::string_view text) {
+    civil_fields_t fields{};
+    parse_iso_fields(text, iso_layout_t::extended, fields);
+    return static_cast<femtosecs_t>(fields.nanosecond) * fs_per_ns
+      + fields.femtosecond;
+  };
+  static_assert(fraction("2000-01-01T00:00:00") == 0);
+  static_assert(fraction("2000-01-01T00:00:00.5") == fs_per_sec / 2);
+  static_assert(fraction("2000-01-01T00:00:00.000000000000001") == 1);
+  static_assert(fraction("2000-01-01T00:00:00.123456789012345678")
+                == 123'456'789'012'345);
+  // Digits past the precision are truncated, however many there are
+  CPPUNIT_ASSERT(fraction("2000-01-01T00:00:00.999999999999999999999999999")
+                 == fs_per_sec - 1);
+}
+
+void TimeParseCppUnit::test_layouts()
+{
+  // One-digit fields
+  CPPUNIT_ASSERT_EQUAL(gps_time_t(2022, 1, 1, 2, 3, 4, 0),
+                       gps_time_t::FromGPSString("GPS_2022-1-1T2:3:4"));
+  // Leap seconds
+  auto leap = gps_time_t::FromUTCString("2016-12-31T23:59:60.25Z");
+  CPPUNIT_ASSERT(leap.ToUTC().is_leap());
+  CPPUNIT_ASSERT_EQUAL(gps_time_t::FromUTCString("2016-12-31T23:59:59.25")
+                         + duration_t(fs_per_sec), leap);
+  // Basic layout, with and without a fraction
+  CPPUNIT_ASSERT_EQUAL(gps_time_t::FromUTCString("2020-02-29T12:34:56"),
+                       gps_time_t::FromISOString("20200229T123456"));
+  CPPUNIT_ASSERT_EQUAL(gps_time_t::FromUTCString("2020-02-29T12:34:56.125Z"),
+                       gps_time_t::FromISOString("20200229T123456.125Z"));
+  // string_view and const char* both work without a std::string
+  std::string_view view = "GPS_1980-01-06T00:00:00.0Zjunk";
+  CPPUNIT_ASSERT_EQUAL(gps_time_t(0),
+                       gps_time_t::FromGPSString(view.substr(0, 26)));
+}
+
+void TimeParseCppUnit::test_malformed()
+{
+  for (const char *text : {"", "2020", "2020-01-01", "2020-01-01T00:00",
+                           "2020-01-01T00:00:00.", "2020-01-01T00:00:00.Z",
+                           "2020-01-01 00:00:00", "2020-01-01T00:00:00ZZ",
+                           "2020-01-01T00:00:00+00:00", "20201-01-01T00:00:00",
+                           "2020-001-01T00:00:00", "2020-01-01T0a:00:00",
+                           "2020/01/01T00:00:00"}) {
+    CPPUNIT_ASSERT_THROW_MESSAGE(text, gps_time_t::FromUTCString(text),
+                                 std::runtime_error);
+  }
+  CPPUNIT_ASSERT_THROW(gps_time_t::FromGPSString("2020-01-01T00:00:00Z"),
+                       std::runtime_error);
+  CPPUNIT_ASSERT_THROW(gps_time_t::FromISOString("2020-01-01T00:00:00Z"),
+                       std::runtime_error);
+  CPPUNIT_ASSERT_THROW(gps_time_t::FromISOString("20200101T0000"),
+                       std::runtime_error);
+}
+
+void TimeParseCppUnit::test_error_offsets()
+{
+  static_assert(noexcept(TryFromUTCString("")));
+  constexpr auto status = [](std::string_view text) {
+    civil_fields_t fields{};
+    return parse_iso_fields(text, iso_layout_t::extended, fields);
+  };
+  static_assert(status("2020-01-01T00:00:00.5Z"));
+  // One-digit fields are allowed, so this is a missing separator
+  static_assert(status("2020-01-01T0a:00:00").error
+                == parse_error_t::expected_separator);
+  static_assert(status("2020-01-01T0a:00:00").offset == 12);
+
+  struct case_t
+  {
+    const char *text;
+    parse_error_t error;
+    std::size_t offset;
+  };
+  for (auto [text, error, offset] : {
+      case_t{"", parse_error_t::julian_date, 0},
+      case_t{"51604", parse_error_t::julian_date, 0},
+      case_t{"2020-01-01", parse_error_t::expected_separator, 10},
+      case_t{"2020-01-01T00:00", parse_error_t::expected_separator, 16},
+      case_t{"2020-01-01T00:00:", parse_error_t::expected_digit, 17},
+      case_t{"2020-01-01 00:00:00", parse_error_t::expected_separator, 10},
+      case_t{"20201-01-01T00:00:00", parse_error_t::expected_separator, 4},
+      case_t{"2020-001-01T00:00:00", parse_error_t::expected_separator, 7},
+      case_t{"2020/01/01T00:00:00", parse_error_t::julian_date, 0},
+      case_t{"2020-01/01T00:00:00", parse_error_t::expected_separator, 7},
+      case_t{"2020-01-01T00:00:00.", parse_error_t::empty_fraction, 20},
+      case_t{"2020-01-01T00:00:00.Z", parse_error_t::empty_fraction, 20},
+      case_t{"2020-01-01T00:00:00ZZ",
+             parse_error_t::trailing_characters, 20},
+      case_t{"2020-01-01T00:00:00.25+00:00",
+             parse_error_t::trailing_characters, 22}}) {
+    auto result = TryFromUTCString(text);
+    CPPUNIT_ASSERT_MESSAGE(text, !result.has_value());
+    CPPUNIT_ASSERT_MESSAGE(text, result.error == error);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(text, offset, result.offset);
+  }
+
+  // Offsets in GPS strings count the prefix
+  auto gps = TryFromGPSString("GPS_2020-01-01T00:x0:00");
+  CPPUNIT_ASSERT(gps.error == parse_error_t::expected_digit);
+  CPPUNIT_ASSERT_EQUAL(size_t{18}, gps.offset);
+  gps = TryFromGPSString("GPX_2020-01-01T00:00:00");
+  CPPUNIT_ASSERT(gps.error == parse_error_t::expected_separator);
+  CPPUNIT_ASSERT_EQUAL(size_t{2}, gps.offset);
+
+  auto iso = TryFromISOString("20200101T0000");
+  CPPUNIT_ASSERT(iso.error == parse_error_t::expected_digit);
+  CPPUNIT_ASSERT_EQUAL(size_t{13}, iso.offset);
+  iso = TryFromISOString("20200101 000000");
+  CPPUNIT_ASSERT(iso.error == parse_error_t::expected_separator);
+  CPPUNIT_ASSERT_EQUAL(size_t{8}, iso.offset);
+}
+
+/**
+ * @brief Randomly damaged timestamps are accepted or rejected by the try and
+ * throwing functions alike
+ */
+void TimeParseCppUnit::test_try_matches_throwing()
+{
+  std::mt19937_64 rng(404);
+  const std::string samples[] = {"2016-12-31T23:59:60.25Z",
+                                 "1999-1-2T3:4:5.000000001",
+                                 "GPS_2020-02-29T12:34:56.125Z",
+                                 "20200229T123456.125Z"};
+  const std::string noise = "0123456789-T:.Z_ x";
+  for (int i = 0; i < 20'000; i++) {
+    auto text = samples[rng() % std::size(samples)];
+    switch (rng() % 3) {
+    case 0:
+      text[rng() % text.size()] = noise[rng() % noise.size()];
+      break;
+    case 1:
+      text.erase(rng() % text.size(), 1);
+      break;
+    default:
+      text.insert(rng() % text.size(), 1, noise[rng() % noise.size()]);
+    }
+    for (auto [try_parse, parse] : {
+        std::pair{&TryFromUTCString, &gps_time_t::FromUTCString},
+        std::pair{&TryFromGPSString, &gps_time_t::FromGPSString},
+        std::pair{&TryFromISOString, &gps_time_t::FromISOString}}) {
+      auto result = try_parse(text);
+      if (result) {
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(text, result.value, parse(text));
+      } else {
+        CPPUNIT_ASSERT_MESSAGE(text, result.offset <= text.size());
+        CPPUNIT_ASSERT_THROW_MESSAGE(text, parse(text), std::runtime_error);
+      }
+    }
+  }
+}
+
+void TimeParseCppUnit::test_string2date()
+{
+  CPPUNIT_ASSERT_EQUAL(std::string("2000-02-29"), String2Date("51603"));
+  CPPUNIT_ASSERT_EQUAL(std::string("2000-02-29"), String2Date("2000-02-29"));
+  CPPUNIT_ASSERT_THROW(String2Date("516x3"), std::runtime_error);
+
+  auto result = TryString2Date("51603");
+  CPPUNIT_ASSERT(result && result.value == (civil_date_t{2000, 2, 29}));
+  result = TryString2Date("1999-1-2");
+  CPPUNIT_ASSERT(result && result.value == (civil_date_t{1999, 1, 2}));
+  result = TryString2Date("1234567890");
+  CPPUNIT_ASSERT(result.error == parse_error_t::out_of_range);
+  result = TryString2Date("1999-01-02T");
+  CPPUNIT_ASSERT(result.error == parse_error_t::trailing_characters);
+  CPPUNIT_ASSERT_EQUAL(size_t{10}, result.offset);
+}
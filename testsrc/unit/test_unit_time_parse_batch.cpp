@@ -0,0 +1,186 @@
+/**
+ * @file   test_unit_time_parse_batch.cpp
+ * @brief  Tests for parsing columns of fixed-width timestamps
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_parse.hpp"
+#include "femtotime/time_parse_batch.hpp"
+
+// [fmt]
+#include <fmt/format.h>
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+/**
+ * @class TimeParseBatchCppUnit
+ */
+class TimeParseBatchCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TimeParseBatchCppUnit);
+  CPPUNIT_TEST(test_layouts);
+  CPPUNIT_TEST(test_leap_seconds);
+  CPPUNIT_TEST(test_bad_arguments);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void test_layouts();
+  void test_leap_seconds();
+  void test_bad_arguments();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(TimeParseBatchCppUnit);
+
+namespace {
+
+const parse_kernel_t all_kernels[] = {parse_kernel_t::scalar,
+                                      parse_kernel_t::ssse3,
+                                      parse_kernel_t::avx2,
+                                      parse_kernel_t::automatic};
+
+/**
+ * @brief A column of random timestamps, about one in eight with a byte
+ * changed, and whether each row still fits the layout
+ */
+std::string random_column(const iso_column_t &layout, std::size_t rows,
+                          std::mt19937_64 &rng, std::vector<bool> &expected)
+{
+  std::string data;
+  expected.assign(rows, true);
+  for (std::size_t i = 0; i < rows; i++) {
+    auto text = fmt::format("{:04}-{:02}-{:02}T{:02}:{:02}:{:02}",
+                            1900 + rng() % 200, 1 + rng() % 12,
+                            1 + rng() % 28, rng() % 24, rng() % 60,
+                            rng() % 60);
+    if (layout.fraction_digits > 0) {
+      text += fmt::format(".{:0{}}", rng() % 1'000'000'000,
+                          layout.fraction_digits).substr(
+                            0, layout.fraction_digits + 1);
+    }
+    if (layout.zulu) {
+      text += 'Z';
+    }
+    if (rng() % 8 == 0) {
+      const std::string noise = "0123456789-T:.Z /";
+      auto pos = rng() % text.size();
+      char was = text[pos];
+      text[pos] = noise[rng() % noise.size()];
+      expected[i] = is_digit(was) ? is_digit(text[pos]) : was == text[pos];
+    }
+    text.resize(layout.stride, ' ');
+    data += text;
+  }
+  // The last row needs no padding
+  data.resize(data.size() - (layout.stride - layout.width()));
+  return data;
+}
+
+} // namespace
+
+/**
+ * @brief Every kernel gives the same times and validity as the string
+ * parser, for every layout and for strides with and without padding
+ */
+void TimeParseBatchCppUnit::test_layouts()
+{
+  std::mt19937_64 rng(2038);
+  for (int digits = 0; digits <= 9; digits++) {
+    for (bool zulu : {false, true}) {
+      iso_column_t layout{{}, 0, digits, zulu};
+      for (auto stride : {layout.width(), layout.width() + 3,
+                          std::size_t{64}}) {
+        layout.stride = stride;
+        std::vector<bool> expected;
+        auto data = random_column(layout, 200, rng, expected);
+        iso_column_t column{data, stride, digits, zulu};
+        CPPUNIT_ASSERT_EQUAL(std::size_t{200}, column.rows());
+
+        for (auto kernel : all_kernels) {
+          std::vector<gps_time_t> gps(column.rows());
+          std::vector<utc_time_t> utc(column.rows());
+          std::vector<uint64_t> valid((column.rows() + 63) / 64);
+          std::vector<uint64_t> utc_valid(valid.size());
+          auto count = ParseUTCColumn(column, gps, valid, kernel);
+          CPPUNIT_ASSERT_EQUAL(count,
+                               ParseUTCColumn(column, utc, utc_valid, kernel));
+          CPPUNIT_ASSERT(valid == utc_valid);
+
+          std::size_t expected_count = 0;
+          for (std::size_t i = 0; i < column.rows(); i++) {
+            auto text = data.substr(i * stride, column.width());
+            bool is_valid = (valid[i / 64] >> (i % 64)) & 1;
+            CPPUNIT_ASSERT_EQUAL_MESSAGE(text, bool(expected[i]), is_valid);
+            expected_count += is_valid;
+            if (!is_valid) {
+              CPPUNIT_ASSERT_EQUAL(gps_time_t(), gps[i]);
+              continue;
+            }
+            auto parsed = gps_time_t::FromUTCString(text);
+            CPPUNIT_ASSERT_EQUAL_MESSAGE(text, parsed, gps[i]);
+            CPPUNIT_ASSERT(parsed.ToUTC().get_fs() == utc[i].get_fs());
+          }
+          CPPUNIT_ASSERT_EQUAL(expected_count, count);
+        }
+      }
+    }
+  }
+}
+
+void TimeParseBatchCppUnit::test_leap_seconds()
+{
+  std::string data = "2016-12-31T23:59:59.500Z"
+                     "2016-12-31T23:59:60.000Z"
+                     "2016-12-31T23:59:60.999Z"
+                     "2017-01-01T00:00:00.000Z";
+  iso_column_t column{data, 24, 3, true};
+  for (auto kernel : all_kernels) {
+    std::vector<gps_time_t> gps(column.rows());
+    std::vector<utc_time_t> utc(column.rows());
+    uint64_t valid = 0;
+    CPPUNIT_ASSERT_EQUAL(std::size_t{4},
+                         ParseUTCColumn(column, gps, {&valid, 1}, kernel));
+    CPPUNIT_ASSERT_EQUAL(std::size_t{4},
+                         ParseUTCColumn(column, utc, {&valid, 1}, kernel));
+    for (std::size_t i = 0; i < gps.size(); i++) {
+      auto text = data.substr(i * 24, 24);
+      CPPUNIT_ASSERT_EQUAL(gps_time_t::FromUTCString(text), gps[i]);
+      CPPUNIT_ASSERT_EQUAL(i == 1 || i == 2, utc[i].is_leap());
+      CPPUNIT_ASSERT_EQUAL(gps[i], gps_time_t::FromUTC(utc[i]));
+    }
+  }
+}
+
+void TimeParseBatchCppUnit::test_bad_arguments()
+{
+  std::string data = "2020-01-01T00:00:00Z2020-01-01T00:00:01Z";
+  std::vector<gps_time_t> gps(2);
+  uint64_t valid;
+  CPPUNIT_ASSERT_EQUAL(std::size_t{2},
+                       ParseUTCColumn({data, 20, 0, true}, gps, {&valid, 1}));
+  CPPUNIT_ASSERT_EQUAL(uint64_t{3}, valid);
+  // Too many rows for the output
+  CPPUNIT_ASSERT_THROW(ParseUTCColumn({data, 20, 0, true},
+                                      std::span(gps).first(1), {&valid, 1}),
+                       std::runtime_error);
+  CPPUNIT_ASSERT_THROW(ParseUTCColumn({data, 20, 0, true}, gps, {}),
+                       std::runtime_error);
+  // Rows that overlap, and unsupported fractions
+  CPPUNIT_ASSERT_THROW(ParseUTCColumn({data, 10, 0, true}, gps, {&valid, 1}),
+                       std::runtime_error);
+  CPPUNIT_ASSERT_THROW(ParseUTCColumn({data, 40, 10, true}, gps, {&valid, 1}),
+                       std::runtime_error);
+}
@@ -0,0 +1,189 @@
+/**
+ * @file   test_unit_time_sort.cpp
+ * @brief  Tests for the radix sorts of times and durations
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_sort.hpp"
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+/**
+ * @class TimeSortCppUnit
+ */
+class TimeSortCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TimeSortCppUnit);
+  CPPUNIT_TEST(test_sort_times);
+  CPPUNIT_TEST(test_sort_durations);
+  CPPUNIT_TEST(test_threads);
+  CPPUNIT_TEST(test_sorted_order);
+  CPPUNIT_TEST(test_sort_by_time);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void test_sort_times();
+  void test_sort_durations();
+  void test_threads();
+  void test_sorted_order();
+  void test_sort_by_time();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(TimeSortCppUnit);
+
+namespace {
+
+/**
+ * @brief `count` times over `spread` femtoseconds from a base in 2024, so
+ * the high bytes of every time are the same
+ */
+std::vector<gps_time_t> random_times(std::size_t count, uint64_t spread,
+                                     uint64_t seed)
+{
+  std::mt19937_64 rng(seed);
+  auto base = gps_time_t::FromUTCString("2024-06-01T00:00:00Z");
+  std::vector<gps_time_t> times;
+  for (std::size_t i = 0; i < count; i++) {
+    times.push_back(base + duration_t(femtosecs_t(rng() % spread)));
+  }
+  return times;
+}
+
+} // namespace
+
+void TimeSortCppUnit::test_sort_times()
+{
+  // Spreads from one byte of difference to a full 64-bit range
+  auto second = static_cast<uint64_t>(fs_per_sec);
+  for (uint64_t spread : {uint64_t{1}, uint64_t{200}, uint64_t{1} << 20,
+                          second, ~uint64_t{0}}) {
+    for (std::size_t count : {0, 1, 2, 3, 1'000}) {
+      auto times = random_times(count, spread, count + spread);
+      auto expected = times;
+      std::sort(expected.begin(), expected.end());
+      SortTimes(times);
+      CPPUNIT_ASSERT(expected == times);
+    }
+  }
+
+  // Times on both sides of the epoch and at the ends of the range
+  std::vector<gps_time_t> times = {
+    gps_time_t(5), gps_time_t(-5), gps_time_t(0),
+    gps_time_t(std::numeric_limits<femtosecs_t>::max()),
+    gps_time_t(std::numeric_limits<femtosecs_t>::min()),
+    gps_time_t(-fs_per_day * 400), gps_time_t(fs_per_day * 400),
+    gps_time_t(-1), gps_time_t(1), gps_time_t(0)};
+  auto expected = times;
+  std::sort(expected.begin(), expected.end());
+  SortTimes(times);
+  CPPUNIT_ASSERT(expected == times);
+}
+
+void TimeSortCppUnit::test_sort_durations()
+{
+  std::mt19937_64 rng(3);
+  std::vector<duration_t> durations;
+  for (int i = 0; i < 2'000; i++) {
+    auto fs = femtosecs_t(static_cast<int64_t>(rng())) * (i % 7 + 1);
+    durations.push_back(duration_t(fs));
+  }
+  auto expected = durations;
+  std::sort(expected.begin(), expected.end());
+  SortTimes(durations);
+  CPPUNIT_ASSERT(expected == durations);
+}
+
+void TimeSortCppUnit::test_threads()
+{
+  // Enough times for four threads, skewed so most land in a few buckets
+  auto times = random_times(400'000, static_cast<uint64_t>(fs_per_sec), 5);
+  auto outliers = random_times(1'000, ~uint64_t{0}, 6);
+  times.insert(times.end(), outliers.begin(), outliers.end());
+  std::shuffle(times.begin(), times.end(), std::mt19937_64(8));
+  auto expected = times;
+  std::sort(expected.begin(), expected.end());
+  for (unsigned threads : {2u, 4u, 0u}) {
+    auto sorted = times;
+    SortTimes(sorted, threads);
+    CPPUNIT_ASSERT(expected == sorted);
+  }
+
+  std::vector<std::size_t> order(times.size());
+  SortedOrder(times, order, 4);
+  for (std::size_t i = 0; i < times.size(); i++) {
+    CPPUNIT_ASSERT_EQUAL(expected[i], times[order[i]]);
+  }
+
+  // A single zero time puts all the others in one bucket of the first
+  // split, which is split again
+  times = random_times(300'000, static_cast<uint64_t>(fs_per_hour), 10);
+  times[times.size() / 2] = gps_time_t(0);
+  expected = times;
+  std::sort(expected.begin(), expected.end());
+  for (unsigned threads : {1u, 4u}) {
+    auto sorted = times;
+    SortTimes(sorted, threads);
+    CPPUNIT_ASSERT(expected == sorted);
+  }
+}
+
+void TimeSortCppUnit::test_sorted_order()
+{
+  // Few distinct times, so the order of equal times shows
+  auto times = random_times(5'000, 50, 9);
+  std::vector<std::size_t> order(times.size());
+  SortedOrder(times, order);
+  std::vector<std::size_t> expected(times.size());
+  for (std::size_t i = 0; i < expected.size(); i++) {
+    expected[i] = i;
+  }
+  std::stable_sort(expected.begin(), expected.end(),
+                   [&](std::size_t a, std::size_t b) {
+                     return times[a] < times[b];
+                   });
+  CPPUNIT_ASSERT(expected == order);
+
+  std::vector<std::size_t> short_order(times.size() - 1);
+  CPPUNIT_ASSERT_THROW(SortedOrder(times, short_order), std::runtime_error);
+}
+
+void TimeSortCppUnit::test_sort_by_time()
+{
+  struct sample_t
+  {
+    gps_time_t time;
+    std::string channel;
+  };
+  auto times = random_times(3'000, 100, 10);
+  std::vector<sample_t> samples;
+  for (std::size_t i = 0; i < times.size(); i++) {
+    samples.push_back({times[i], std::to_string(i)});
+  }
+  auto expected = samples;
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const sample_t &a, const sample_t &b) {
+                     return a.time < b.time;
+                   });
+  SortByTime(std::span(samples),
+             [](const sample_t &sample) { return sample.time; });
+  for (std::size_t i = 0; i < samples.size(); i++) {
+    CPPUNIT_ASSERT_EQUAL(expected[i].time, samples[i].time);
+    CPPUNIT_ASSERT_EQUAL(expected[i].channel, samples[i].channel);
+  }
+}
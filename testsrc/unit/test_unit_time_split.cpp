@@ -0,0 +1,149 @@
+/**
+ * @file   test_unit_time_split.cpp
+ * @brief  Tests for the fixed-constant femtosecond division routines
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <random>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_split.hpp"
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+/**
+ * @class TimeSplitCppUnit
+ */
+class TimeSplitCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TimeSplitCppUnit);
+  CPPUNIT_TEST(test_split_secs);
+  CPPUNIT_TEST(test_udivmod);
+  CPPUNIT_TEST(test_duration_totals);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void test_split_secs();
+  void test_udivmod();
+  void test_duration_totals();
+
+private:
+  std::vector<femtosecs_t> sample_values();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(TimeSplitCppUnit);
+
+/**
+ * @brief Edge cases around second boundaries plus random values spanning the
+ * whole supported range
+ */
+std::vector<femtosecs_t> TimeSplitCppUnit::sample_values()
+{
+  std::vector<femtosecs_t> values = {0, 1, -1, fs_per_sec, -fs_per_sec,
+                                     fs_per_sec - 1, 1 - fs_per_sec,
+                                     fs_per_day, -fs_per_day - 1};
+  femtosecs_t max_secs = static_cast<femtosecs_t>(INT64_MAX) - 1;
+  values.push_back(max_secs * fs_per_sec + fs_per_sec - 1);
+  values.push_back(-max_secs * fs_per_sec - fs_per_sec + 1);
+
+  std::mt19937_64 rng(12345);
+  for (int i = 0; i < 200'000; i++) {
+    // Vary the magnitude (up to 112 bits) so that every digit of the long
+    // division is exercised
+    auto raw = (static_cast<uint128_t>(rng()) << 64) | rng();
+    auto value = static_cast<femtosecs_t>(raw >> (16 + rng() % 112));
+    values.push_back(value);
+    values.push_back(-value);
+    // Times near "now" are the common case
+    auto secs = static_cast<femtosecs_t>(1'400'000'000 + rng() % 1'000'000);
+    auto subsec = static_cast<femtosecs_t>(rng() % fs_per_sec);
+    values.push_back(secs * fs_per_sec + subsec);
+  }
+  return values;
+}
+
+void TimeSplitCppUnit::test_split_secs()
+{
+  for (auto fs : sample_values()) {
+    // Reference: floor division with the 128-bit operators
+    auto quot = fs / fs_per_sec;
+    auto rem = fs % fs_per_sec;
+    if (rem < 0) {
+      quot -= 1;
+      rem += fs_per_sec;
+    }
+    auto split = split_secs(fs);
+    CPPUNIT_ASSERT(quot == split.secs);
+    CPPUNIT_ASSERT(rem == split.subsec);
+
+    auto trunc = split_secs_trunc(fs);
+    CPPUNIT_ASSERT(fs / fs_per_sec == trunc.secs);
+    CPPUNIT_ASSERT(fs % fs_per_sec == trunc.subsec);
+  }
+}
+
+namespace {
+
+template<uint64_t D>
+void check_udivmod(uint128_t n)
+{
+  auto [quot, rem] = udivmod_by<D>(n);
+  CPPUNIT_ASSERT(quot == n / D);
+  CPPUNIT_ASSERT(rem == n % D);
+}
+
+} // namespace
+
+void TimeSplitCppUnit::test_udivmod()
+{
+  std::mt19937_64 rng(54321);
+  for (int i = 0; i < 200'000; i++) {
+    auto n = (static_cast<uint128_t>(rng()) << 64) | rng();
+    n >>= rng() % 128;
+    check_udivmod<fs_per_sec_64>(n);
+    check_udivmod<fs_per_ms_64>(n);
+    check_udivmod<fs_per_ns_64>(n);
+    check_udivmod<fs_per_hour_64>(n);
+    check_udivmod<7>(n);
+    check_udivmod<~uint64_t{0}>(n);
+    check_udivmod<uint64_t{1} << 63>(n);
+  }
+  check_udivmod<fs_per_sec_64>(~static_cast<uint128_t>(0));
+  check_udivmod<1>(~static_cast<uint128_t>(0));
+}
+
+void TimeSplitCppUnit::test_duration_totals()
+{
+  for (auto fs : sample_values()) {
+    // The totals are only meaningful when they fit in a long
+    if (fs / fs_per_ns > INT64_MAX || fs / fs_per_ns < INT64_MIN) {
+      continue;
+    }
+    duration_t d(fs);
+    CPPUNIT_ASSERT_EQUAL(static_cast<long>(fs / fs_per_day), d.total_days());
+    CPPUNIT_ASSERT_EQUAL(static_cast<long>(fs / fs_per_hour), d.total_hours());
+    CPPUNIT_ASSERT_EQUAL(static_cast<long>(fs / fs_per_sec),
+                         d.total_seconds());
+    CPPUNIT_ASSERT_EQUAL(static_cast<long>(fs / fs_per_ms),
+                         d.total_milliseconds());
+    CPPUNIT_ASSERT_EQUAL(static_cast<long>(fs / fs_per_us),
+                         d.total_microseconds());
+    CPPUNIT_ASSERT_EQUAL(static_cast<long>(fs / fs_per_ns),
+                         d.total_nanoseconds());
+    CPPUNIT_ASSERT_EQUAL(static_cast<long>(fs % fs_per_day / fs_per_hour),
+                         d.hours());
+    CPPUNIT_ASSERT_EQUAL(static_cast<long>(fs % fs_per_hour / fs_per_min),
+                         d.minutes());
+    CPPUNIT_ASSERT_EQUAL(static_cast<long>(fs % fs_per_min / fs_per_sec),
+                         d.seconds());
+  }
+}
@@ -0,0 +1,150 @@
+/**
+ * @file   test_unit_time_writer.cpp
+ * @brief  Tests for the incremental formatter of time streams
+ *
+ */
+
+// [CPPUNIT headers]
+#include <cppunit/TestCaller.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// [C++ headers]
+#include <random>
+#include <string>
+#include <vector>
+
+// [femtotime headers]
+#include "femtotime/GPStime.hpp"
+#include "femtotime/time_writer.hpp"
+
+// [Namespaces]
+using namespace std;
+using namespace femtotime;
+
+/**
+ * @class TimeWriterCppUnit
+ */
+class TimeWriterCppUnit : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TimeWriterCppUnit);
+  CPPUNIT_TEST(test_stream);
+  CPPUNIT_TEST(test_leap_second);
+  CPPUNIT_TEST(test_unsorted);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void test_stream();
+  void test_leap_second();
+  void test_unsorted();
+};
+CPPUNIT_TEST_SUITE_REGISTRATION(TimeWriterCppUnit);
+
+namespace {
+
+const time_format_t all_formats[] = {
+  {time_style_t::extended, time_precision_t::fs},
+  {time_style_t::basic, time_precision_t::ms},
+  {time_style_t::gps, time_precision_t::s},
+  {time_style_t::rfc3339, time_precision_t::us},
+};
+
+/** @brief Check a writer against `FormatTo` for every time in turn */
+template <typename T>
+void check_writer(const std::vector<T> &times, const time_format_t &format)
+{
+  time_writer_t<T> writer(format);
+  for (const auto &t : times) {
+    CPPUNIT_ASSERT_EQUAL(t.ToString(format), writer.ToString(t));
+  }
+}
+
+/** @brief A stream of increasing times, in steps of up to `max_step` */
+std::vector<gps_time_t> stream(gps_time_t start, femtosecs_t max_step,
+                               int count, std::mt19937_64 &rng)
+{
+  std::vector<gps_time_t> times;
+  auto t = start;
+  for (int i = 0; i < count; i++) {
+    times.push_back(t);
+    t += duration_t(static_cast<femtosecs_t>(rng() % max_step));
+  }
+  return times;
+}
+
+std::vector<utc_time_t> to_utc(const std::vector<gps_time_t> &times)
+{
+  std::vector<utc_time_t> utc;
+  for (const auto &t : times) {
+    utc.push_back(t.ToUTC());
+  }
+  return utc;
+}
+
+} // namespace
+
+/**
+ * @brief Increasing times that cross seconds, minutes, hours and days, before
+ * and after the epoch and in years that don't fit in four digits
+ */
+void TimeWriterCppUnit::test_stream()
+{
+  std::mt19937_64 rng(1999);
+  for (auto start : {"GPS_2024-02-28T23:58:00Z", "GPS_1969-12-31T23:00:00Z",
+                     "GPS_9999-12-31T23:59:00Z", "GPS_0000-01-01T00:00:00Z"}) {
+    for (auto step : {fs_per_sec / 7, fs_per_min / 3, fs_per_hour * 5}) {
+      auto times = stream(gps_time_t::FromGPSString(start), step, 2'000, rng);
+      auto utc = to_utc(times);
+      for (const auto &format : all_formats) {
+        check_writer(times, format);
+        check_writer(utc, format);
+      }
+    }
+  }
+
+  // The default format is ToString()'s
+  auto t = gps_time_t::FromGPSString("GPS_2024-02-28T23:58:00.125Z");
+  CPPUNIT_ASSERT_EQUAL(t.ToString(), gps_time_writer_t().ToString(t));
+  CPPUNIT_ASSERT_EQUAL(t.ToUTC().ToString(),
+                       utc_time_writer_t().ToString(t.ToUTC()));
+}
+
+/** @brief UTC times through a leap second are written as second 60 */
+void TimeWriterCppUnit::test_leap_second()
+{
+  std::mt19937_64 rng(2016);
+  auto start = gps_time_t::FromUTCString("2016-12-31T23:59:58Z");
+  auto times = to_utc(stream(start, fs_per_sec / 10, 60, rng));
+  for (const auto &format : all_formats) {
+    check_writer(times, format);
+  }
+
+  utc_time_writer_t writer({time_style_t::extended, time_precision_t::ms});
+  std::vector<std::string> written;
+  for (auto text : {"2016-12-31T23:59:59.5", "2016-12-31T23:59:60.25",
+                    "2016-12-31T23:59:60.75", "2017-01-01T00:00:00.5"}) {
+    written.push_back(writer.ToString(
+      gps_time_t::FromUTCString(text).ToUTC()));
+  }
+  CPPUNIT_ASSERT_EQUAL(std::string("2016-12-31T23:59:59.500Z"), written[0]);
+  CPPUNIT_ASSERT_EQUAL(std::string("2016-12-31T23:59:60.250Z"), written[1]);
+  CPPUNIT_ASSERT_EQUAL(std::string("2016-12-31T23:59:60.750Z"), written[2]);
+  CPPUNIT_ASSERT_EQUAL(std::string("2017-01-01T00:00:00.500Z"), written[3]);
+}
+
+/** @brief Times out of order, or far apart, are still written correctly */
+void TimeWriterCppUnit::test_unsorted()
+{
+  std::mt19937_64 rng(42);
+  std::vector<gps_time_t> times;
+  for (int i = 0; i < 5'000; i++) {
+    // Mostly small jumps either way, some across days, a few across years
+    auto range = i % 10 == 0 ? fs_per_day * 800 : fs_per_min * 3;
+    auto delta = static_cast<femtosecs_t>(rng() % (2 * range)) - range;
+    times.push_back(i == 0 ? gps_time_t(0) : times.back() + duration_t(delta));
+  }
+  for (const auto &format : all_formats) {
+    check_writer(times, format);
+    check_writer(to_utc(times), format);
+  }
+}
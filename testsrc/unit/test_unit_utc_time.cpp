@@ -9,6 +9,9 @@
 #include <cppunit/TestCaller.h>
 #include <cppunit/extensions/HelperMacros.h>
 
+// [C++ headers]
+#include <stdexcept>
+
 // [TLE headers]
 #include "femtotime/GPStime.hpp"
 
@@ -27,6 +30,8 @@ class UTCTimeCppUnit : public CppUnit::TestFixture
   CPPUNIT_TEST(test_to_string);
   CPPUNIT_TEST(test_from_string);
   CPPUNIT_TEST(test_is_leap);
+  CPPUNIT_TEST(test_fields);
+  CPPUNIT_TEST(test_packed_ordering);
   CPPUNIT_TEST_SUITE_END();
 public:
   void setUp() {}
@@ -36,6 +41,8 @@ public:
   void test_to_string();
   void test_from_string();
   void test_is_leap();
+  void test_fields();
+  void test_packed_ordering();
 };
 CPPUNIT_TEST_SUITE_REGISTRATION(UTCTimeCppUnit);
 
@@ -200,3 +207,66 @@ void UTCTimeCppUnit::test_is_leap()
     CPPUNIT_ASSERT_MESSAGE(msg, time.is_leap());
   }
 }
+
+void UTCTimeCppUnit::test_fields()
+{
+  utc_time_t time1(2003, 7, 12, 5, 14, 23, 500'000'000);
+  auto f = time1.Fields();
+  CPPUNIT_ASSERT_EQUAL(2003, f.year);
+  CPPUNIT_ASSERT_EQUAL(7, f.month);
+  CPPUNIT_ASSERT_EQUAL(12, f.day);
+  CPPUNIT_ASSERT_EQUAL(5, f.hour);
+  CPPUNIT_ASSERT_EQUAL(14, f.minute);
+  CPPUNIT_ASSERT_EQUAL(23, f.second);
+  CPPUNIT_ASSERT_EQUAL(500'000'000, f.nanosecond);
+  CPPUNIT_ASSERT_EQUAL(0, f.femtosecond);
+  CPPUNIT_ASSERT_EQUAL(193, f.day_of_year);
+  CPPUNIT_ASSERT_EQUAL(time1, utc_time_t(f));
+  CPPUNIT_ASSERT(!utc_time_t(f).is_leap());
+
+  // Leap seconds are reported (and accepted) as second 60
+  utc_time_t leap(2005, 12, 31, 23, 59, 60, 250'000'000);
+  auto lf = leap.Fields();
+  CPPUNIT_ASSERT_EQUAL(31, lf.day);
+  CPPUNIT_ASSERT_EQUAL(59, lf.minute);
+  CPPUNIT_ASSERT_EQUAL(60, lf.second);
+  CPPUNIT_ASSERT_EQUAL(250'000'000, lf.nanosecond);
+  CPPUNIT_ASSERT_EQUAL(leap.WholeSeconds(), lf.second);
+  auto round_trip = utc_time_t(lf);
+  CPPUNIT_ASSERT(round_trip.is_leap());
+  CPPUNIT_ASSERT(leap.get_fs() == round_trip.get_fs());
+  CPPUNIT_ASSERT_EQUAL(leap.ToString(), round_trip.ToString());
+}
+
+void UTCTimeCppUnit::test_packed_ordering()
+{
+  // The leap flag shares the femtosecond count's 16 bytes
+  static_assert(sizeof(utc_time_t) == 16);
+  constexpr utc_time_t packed(-7, true);
+  static_assert(packed.get_fs() == -7 && packed.is_leap());
+
+  // A leap second sorts as the second after it, and after a time it
+  // coincides with
+  utc_time_t before(2016, 12, 31, 23, 59, 59, 500'000'000);
+  utc_time_t leap(2016, 12, 31, 23, 59, 60, 250'000'000);
+  utc_time_t after(2017, 1, 1, 0, 0, 0, 500'000'000);
+  utc_time_t coincident(2017, 1, 1, 0, 0, 0, 250'000'000);
+  CPPUNIT_ASSERT(before < leap && leap < after);
+  CPPUNIT_ASSERT(coincident < leap && !(leap < coincident));
+  CPPUNIT_ASSERT(leap > before && leap >= coincident && before <= leap);
+  CPPUNIT_ASSERT(leap != coincident);
+  CPPUNIT_ASSERT(leap == utc_time_t(leap.get_fs(), true));
+  CPPUNIT_ASSERT(utc_time_t(leap.get_fs()) < leap);
+
+  // The key has room for counts from utc_fs_min to utc_fs_max only
+  for (bool is_leap : {false, true}) {
+    CPPUNIT_ASSERT(utc_time_t(utc_fs_max, is_leap).get_fs() == utc_fs_max);
+    CPPUNIT_ASSERT(utc_time_t(utc_fs_min, is_leap).get_fs() == utc_fs_min);
+    CPPUNIT_ASSERT_THROW(utc_time_t(utc_fs_max + 1, is_leap),
+                         std::runtime_error);
+    CPPUNIT_ASSERT_THROW(utc_time_t(utc_fs_min - 1, is_leap),
+                         std::runtime_error);
+  }
+  // The GPS epoch is ten years after the UTC one
+  CPPUNIT_ASSERT_THROW(gps_time_t(utc_fs_max).ToUTC(), std::runtime_error);
+}